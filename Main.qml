@@ -135,9 +135,6 @@ ApplicationWindow {
     }
 
 
-    property var appDurations: ({})
-    property var sortedApps: []
-    property var sortedDomains: []
     property bool showAllPercentages: false
     property string startDate: ""
     property string endDate: ""
@@ -273,154 +270,6 @@ ApplicationWindow {
         }
     }
 
-    function updateAppDurations() {
-        if (!isLoggedIn) return;
-        var appDurations = {};
-        var logs = logger.logContent.split('\n');
-        var totalDuration = 0;
-
-        for (var i = 0; i < logs.length; i++) {
-            var parts = logs[i].split(',');
-            if (parts.length >= 4 && parts[2].trim() !== '' && parts[3].trim() !== '') {
-                var appName = parts[2].trim();
-                // Abaikan entri 'Idle'
-                if (appName === "Idle") continue;
-
-                var start = parts[0].trim();
-                var end = parts[1].trim();
-                var startTime = new Date("2000-01-01 " + start);
-                var endTime = new Date("2000-01-01 " + end);
-                var durationSec = (endTime - startTime) / 1000;
-
-                if (durationSec > 0) {
-                    if (appDurations[appName] === undefined) {
-                        appDurations[appName] = 0;
-                    }
-                    appDurations[appName] += durationSec;
-                    totalDuration += durationSec;
-                }
-            }
-        }
-
-        var appArray = [];
-        for (var app in appDurations) {
-            var percentage = totalDuration > 0 ? (appDurations[app] / totalDuration) * 100 : 0;
-            // Tambahkan productivityType ke objek
-            // Dalam updateAppDurations()
-            appArray.push({
-                              name: app,
-                              duration: appDurations[app],
-                              percentage: percentage,
-                              productivityType: getProductivityType(app, "") // URL kosong untuk app
-                          });
-
-
-        }
-
-
-
-        appArray.sort((a, b) => b.duration - a.duration);
-        sortedApps = appArray;
-    }
-
-    function updateDomainDurations() {
-        if (!isLoggedIn) return;
-        var domainDurations = {};
-        var logs = logger.logContent.split('\n').filter(line => line.trim() !== '');
-        var totalDuration = 0;
-
-        for (var i = 0; i < logs.length; i++) {
-            var parts = logs[i].split(',');
-            // Pastikan ada 5 bagian untuk menyertakan URL
-            if (parts.length >= 5 && parts[4] && parts[4].trim() !== '') {
-                var url = parts[4].trim();
-                var domain = extractDomain(url);
-                if (domain) {
-                    var start = parts[0].trim();
-                    var end = parts[1].trim();
-                    var startTime = new Date("2000-01-01 " + start);
-                    var endTime = new Date("2000-01-01 " + end);
-                    var durationSec = (endTime - startTime) / 1000;
-
-                    if (durationSec > 0) {
-                        if (domainDurations[domain] === undefined) {
-                            domainDurations[domain] = 0;
-                        }
-                        domainDurations[domain] += durationSec;
-                        totalDuration += durationSec;
-                    }
-                }
-            }
-        }
-
-        var domainArray = [];
-        for (var domain in domainDurations) {
-            var percentage = totalDuration > 0 ? (domainDurations[domain] / totalDuration) * 100 : 0;
-            // Dalam updateDomainDurations()
-            domainArray.push({
-                                 name: domain,
-                                 duration: domainDurations[domain],
-                                 percentage: percentage,
-                                 productivityType: getProductivityType(domain, domain)
-                             });
-        }
-
-        domainArray.sort((a, b) => b.duration - a.duration);
-        sortedDomains = domainArray;
-    }
-
-    Connections {
-        target: logger
-        function onLogContentChanged() {
-            updateAppDurations();
-            updateDomainDurations(); // Tambahkan ini
-        }
-    }
-
-
-    function getProductivityType(name, url) {
-        var typeInt = logger.getAppProductivityType(name, url);
-
-        switch(typeInt) {
-        case 1: return "productive";
-        case 2: return "non-productive";
-        default: return "neutral";
-
-
-        }
-    }
-
-    function extractDomain(urlString) {
-        if (!urlString || urlString.trim() === "") {
-            return "";
-        }
-        try {
-            // Tambahkan "https://" jika URL tidak memiliki protokol, karena ini diperlukan oleh parser.
-            let fullUrl = urlString.startsWith("http") ? urlString : "https://" + urlString;
-
-            // Gunakan parser URL bawaan untuk keamanan dan keandalan
-            let url = new URL(fullUrl);
-            let hostname = url.hostname;
-
-            // Hapus subdomain "www." jika ada
-            if (hostname.startsWith("www.")) {
-                return hostname.substring(4);
-            }
-            return hostname;
-
-        } catch (e) {
-            // Jika parsing gagal (misalnya, string bukanlah URL yang valid),
-            // coba ambil bagian pertama sebelum garis miring sebagai fallback.
-            console.log("Gagal mem-parsing URL, mencoba fallback:", urlString);
-            let domain = urlString.split('/')[0];
-            if (domain.startsWith("www.")) {
-                return domain.substring(4);
-            }
-            return domain;
-        }
-    }
-
-
     // Di bagian JavaScript (logger.js atau file model):
     function fetchAndStoreTasks() {
         const sortedTasks = rawTasks.sort((a, b) => {
@@ -440,7 +289,7 @@ ApplicationWindow {
 
         console.log("Setting date filter - Start:", startDate, "End:", endDate)
 
-        // Cukup panggil setLogFilter. Pembaruan data akan ditangani oleh sinyal onLogContentChanged.
+        // Cukup panggil setLogFilter. Model appUsage/domainUsage dibangun ulang oleh logger.
         logger.setLogFilter(startDate, endDate)
 
         errorLabel.text = ""
@@ -468,15 +317,6 @@ ApplicationWindow {
     }
 
 
-    Connections {
-        target: sortedApps
-        function onModelUpdated() {
-            // Trigger re-animation saat data diupdate
-            percentageListView.model = showAllPercentages ? sortedApps : sortedApps.slice(0, 4)
-        }
-    }
-
-
     Connections {
         target: Logger
         onTaskListChanged: {
@@ -835,14 +675,28 @@ ApplicationWindow {
 
                 Button {
                     id: loginButton
-                    text: "Login"
+                    text: logger.loginInProgress ? "Logging in..." : "Login"
+                    enabled: !logger.loginInProgress
                     Layout.fillWidth: true
                     Layout.preferredHeight: 48
                     Material.background: secondaryColor
                     Material.foreground: "white"
                     font.pixelSize: 16
                     onClicked: {
-                        if (logger.authenticate(usernameField.text, passwordField.text)) {
+                        error_Label.text = ""
+                        // Hasil login datang lewat logger.loginCompleted, UI tetap responsif
+                        logger.authenticate(usernameField.text, passwordField.text)
+                    }
+
+                    Connections {
+                        target: logger
+                        function onLoginCompleted(success, message) {
+                            if (!success) {
+                                console.log("Login failed:", message)
+                                error_Label.text = message === "Login cancelled" ? "" : "Invalid username or password"
+                                return
+                            }
+
                             console.log("Login successful")
 
                             // Set login state
@@ -879,10 +733,6 @@ ApplicationWindow {
                             usernameField.text = ""
                             passwordField.text = ""
                             error_Label.text = ""
-
-                        } else {
-                            console.log("Login failed")
-                            error_Label.text = "Invalid username or password"
                         }
                     }
 
@@ -892,6 +742,15 @@ ApplicationWindow {
                         ColorAnimation { duration: 200 }
                     }
                 }
+
+                Button {
+                    id: cancelLoginButton
+                    text: "Cancel"
+                    flat: true
+                    visible: logger.loginInProgress
+                    Layout.fillWidth: true
+                    onClicked: logger.cancelLogin()
+                }
                 function refreshProfileImage() {
                     console.log("Refreshing profile image for user:", currentUsername, "path:", profileImagePath)
                     profileImage.source = ""
@@ -1513,7 +1372,6 @@ ApplicationWindow {
                                 logger.logout(); // Call the new logout function
                                 isLoggedIn = false
                                 currentUsername = ""
-                                sortedApps = []
                                 logger.clearLogFilter()
                                 profileImagePath = ":/profilImage.png"
                             }
@@ -1664,17 +1522,24 @@ ApplicationWindow {
 
                                 ListView {
                                     id: percentageListView
-                                    model: showAllPercentages ? sortedApps : sortedApps.slice(0, 4)
-                                    spacing: 12
+                                    model: logger.appUsage
+                                    spacing: 0 // jarak ada di delegate agar baris tersembunyi tidak menyisakan celah
                                     width: parent.width
 
                                     delegate: Item {
                                         width: percentageListView.width
-                                        height: 48
+                                        // Hanya 4 teratas kecuali "lihat semua"; model sudah terurut menurun
+                                        visible: showAllPercentages || index < 4
+                                        height: visible ? 60 : 0
 
-                                        property real targetPercentage: model.modelData.percentage
+                                        property real targetPercentage: model.percentage
                                         property real currentPercentage: 0
 
+                                        // Model diperbarui per segmen, delegate tidak dibuat ulang
+                                        onTargetPercentageChanged: {
+                                            if (!percentageAnim.running) currentPercentage = targetPercentage
+                                        }
+
 
                                         NumberAnimation on currentPercentage {
                                             id: percentageAnim
@@ -1686,7 +1551,9 @@ ApplicationWindow {
                                         }
 
                                         RowLayout {
-                                            anchors.fill: parent
+                                            anchors { left: parent.left; right: parent.right; top: parent.top }
+                                            height: 48
+                                            visible: parent.visible
                                             spacing: 12
 
 
@@ -1704,7 +1571,7 @@ ApplicationWindow {
                                                            )
 
                                                 Label {
-                                                    text: modelData.name.charAt(0).toUpperCase()
+                                                    text: model.name.charAt(0).toUpperCase()
                                                     anchors.centerIn: parent
                                                     font {
                                                         family: "Segoe UI"
@@ -1726,7 +1593,7 @@ ApplicationWindow {
 
                                                     // App name
                                                     Label {
-                                                        text: modelData.name
+                                                        text: model.name
                                                         Layout.fillWidth: true
                                                         elide: Text.ElideRight
                                                         font {
@@ -1750,7 +1617,7 @@ ApplicationWindow {
 
                                                     // Duration
                                                     Label {
-                                                        text: formatDuration(modelData.duration)
+                                                        text: formatDuration(model.seconds)
                                                         font {
                                                             family: "Segoe UI"
                                                             pixelSize: 14
@@ -1778,8 +1645,8 @@ ApplicationWindow {
                                                                 position: 0.0
                                                                 color: {
                                                                     var baseColor;
-                                                                    if (modelData.productivityType === "productive") baseColor = primaryColor;
-                                                                    else if (modelData.productivityType === "non-productive") baseColor = nonProductiveColor;
+                                                                    if (model.category === "productive") baseColor = primaryColor;
+                                                                    else if (model.category === "non-productive") baseColor = nonProductiveColor;
                                                                     else baseColor = neutralColor;
 
                                                                     // Membuat warna transparan (alpha = 0)
@@ -1790,9 +1657,9 @@ ApplicationWindow {
                                                                 position: 1.0
                                                                 color: {
                                                                     // Warna terang penuh (alpha = 1)
-                                                                    if (modelData.productivityType === "productive") return primaryColor;
-                                                                    if (modelData.productivityType === "non-productive") return nonProductiveColor;
-                                                                    if (modelData.productivityType === "neutral") return neutralColor;
+                                                                    if (model.category === "productive") return primaryColor;
+                                                                    if (model.category === "non-productive") return nonProductiveColor;
+                                                                    if (model.category === "neutral") return neutralColor;
                                                                     return neutralColor;
                                                                 }
                                                             }
@@ -1858,19 +1725,26 @@ ApplicationWindow {
 
                                 ListView {
                                     id: domainsListView
-                                    model: showAllPercentages ? sortedDomains : sortedDomains.slice(0, 4)
-                                    spacing: 12
+                                    model: logger.domainUsage
+                                    spacing: 0 // jarak ada di delegate agar baris tersembunyi tidak menyisakan celah
                                     width: parent.width
 
                                     // Delegate untuk domainsListView (gunakan kode yang sudah dibuat dari jawaban sebelumnya
                                     // yang sudah memiliki warna progress bar dinamis)
                                     delegate: Item {
                                         width: percentageListView.width
-                                        height: 48
+                                        // Hanya 4 teratas kecuali "lihat semua"; model sudah terurut menurun
+                                        visible: showAllPercentages || index < 4
+                                        height: visible ? 60 : 0
 
-                                        property real targetPercentage: model.modelData.percentage
+                                        property real targetPercentage: model.percentage
                                         property real currentPercentage: 0
 
+                                        // Model diperbarui per segmen, delegate tidak dibuat ulang
+                                        onTargetPercentageChanged: {
+                                            if (!percentageAnim_.running) currentPercentage = targetPercentage
+                                        }
+
                                         NumberAnimation on currentPercentage {
                                             id: percentageAnim_
                                             from: 0
@@ -1881,7 +1755,9 @@ ApplicationWindow {
                                         }
 
                                         RowLayout {
-                                            anchors.fill: parent
+                                            anchors { left: parent.left; right: parent.right; top: parent.top }
+                                            height: 48
+                                            visible: parent.visible
                                             spacing: 12
 
 
@@ -1899,7 +1775,7 @@ ApplicationWindow {
                                                            )
 
                                                 Label {
-                                                    text: modelData.name.charAt(0).toUpperCase()
+                                                    text: model.name.charAt(0).toUpperCase()
                                                     anchors.centerIn: parent
                                                     font {
                                                         family: "Segoe UI"
@@ -1921,7 +1797,7 @@ ApplicationWindow {
 
                                                     // App name
                                                     Label {
-                                                        text: modelData.name
+                                                        text: model.name
                                                         Layout.fillWidth: true
                                                         elide: Text.ElideRight
                                                         font {
@@ -1945,7 +1821,7 @@ ApplicationWindow {
 
                                                     // Duration
                                                     Label {
-                                                        text: formatDuration(modelData.duration)
+                                                        text: formatDuration(model.seconds)
                                                         font {
                                                             family: "Segoe UI"
                                                             pixelSize: 14
@@ -1973,8 +1849,8 @@ ApplicationWindow {
                                                                 position: 0.0
                                                                 color: {
                                                                     var baseColor;
-                                                                    if (modelData.productivityType === "productive") baseColor = primaryColor;
-                                                                    else if (modelData.productivityType === "non-productive") baseColor = nonProductiveColor;
+                                                                    if (model.category === "productive") baseColor = primaryColor;
+                                                                    else if (model.category === "non-productive") baseColor = nonProductiveColor;
                                                                     else baseColor = neutralColor;
 
                                                                     // Membuat warna transparan (alpha = 0)
@@ -1985,9 +1861,9 @@ ApplicationWindow {
                                                                 position: 1.0
                                                                 color: {
                                                                     // Warna terang penuh (alpha = 1)
-                                                                    if (modelData.productivityType === "productive") return primaryColor;
-                                                                    if (modelData.productivityType === "non-productive") return nonProductiveColor;
-                                                                    if (modelData.productivityType === "neutral") return neutralColor;
+                                                                    if (model.category === "productive") return primaryColor;
+                                                                    if (model.category === "non-productive") return nonProductiveColor;
+                                                                    if (model.category === "neutral") return neutralColor;
                                                                     return neutralColor;
                                                                 }
                                                             }
@@ -4476,17 +4352,7 @@ ApplicationWindow {
 
                                 Button {
                                     id: pauseResumeButton
-                                    visible: {
-                                        if (logger.activeTaskId === -1) return false;
-
-                                        // Find active task
-                                        for (let i = 0; i < logger.taskList.length; i++) {
-                                            if (logger.taskList[i].id === logger.activeTaskId) {
-                                                return logger.taskList[i].status !== "Review";
-                                            }
-                                        }
-                                        return false;
-                                    }
+                                    visible: logger.activeTaskId !== -1 && logger.activeTask.valid && logger.activeTask.status !== "Review"
 
                                     text: logger.isTaskPaused ? "Play" : "Pause"
                                     Layout.preferredWidth: 100
@@ -4562,14 +4428,14 @@ ApplicationWindow {
                                             height: 10
                                             radius: 5
                                             color: {
-                                                var activeTask = logger.taskList.find(task => task.id === logger.activeTaskId)
+                                                var activeTask = logger.activeTask.valid ? logger.activeTask : null
                                                 if (activeTask && activeTask.status === "Review") {
                                                     return "#FF9800" // Orange for review status
                                                 }
                                                 return logger.isTaskPaused ? accentColor : productiveColor
                                             }
                                             opacity: {
-                                                var activeTask = logger.taskList.find(task => task.id === logger.activeTaskId)
+                                                var activeTask = logger.activeTask.valid ? logger.activeTask : null
                                                 if (activeTask && activeTask.status === "Review") {
                                                     return 0.7 // Static opacity for review
                                                 }
@@ -4579,7 +4445,7 @@ ApplicationWindow {
                                             // Animasi hanya untuk task non-Review yang aktif
                                             SequentialAnimation on opacity {
                                                 running: {
-                                                    var activeTask = logger.taskList.find(task => task.id === logger.activeTaskId)
+                                                    var activeTask = logger.activeTask.valid ? logger.activeTask : null
                                                     return !logger.isTaskPaused && !(activeTask && activeTask.status === "Review")
                                                 }
                                                 loops: Animation.Infinite
@@ -4590,7 +4456,7 @@ ApplicationWindow {
 
                                         Label {
                                             text: {
-                                                var activeTask = logger.taskList.find(task => task.id === logger.activeTaskId)
+                                                var activeTask = logger.activeTask.valid ? logger.activeTask : null
                                                 if (activeTask && activeTask.status === "Review") {
                                                     return "Review"
                                                 }
@@ -4598,7 +4464,7 @@ ApplicationWindow {
                                             }
                                             font { family: "Segoe UI"; pixelSize: 14 }
                                             color: {
-                                                var activeTask = logger.taskList.find(task => task.id === logger.activeTaskId)
+                                                var activeTask = logger.activeTask.valid ? logger.activeTask : null
                                                 if (activeTask && activeTask.status === "Review") {
                                                     return "#FF9800"
                                                 }
@@ -4617,11 +4483,11 @@ ApplicationWindow {
 
                                             Label {
                                                 text: {
-                                                    var activeTask = logger.taskList.find(task => task.id === logger.activeTaskId)
+                                                    var activeTask = logger.activeTask.valid ? logger.activeTask : null
                                                     if (activeTask) {
                                                         // Format waktu ke HH:MM
-                                                        var hours = Math.floor(activeTask.time_usage / 3600)
-                                                        var minutes = Math.floor((activeTask.time_usage % 3600) / 60)
+                                                        var hours = Math.floor(activeTask.timeUsage / 3600)
+                                                        var minutes = Math.floor((activeTask.timeUsage % 3600) / 60)
                                                         var here_text = (hours < 10 ? "0" + hours : hours) + ":" + (minutes < 10 ? "0" + minutes : minutes)
                                                         public_curent_time = here_text
                                                         return here_text
@@ -4630,8 +4496,8 @@ ApplicationWindow {
                                                 }
                                                 font.pixelSize: 14
                                                 color: {
-                                                    var activeTask = logger.taskList.find(task => task.id === logger.activeTaskId)
-                                                    if (activeTask && activeTask.time_usage > activeTask.max_time) {
+                                                    var activeTask = logger.activeTask.valid ? logger.activeTask : null
+                                                    if (activeTask && activeTask.timeUsage > activeTask.maxTime) {
                                                         return nonProductiveColor
                                                     }
                                                     return lightTextColor
@@ -4645,17 +4511,17 @@ ApplicationWindow {
 
                                                 Rectangle {
                                                     width: {
-                                                        var activeTask = logger.taskList.find(task => task.id === logger.activeTaskId)
+                                                        var activeTask = logger.activeTask.valid ? logger.activeTask : null
                                                         if (activeTask) {
-                                                            return parent.width * Math.min(1, activeTask.time_usage / activeTask.max_time)
+                                                            return parent.width * Math.min(1, activeTask.timeUsage / activeTask.maxTime)
                                                         }
                                                         return parent.width * Math.min(1, logger.globalTimeUsage / (8 * 3600))
                                                     }
                                                     height: parent.height
                                                     radius: 3
                                                     color: {
-                                                        var activeTask = logger.taskList.find(task => task.id === logger.activeTaskId)
-                                                        if (activeTask && activeTask.time_usage > activeTask.max_time) {
+                                                        var activeTask = logger.activeTask.valid ? logger.activeTask : null
+                                                        if (activeTask && activeTask.timeUsage > activeTask.maxTime) {
                                                             return nonProductiveColor
                                                         }
                                                         return secondaryColor
@@ -4664,7 +4530,7 @@ ApplicationWindow {
                                                     // Nonaktifkan animasi untuk task Review
                                                     Behavior on width {
                                                         enabled: {
-                                                            var activeTask = logger.taskList.find(task => task.id === logger.activeTaskId)
+                                                            var activeTask = logger.activeTask.valid ? logger.activeTask : null
                                                             return !(activeTask && activeTask.status === "Review")
                                                         }
                                                         NumberAnimation { duration: 500 }
@@ -4673,11 +4539,11 @@ ApplicationWindow {
                                             }
                                             Label {
                                                 text: {
-                                                    var activeTask = logger.taskList.find(task => task.id === logger.activeTaskId)
+                                                    var activeTask = logger.activeTask.valid ? logger.activeTask : null
                                                     if (activeTask) {
                                                         // Format waktu maksimal ke HH:MM
-                                                        var hours = Math.floor(activeTask.max_time / 3600)
-                                                        var minutes = Math.floor((activeTask.max_time % 3600) / 60)
+                                                        var hours = Math.floor(activeTask.maxTime / 3600)
+                                                        var minutes = Math.floor((activeTask.maxTime % 3600) / 60)
                                                         var time_max  = (hours < 10 ? "0" + hours : hours) + ":" + (minutes < 10 ? "0" + minutes : minutes)
                                                         public_max_time = time_max
                                                         return time_max
@@ -4686,8 +4552,8 @@ ApplicationWindow {
                                                 }
                                                 font.pixelSize: 14
                                                 color: {
-                                                    var activeTask = logger.taskList.find(task => task.id === logger.activeTaskId)
-                                                    if (activeTask && activeTask.time_usage > activeTask.max_time) {
+                                                    var activeTask = logger.activeTask.valid ? logger.activeTask : null
+                                                    if (activeTask && activeTask.timeUsage > activeTask.maxTime) {
                                                         return nonProductiveColor
                                                     }
                                                     return lightTextColor
@@ -4725,43 +4591,8 @@ ApplicationWindow {
                                 ListView {
                                     id: taskListView
 
-                                    // Properti untuk menyimpan posisi scroll
-                                    property real savedContentY: 0
-                                    property bool preservePosition: false
-
-                                    model: {
-                                        if (!logger.taskList) return []
-
-                                        // Simpan posisi sebelum update model
-                                        if (taskListView.count > 0) {
-                                            taskListView.savedContentY = taskListView.contentY
-                                            taskListView.preservePosition = true
-                                        }
-
-                                        var sorted = logger.taskList.slice() // Copy array
-                                        sorted.sort(function(a, b) {
-                                            // Active task selalu di atas
-                                            if (a.active && !b.active) return -1
-                                            if (b.active && !a.active) return 1
-                                            return a.id - b.id
-                                        })
-
-
-                                        return sorted.map(function(task) {
-                                            var isActive = task.id === logger.activeTaskId
-                                            return {
-                                                id: task.id,
-                                                project_name: task.project_name,
-                                                task: task.task,
-                                                max_time: task.max_time,
-                                                time_usage: task.time_usage,
-                                                active: isActive,
-                                                status: task.status,
-                                                isTaskPaused: isActive ? logger.isTaskPaused : false,
-                                                // Tambahkan properti lain yang diperlukan
-                                            }
-                                        })
-                                    }
+                                    // Model dengan notifikasi per baris; posisi scroll tidak hilang saat update
+                                    model: logger.tasks
 
                                     spacing: 8
                                     width: parent.width
@@ -4771,36 +4602,16 @@ ApplicationWindow {
                                     highlightFollowsCurrentItem: false
                                     keyNavigationEnabled: false
 
-                                    // Restore posisi setelah model berubah
-                                    onCountChanged: {
-                                        if (preservePosition && count > 0) {
-                                            Qt.callLater(function() {
-                                                taskListView.contentY = taskListView.savedContentY
-                                                taskListView.preservePosition = false
-                                            })
-                                        }
-                                    }
-
-                                    // Alternative: menggunakan onModelChanged jika onCountChanged tidak bekerja
-                                    onModelChanged: {
-                                        if (preservePosition && model && model.length > 0) {
-                                            Qt.callLater(function() {
-                                                taskListView.contentY = taskListView.savedContentY
-                                                taskListView.preservePosition = false
-                                            })
-                                        }
-                                    }
-
                                     delegate: Rectangle {
                                         id: delegateRoot
                                         width: taskListView.width
                                         height: column.implicitHeight + 20
                                         radius: 8
 
-                                        readonly property bool isReview: modelData.status === "Review"
-                                        readonly property bool isNeedReview: modelData.status === "Need Review"
-                                        readonly property bool isNeedRevise: modelData.status === "Need Revise"
-                                        readonly property bool isActive: modelData.active
+                                        readonly property bool isReview: model.status === "Review"
+                                        readonly property bool isNeedReview: model.status === "Need Review"
+                                        readonly property bool isNeedRevise: model.status === "Need Revise"
+                                        readonly property bool isActive: model.active
 
                                         color: {
                                             if (isReview) {
@@ -4831,10 +4642,10 @@ ApplicationWindow {
                                             enabled: !delegateRoot.isReview
                                             onClicked: {
                                                 if (!delegateRoot.isActive && logger.activeTaskId !== -1) {
-                                                    confirmSwitchDialog.taskId = modelData.id
+                                                    confirmSwitchDialog.taskId = model.id
                                                     confirmSwitchDialog.open()
                                                 } else if (!delegateRoot.isActive) {
-                                                    logger.setActiveTask(modelData.id)
+                                                    logger.setActiveTask(model.id)
                                                 }
                                             }
                                         }
@@ -4851,7 +4662,7 @@ ApplicationWindow {
 
                                                 Label {
                                                     id: projectLabel
-                                                    text: modelData.project_name
+                                                    text: model.project_name
                                                     font { bold: true; pixelSize: 14 }
                                                     color: delegateRoot.isReview ? "#FF9800" : textColor
                                                     elide: Text.ElideRight
@@ -4899,7 +4710,7 @@ ApplicationWindow {
 
                                                         onClicked: {
                                                             // Simpan data yang diperlukan
-                                                            stableTaskMenu.taskId = modelData.id
+                                                            stableTaskMenu.taskId = model.id
                                                             stableTaskMenu.userId = logger.currentUserId
                                                             stableTaskMenu.authToken = logger.authToken
 
@@ -4916,7 +4727,7 @@ ApplicationWindow {
 
                                                 Label {
                                                     id: taskLabel
-                                                    text: modelData.task
+                                                    text: model.task
                                                     font.pixelSize: 12
                                                     color: delegateRoot.isReview ? Qt.rgba(255/255, 152/255, 0/255, 0.8) : lightTextColor
                                                     elide: Text.ElideRight
@@ -4950,7 +4761,7 @@ ApplicationWindow {
                                                         anchors.fill: parent
                                                         hoverEnabled: true
                                                         cursorShape: Qt.PointingHandCursor
-                                                        onClicked: taskDetailPopup.show(modelData.project_name, modelData.task)
+                                                        onClicked: taskDetailPopup.show(model.project_name, model.task)
                                                     }
                                                 }
                                             }
@@ -4964,18 +4775,18 @@ ApplicationWindow {
                                                     Layout.preferredWidth: statusText.implicitWidth + 12
                                                     radius: 9
                                                     color: {
-                                                        if (modelData.status === "Review") return Qt.rgba(255/255, 152/255, 0/255, 0.15);
-                                                        if (modelData.status === "Need Review") return Qt.rgba(33/255, 150/255, 243/255, 0.15);
-                                                        if (modelData.status === "Need Revise") return Qt.rgba(244/255, 67/255, 54/255, 0.15);
-                                                        if (modelData.active) return modelData.isTaskPaused ? Qt.rgba(255/255, 152/255, 0/255, 0.15) : Qt.rgba(76/255, 175/255, 80/255, 0.15);
+                                                        if (model.status === "Review") return Qt.rgba(255/255, 152/255, 0/255, 0.15);
+                                                        if (model.status === "Need Review") return Qt.rgba(33/255, 150/255, 243/255, 0.15);
+                                                        if (model.status === "Need Revise") return Qt.rgba(244/255, 67/255, 54/255, 0.15);
+                                                        if (model.active) return model.isTaskPaused ? Qt.rgba(255/255, 152/255, 0/255, 0.15) : Qt.rgba(76/255, 175/255, 80/255, 0.15);
                                                         return Qt.rgba(lightTextColor.r, lightTextColor.g, lightTextColor.b, 0.1);
                                                     }
 
                                                     border.color: {
-                                                        if (modelData.status === "Review") return Qt.rgba(255/255, 152/255, 0/255, 0.4);
-                                                        if (modelData.status === "Need Review") return Qt.rgba(33/255, 150/255, 243/255, 0.4);
-                                                        if (modelData.status === "Need Revise") return Qt.rgba(244/255, 67/255, 54/255, 0.4);
-                                                        if (modelData.active) return modelData.isTaskPaused ? Qt.rgba(255/255, 152/255, 0/255, 0.4) : Qt.rgba(76/255, 175/255, 80/255, 0.4);
+                                                        if (model.status === "Review") return Qt.rgba(255/255, 152/255, 0/255, 0.4);
+                                                        if (model.status === "Need Review") return Qt.rgba(33/255, 150/255, 243/255, 0.4);
+                                                        if (model.status === "Need Revise") return Qt.rgba(244/255, 67/255, 54/255, 0.4);
+                                                        if (model.active) return model.isTaskPaused ? Qt.rgba(255/255, 152/255, 0/255, 0.4) : Qt.rgba(76/255, 175/255, 80/255, 0.4);
                                                         return Qt.rgba(lightTextColor.r, lightTextColor.g, lightTextColor.b, 0.2);
                                                     }
                                                     border.width: 1
@@ -4984,19 +4795,19 @@ ApplicationWindow {
                                                         id: statusText
                                                         anchors.centerIn: parent
                                                         text: {
-                                                            if (modelData.status === "Review") return "Review";
-                                                            if (modelData.status === "Need Review") return "Need Review";
-                                                            if (modelData.status === "Need Revise") return "Need Revise";
-                                                            if (modelData.active) return modelData.isTaskPaused ? "Paused" : "Running";
+                                                            if (model.status === "Review") return "Review";
+                                                            if (model.status === "Need Review") return "Need Review";
+                                                            if (model.status === "Need Revise") return "Need Revise";
+                                                            if (model.active) return model.isTaskPaused ? "Paused" : "Running";
                                                             return "Pending";
                                                         }
                                                         font.pixelSize: 10
                                                         font.bold: true
                                                         color: {
-                                                            if (modelData.status === "Review") return "#FF9800";
-                                                            if (modelData.status === "Need Review") return "#2196F3";
-                                                            if (modelData.status === "Need Revise") return "#F44336";
-                                                            if (modelData.active) return modelData.isTaskPaused ? "#FF9800" : "#4CAF50";
+                                                            if (model.status === "Review") return "#FF9800";
+                                                            if (model.status === "Need Review") return "#2196F3";
+                                                            if (model.status === "Need Revise") return "#F44336";
+                                                            if (model.active) return model.isTaskPaused ? "#FF9800" : "#4CAF50";
                                                             return lightTextColor;
                                                         }
                                                     }
@@ -5014,7 +4825,7 @@ ApplicationWindow {
                                                     Label {
                                                         id: timeLabel
                                                         anchors.centerIn: parent
-                                                        text: logger.formatDuration(modelData.time_usage)
+                                                        text: logger.formatDuration(model.time_usage)
                                                         font.pixelSize: 11
                                                         font.bold: true
                                                         color: delegateRoot.isReview ? "#FF9800" : lightTextColor
@@ -5137,7 +4948,7 @@ ApplicationWindow {
 
                                     ListView {
                                         id: activityListView
-                                        model: logger.logContent.split('\n').filter(line => line.trim() !== '').slice(0, 15)
+                                        model: logger.logEntries
                                         spacing: 4
                                         width: parent.width
 
@@ -5203,13 +5014,7 @@ ApplicationWindow {
                                                 spacing: 8
 
                                                 Label {
-                                                    text: {
-                                                        const parts = modelData.split(',')
-                                                        if (parts.length >= 4) {
-                                                            return parts[0].trim()
-                                                        }
-                                                        return "Unknown"
-                                                    }
+                                                    text: model.startText
                                                     Layout.preferredWidth: 100
                                                     font {
                                                         family: "Segoe UI"
@@ -5220,18 +5025,7 @@ ApplicationWindow {
                                                 }
 
                                                 Label {
-                                                    text: {
-                                                        const parts = modelData.split(',')
-                                                        if (parts.length >= 4) {
-                                                            const start = parts[0].trim()
-                                                            const end = parts[1].trim()
-                                                            const startTime = new Date("2000-01-01 " + start)
-                                                            const endTime = new Date("2000-01-01 " + end)
-                                                            const durationSec = (endTime - startTime) / 1000
-                                                            return Math.floor(durationSec/60) + "m " + (durationSec%60) + "s"
-                                                        }
-                                                        return ""
-                                                    }
+                                                    text: model.durationText
                                                     Layout.preferredWidth: 80
                                                     font {
                                                         family: "Segoe UI"
@@ -5241,13 +5035,7 @@ ApplicationWindow {
                                                 }
 
                                                 Label {
-                                                    text: {
-                                                        const parts = modelData.split(',')
-                                                        if (parts.length >= 4) {
-                                                            return parts[2].trim()
-                                                        }
-                                                        return "Unknown"
-                                                    }
+                                                    text: model.appName || "Unknown"
                                                     Layout.preferredWidth: 150
                                                     font {
                                                         family: "Segoe UI"
@@ -5258,13 +5046,7 @@ ApplicationWindow {
                                                 }
 
                                                 Label {
-                                                    text: {
-                                                        const parts = modelData.split(',')
-                                                        if (parts.length >= 4) {
-                                                            return parts[3].trim()
-                                                        }
-                                                        return ""
-                                                    }
+                                                    text: model.title
                                                     font {
                                                         family: "Segoe UI"
                                                         pixelSize: 11
@@ -5304,7 +5086,7 @@ ApplicationWindow {
                                 "status": "need-review"
                             }
 
-                            var apiUrl = "https://deskmon.pranala-dt.co.id/api/update-status-task/" +
+                            var apiUrl = logger.apiBaseUrl + "/update-status-task/" +
                                     stableTaskMenu.taskId + "/" + stableTaskMenu.userId;
 
                             var request = new XMLHttpRequest()
@@ -0,0 +1,246 @@
+#include "activityrollup.h"
+#include "logcategories.h"
+#include "perfstats.h"
+#include "ruleindex.h"
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QDateTime>
+#include <QDebug>
+
+void ActivityRollup::clear()
+{
+    m_users.clear();
+}
+
+bool ActivityRollup::isLoaded(int userId) const
+{
+    return m_users.contains(userId);
+}
+
+bool ActivityRollup::load(int userId, QSqlDatabase &db, const RuleIndex &rules)
+{
+    QVector<Row> rows;
+    if (!fetch(userId, db, rows)) {
+        return false;
+    }
+    assign(userId, rows, rules);
+    return true;
+}
+
+bool ActivityRollup::fetch(int userId, QSqlDatabase &db, QVector<Row> &rows)
+{
+    if (!db.isOpen()) {
+        qWarning() << "Cannot load activity rollup: Database is not open";
+        return false;
+    }
+
+    ScopedPerfTimer perf("sql.rollup_load");
+    // Satu kali scan yang sudah dikelompokkan; setelah ini tidak ada rescan tabel log.
+    // Segmen berdurasi nol tetap dihitung (sama dengan COUNT(*) logCount lama), tapi tanpa detik.
+    QSqlQuery query(db);
+    query.prepare(R"(
+        SELECT date(start_time, 'unixepoch', 'localtime'), app_name, url,
+               SUM(CASE WHEN end_time > start_time THEN end_time - start_time ELSE 0 END),
+               COUNT(*), MAX(end_time)
+        FROM log
+        WHERE id_user = :id_user
+        AND app_name IS NOT NULL
+        GROUP BY 1, 2, 3
+    )");
+    query.bindValue(":id_user", userId);
+    if (!query.exec()) {
+        qWarning() << "Failed to load activity rollup:" << query.lastError().text();
+        return false;
+    }
+
+    rows.clear();
+    while (query.next()) {
+        Row row;
+        row.date = QDate::fromString(query.value(0).toString(), Qt::ISODate);
+        row.appName = query.value(1).toString();
+        row.url = query.value(2).toString();
+        row.seconds = query.value(3).toLongLong();
+        row.segments = query.value(4).toInt();
+        row.updatedAt = query.value(5).toLongLong();
+        rows.append(row);
+    }
+    return true;
+}
+
+void ActivityRollup::assign(int userId, const QVector<Row> &rows, const RuleIndex &rules)
+{
+    UserRollup &user = m_users[userId];
+    user = UserRollup();
+    for (const Row &row : rows) {
+        bool browser = !row.url.isEmpty();
+        QString domain = browser ? RuleIndex::hostOf(row.url).toString().toLower() : QString();
+        addToDay(userId, user, row.date, row.appName, domain, browser,
+                 row.seconds, row.segments, row.updatedAt, rules);
+    }
+
+    qCDebug(lcStats) << "Activity rollup loaded for user" << userId << ":" << user.days.size() << "days";
+}
+
+void ActivityRollup::addSegment(int userId, qint64 startTime, qint64 endTime,
+                                const QString &appName, const QString &url, const RuleIndex &rules)
+{
+    auto it = m_users.find(userId);
+    if (it == m_users.end()) {
+        return; // Belum dimuat; load() nanti akan membaca segmen ini dari database
+    }
+
+    bool browser = !url.isEmpty();
+    QString domain = browser ? RuleIndex::hostOf(url).toString().toLower() : QString();
+    QDate date = QDateTime::fromSecsSinceEpoch(startTime).date();
+    addToDay(userId, it.value(), date, appName, domain, browser, qMax<qint64>(0, endTime - startTime), 1,
+             QDateTime::currentSecsSinceEpoch(), rules);
+}
+
+QVector<QPair<int, QDate>> ActivityRollup::reclassify(const RuleIndex &rules)
+{
+    const qint64 now = QDateTime::currentSecsSinceEpoch();
+    QVector<QPair<int, QDate>> changedDays;
+    for (auto userIt = m_users.begin(); userIt != m_users.end(); ++userIt) {
+        UserRollup &user = userIt.value();
+        for (int c = 0; c < CategoryCount; ++c) {
+            user.categorySeconds[c] = 0;
+        }
+        for (auto dayIt = user.days.begin(); dayIt != user.days.end(); ++dayIt) {
+            Day &day = dayIt.value();
+            for (int c = 0; c < CategoryCount; ++c) {
+                day.categorySeconds[c] = 0;
+            }
+            bool dayChanged = false;
+            for (auto entryIt = day.entries.begin(); entryIt != day.entries.end(); ++entryIt) {
+                Entry &entry = entryIt.value();
+                const int category = categoryFor(userIt.key(), entry, rules);
+                if (category != entry.category) {
+                    entry.category = category;
+                    entry.updatedAt = now; // Status berubah, perlu dilaporkan ulang
+                    dayChanged = true;
+                }
+                day.categorySeconds[entry.category] += entry.seconds;
+                user.categorySeconds[entry.category] += entry.seconds;
+            }
+            if (dayChanged) {
+                changedDays.append(qMakePair(userIt.key(), dayIt.key()));
+            }
+        }
+    }
+    return changedDays;
+}
+
+qint64 ActivityRollup::categorySeconds(int userId, int category, const QDate &from, const QDate &to) const
+{
+    auto it = m_users.constFind(userId);
+    if (it == m_users.constEnd() || category < 0 || category >= CategoryCount) {
+        return 0;
+    }
+
+    const UserRollup &user = it.value();
+    if (!from.isValid() && !to.isValid()) {
+        return user.categorySeconds[category];
+    }
+
+    qint64 total = 0;
+    auto dayIt = from.isValid() ? user.days.lowerBound(from) : user.days.constBegin();
+    auto dayEnd = to.isValid() ? user.days.upperBound(to) : user.days.constEnd();
+    for (; dayIt != dayEnd; ++dayIt) {
+        total += dayIt.value().categorySeconds[category];
+    }
+    return total;
+}
+
+int ActivityRollup::segmentCount(int userId, const QDate &from, const QDate &to) const
+{
+    auto it = m_users.constFind(userId);
+    if (it == m_users.constEnd()) {
+        return 0;
+    }
+
+    const UserRollup &user = it.value();
+    if (!from.isValid() && !to.isValid()) {
+        return user.segments;
+    }
+
+    int total = 0;
+    auto dayIt = from.isValid() ? user.days.lowerBound(from) : user.days.constBegin();
+    auto dayEnd = to.isValid() ? user.days.upperBound(to) : user.days.constEnd();
+    for (; dayIt != dayEnd; ++dayIt) {
+        total += dayIt.value().segments;
+    }
+    return total;
+}
+
+const ActivityRollup::Day *ActivityRollup::day(int userId, const QDate &date) const
+{
+    auto it = m_users.constFind(userId);
+    if (it == m_users.constEnd()) {
+        return nullptr;
+    }
+    auto dayIt = it.value().days.constFind(date);
+    return dayIt == it.value().days.constEnd() ? nullptr : &dayIt.value();
+}
+
+void ActivityRollup::forEachDay(int userId, const QDate &from, const QDate &to,
+                                const std::function<void(const QDate &, const Day &)> &visit) const
+{
+    auto it = m_users.constFind(userId);
+    if (it == m_users.constEnd()) {
+        return;
+    }
+
+    const UserRollup &user = it.value();
+    auto dayIt = from.isValid() ? user.days.lowerBound(from) : user.days.constBegin();
+    auto dayEnd = to.isValid() ? user.days.upperBound(to) : user.days.constEnd();
+    for (; dayIt != dayEnd; ++dayIt) {
+        visit(dayIt.key(), dayIt.value());
+    }
+}
+
+QString ActivityRollup::entryKey(const QString &appName, const QString &domain, bool browser)
+{
+    return browser ? appName + QChar(0x1f) + domain : appName;
+}
+
+int ActivityRollup::categoryFor(int userId, const Entry &entry, const RuleIndex &rules)
+{
+    if (entry.browser) {
+        return entry.domain.isEmpty() ? Neutral : clampCategory(rules.classifyDomain(userId, entry.domain));
+    }
+    return clampCategory(rules.classifyApp(userId, entry.appName));
+}
+
+int ActivityRollup::clampCategory(int type)
+{
+    return (type == Productive || type == NonProductive) ? type : Neutral;
+}
+
+void ActivityRollup::addToDay(int userId, UserRollup &user, const QDate &date, const QString &appName,
+                              const QString &domain, bool browser, qint64 seconds, int segments,
+                              qint64 updatedAt, const RuleIndex &rules)
+{
+    Day &day = user.days[date];
+    day.segments += segments;
+    user.segments += segments;
+    if (seconds <= 0) {
+        return; // Hanya menambah jumlah segmen; entri tanpa durasi tidak dilaporkan
+    }
+
+    const QString key = entryKey(appName, domain, browser);
+    auto entryIt = day.entries.find(key);
+    if (entryIt == day.entries.end()) {
+        Entry entry;
+        entry.appName = appName;
+        entry.domain = domain;
+        entry.browser = browser;
+        entry.category = categoryFor(userId, entry, rules);
+        entryIt = day.entries.insert(key, entry);
+    }
+
+    Entry &entry = entryIt.value();
+    entry.seconds += seconds;
+    entry.updatedAt = qMax(entry.updatedAt, updatedAt);
+    day.categorySeconds[entry.category] += seconds;
+    user.categorySeconds[entry.category] += seconds;
+}
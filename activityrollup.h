@@ -0,0 +1,85 @@
+#ifndef ACTIVITYROLLUP_H
+#define ACTIVITYROLLUP_H
+
+#include <QString>
+#include <QHash>
+#include <QMap>
+#include <QVector>
+#include <QPair>
+#include <QDate>
+#include <QSqlDatabase>
+#include <functional>
+
+class RuleIndex;
+
+// Agregat berjalan per (user, hari lokal, kategori, aplikasi/domain).
+// Diisi sekali dari tabel log, lalu diperbarui O(1) setiap segmen ditutup.
+class ActivityRollup
+{
+public:
+    enum Category { Neutral = 0, Productive = 1, NonProductive = 2, CategoryCount = 3 };
+
+    struct Entry {
+        QString appName;
+        QString domain;   // kosong untuk aplikasi non-browser
+        bool browser = false;
+        qint64 seconds = 0;
+        int category = Neutral;
+        qint64 updatedAt = 0; // epoch detik perubahan terakhir, untuk laporan delta
+    };
+
+    struct Day {
+        qint64 categorySeconds[CategoryCount] = {0, 0, 0};
+        int segments = 0;
+        QHash<QString, Entry> entries;
+    };
+
+    // Satu baris hasil scan teragregasi tabel log, sebelum diklasifikasi
+    struct Row {
+        QDate date;
+        QString appName;
+        QString url;
+        qint64 seconds = 0;
+        int segments = 0;
+        qint64 updatedAt = 0;
+    };
+
+    void clear();
+    bool isLoaded(int userId) const;
+    bool load(int userId, QSqlDatabase &db, const RuleIndex &rules);
+
+    // load() dipecah dua: fetch() boleh berjalan di thread storage, assign()
+    // mengklasifikasi dengan RuleIndex di thread pemilik rollup
+    static bool fetch(int userId, QSqlDatabase &db, QVector<Row> &rows);
+    void assign(int userId, const QVector<Row> &rows, const RuleIndex &rules);
+    void addSegment(int userId, qint64 startTime, qint64 endTime,
+                    const QString &appName, const QString &url, const RuleIndex &rules);
+    // Mengembalikan (user, hari) yang status salah satu entrinya berubah
+    QVector<QPair<int, QDate>> reclassify(const RuleIndex &rules);
+
+    // Tanggal yang tidak valid berarti rentang tidak dibatasi di sisi itu
+    qint64 categorySeconds(int userId, int category, const QDate &from = QDate(), const QDate &to = QDate()) const;
+    int segmentCount(int userId, const QDate &from = QDate(), const QDate &to = QDate()) const;
+    const Day *day(int userId, const QDate &date) const;
+    void forEachDay(int userId, const QDate &from, const QDate &to,
+                    const std::function<void(const QDate &, const Day &)> &visit) const;
+
+    static QString entryKey(const QString &appName, const QString &domain, bool browser);
+
+private:
+    struct UserRollup {
+        QMap<QDate, Day> days;
+        qint64 categorySeconds[CategoryCount] = {0, 0, 0};
+        int segments = 0;
+    };
+
+    static int categoryFor(int userId, const Entry &entry, const RuleIndex &rules);
+    static int clampCategory(int type);
+    void addToDay(int userId, UserRollup &user, const QDate &date, const QString &appName,
+                  const QString &domain, bool browser, qint64 seconds, int segments,
+                  qint64 updatedAt, const RuleIndex &rules);
+
+    QHash<int, UserRollup> m_users;
+};
+
+#endif // ACTIVITYROLLUP_H
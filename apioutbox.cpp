@@ -0,0 +1,400 @@
+#include "apioutbox.h"
+#include "perfstats.h"
+#include "logcategories.h"
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QDateTime>
+#include <QRandomGenerator>
+#include <QEventLoop>
+#include <QUuid>
+#include <QDebug>
+
+namespace {
+
+const int kDefaultEndpointLimit = 1;   // satu request per endpoint menjaga urutan pengiriman
+const int kGlobalLimit = 4;
+const int kTransferTimeoutMs = 15000;
+const qint64 kLeaseMs = 60000;         // baris yang sedang dikirim; dikirim ulang jika aplikasi mati
+const qint64 kBaseBackoffMs = 2000;
+const qint64 kMaxBackoffMs = 5 * 60 * 1000;
+const qint64 kMaxAgeMs = 7LL * 24 * 60 * 60 * 1000;
+const int kBatchSize = 32;
+
+bool isRetryable(QNetworkReply::NetworkError error, int status)
+{
+    if (status == 408 || status == 429 || status >= 500) {
+        return true;
+    }
+    if (status >= 400) {
+        return false; // Request ditolak server; mengulang tidak akan mengubah hasil
+    }
+    // Tidak ada status HTTP: koneksi gagal, timeout, DNS, dsb.
+    return error != QNetworkReply::NoError;
+}
+
+} // namespace
+
+ApiOutbox::ApiOutbox(QNetworkAccessManager *network, QObject *parent)
+    : QObject(parent)
+    , m_network(network)
+{
+    m_timer.setSingleShot(true);
+    connect(&m_timer, &QTimer::timeout, this, &ApiOutbox::dispatch);
+}
+
+bool ApiOutbox::createTable(QSqlDatabase &db)
+{
+    QSqlQuery query(db);
+    if (!query.exec("CREATE TABLE IF NOT EXISTS outbox ("
+                    "id INTEGER PRIMARY KEY AUTOINCREMENT, "
+                    "kind TEXT NOT NULL, "
+                    "method TEXT NOT NULL, "
+                    "url TEXT NOT NULL, "
+                    "body BLOB, "
+                    "token TEXT, "
+                    "user_id INTEGER, "
+                    "held INTEGER NOT NULL DEFAULT 0, "
+                    "idempotency_key TEXT NOT NULL, "
+                    "coalesce_key TEXT, "
+                    "tag TEXT, "
+                    "attempts INTEGER NOT NULL DEFAULT 0, "
+                    "next_attempt INTEGER NOT NULL, "
+                    "created_at INTEGER NOT NULL)")) {
+        qWarning() << "Failed to create outbox table:" << query.lastError().text();
+        return false;
+    }
+    if (!query.exec("CREATE INDEX IF NOT EXISTS idx_outbox_next_attempt ON outbox(next_attempt)") ||
+        !query.exec("CREATE INDEX IF NOT EXISTS idx_outbox_coalesce ON outbox(coalesce_key)")) {
+        qWarning() << "Failed to create outbox indexes:" << query.lastError().text();
+        return false;
+    }
+    return true;
+}
+
+void ApiOutbox::setDatabase(const QSqlDatabase &db)
+{
+    m_db = db;
+}
+
+void ApiOutbox::setEndpointLimit(const QString &kind, int limit)
+{
+    m_endpointLimits.insert(kind, qMax(1, limit));
+}
+
+void ApiOutbox::setTokenBound(const QString &kind)
+{
+    m_tokenBoundKinds.insert(kind);
+}
+
+void ApiOutbox::reauthenticate(int userId, const QString &token)
+{
+    if (!m_db.isOpen() || userId == -1 || token.isEmpty()) {
+        return;
+    }
+
+    QSqlQuery query(m_db);
+    query.prepare("SELECT id, kind FROM outbox WHERE user_id = :user AND (held = 1 OR token IS NOT :token)");
+    query.bindValue(":user", userId);
+    query.bindValue(":token", token);
+    if (!query.exec()) {
+        qWarning() << "Failed to read outbox for reauthentication:" << query.lastError().text();
+        return;
+    }
+
+    QList<qint64> restamp;
+    while (query.next()) {
+        if (!m_tokenBoundKinds.contains(query.value(1).toString())) {
+            restamp.append(query.value(0).toLongLong());
+        }
+    }
+
+    QSqlQuery update(m_db);
+    update.prepare("UPDATE outbox SET token = :token, held = 0 WHERE id = :id");
+    for (qint64 id : std::as_const(restamp)) {
+        update.bindValue(":token", token);
+        update.bindValue(":id", id);
+        if (!update.exec()) {
+            qWarning() << "Failed to update outbox token:" << update.lastError().text();
+        }
+    }
+
+    if (!restamp.isEmpty()) {
+        qCDebug(lcApi) << "Outbox resumed" << restamp.size() << "messages with the new token";
+        m_timer.start(0);
+    }
+}
+
+bool ApiOutbox::enqueue(const Message &message)
+{
+    if (!m_db.isOpen()) {
+        qWarning() << "Cannot enqueue" << message.kind << ": Outbox database is not open";
+        return false;
+    }
+
+    ScopedPerfTimer perf("sql.outbox_enqueue");
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    QSqlQuery query(m_db);
+
+    if (!message.coalesceKey.isEmpty()) {
+        // Pesan lama dengan key yang sama sudah usang, kecuali yang sedang dikirim
+        QSet<qint64> sending;
+        for (const InFlight &flight : std::as_const(m_inFlight)) {
+            sending.insert(flight.id);
+        }
+        query.prepare("SELECT id FROM outbox WHERE coalesce_key = :key");
+        query.bindValue(":key", message.coalesceKey);
+        QList<qint64> superseded;
+        if (query.exec()) {
+            while (query.next()) {
+                const qint64 id = query.value(0).toLongLong();
+                if (!sending.contains(id)) {
+                    superseded.append(id);
+                }
+            }
+        }
+        for (qint64 id : std::as_const(superseded)) {
+            remove(id);
+        }
+    }
+
+    query.prepare("INSERT INTO outbox (kind, method, url, body, token, user_id, idempotency_key, coalesce_key, "
+                  "tag, attempts, next_attempt, created_at) "
+                  "VALUES (:kind, :method, :url, :body, :token, :user, :key, :coalesce, :tag, 0, :next, :created)");
+    query.bindValue(":kind", message.kind);
+    query.bindValue(":method", QString::fromLatin1(message.method));
+    query.bindValue(":url", message.url.toString());
+    query.bindValue(":body", message.body);
+    query.bindValue(":token", message.token);
+    query.bindValue(":user", message.userId == -1 ? QVariant() : QVariant(message.userId));
+    query.bindValue(":key", QUuid::createUuid().toString(QUuid::WithoutBraces));
+    query.bindValue(":coalesce", message.coalesceKey.isEmpty() ? QVariant() : QVariant(message.coalesceKey));
+    query.bindValue(":tag", message.tag);
+    query.bindValue(":next", now);
+    query.bindValue(":created", now);
+    if (!query.exec()) {
+        qWarning() << "Failed to enqueue" << message.kind << ":" << query.lastError().text();
+        return false;
+    }
+
+    // Dispatch di giliran event loop berikutnya agar beberapa enqueue berurutan tergabung
+    if (!m_timer.isActive() || m_timer.remainingTime() > 0) {
+        m_timer.start(0);
+    }
+    return true;
+}
+
+int ApiOutbox::pendingCount() const
+{
+    if (!m_db.isOpen()) {
+        return 0;
+    }
+    QSqlQuery query(m_db);
+    if (query.exec("SELECT COUNT(*) FROM outbox") && query.next()) {
+        return query.value(0).toInt();
+    }
+    return 0;
+}
+
+void ApiOutbox::dispatch()
+{
+    if (!m_db.isOpen()) {
+        return;
+    }
+
+    ScopedPerfTimer perf("sql.outbox_dispatch");
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    QSqlQuery query(m_db);
+
+    query.prepare("DELETE FROM outbox WHERE created_at < :cutoff");
+    query.bindValue(":cutoff", now - kMaxAgeMs);
+    if (query.exec() && query.numRowsAffected() > 0) {
+        qWarning() << "Dropped" << query.numRowsAffected() << "outbox messages older than 7 days";
+    }
+
+    query.prepare("SELECT id, kind, method, url, body, token, idempotency_key, attempts, tag "
+                  "FROM outbox WHERE held = 0 AND next_attempt <= :now ORDER BY id LIMIT :limit");
+    query.bindValue(":now", now);
+    query.bindValue(":limit", kBatchSize);
+    if (!query.exec()) {
+        qWarning() << "Failed to read outbox:" << query.lastError().text();
+        scheduleNext();
+        return;
+    }
+
+    QSet<qint64> sending;
+    for (const InFlight &flight : std::as_const(m_inFlight)) {
+        sending.insert(flight.id);
+    }
+
+    QSqlQuery lease(m_db);
+    lease.prepare("UPDATE outbox SET next_attempt = :lease WHERE id = :id");
+
+    while (query.next() && m_inFlight.size() < kGlobalLimit) {
+        const qint64 id = query.value(0).toLongLong();
+        const QString kind = query.value(1).toString();
+        if (sending.contains(id) ||
+            m_inFlightByKind.value(kind) >= m_endpointLimits.value(kind, kDefaultEndpointLimit)) {
+            continue;
+        }
+
+        InFlight flight;
+        flight.id = id;
+        flight.kind = kind;
+        flight.body = query.value(4).toByteArray();
+        flight.token = query.value(5).toString();
+        flight.attempts = query.value(7).toInt();
+        flight.tag = query.value(8).toString();
+
+        lease.bindValue(":lease", now + kLeaseMs);
+        lease.bindValue(":id", id);
+        lease.exec();
+
+        QNetworkRequest request(QUrl(query.value(3).toString()));
+        request.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
+        request.setRawHeader("Authorization", "Bearer " + flight.token.toUtf8());
+        request.setRawHeader("Idempotency-Key", query.value(6).toString().toUtf8());
+        request.setTransferTimeout(kTransferTimeoutMs);
+
+        QNetworkReply *reply = m_network->sendCustomRequest(request, query.value(2).toString().toLatin1(), flight.body);
+        PerfStats::trackReply(reply, "api." + kind.toUtf8());
+        m_inFlight.insert(reply, flight);
+        m_inFlightByKind[kind] += 1;
+        connect(reply, &QNetworkReply::finished, this, [this, reply]() { handleReply(reply); });
+    }
+
+    scheduleNext();
+}
+
+void ApiOutbox::handleReply(QNetworkReply *reply)
+{
+    reply->deleteLater();
+    const InFlight flight = m_inFlight.take(reply);
+    m_inFlightByKind[flight.kind] -= 1;
+
+    const int status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    const QByteArray response = reply->readAll();
+
+    if (reply->error() == QNetworkReply::NoError) {
+        remove(flight.id);
+        emit delivered(flight.kind, flight.tag, response);
+    } else if (status == 401 && !m_tokenBoundKinds.contains(flight.kind)) {
+        // Token kedaluwarsa: pesan tidak salah, hanya perlu token baru
+        qWarning() << "Outbox" << flight.kind << "unauthorized, holding messages until next login";
+        if (hold(flight.token) && !m_draining) {
+            emit authenticationRequired();
+        }
+    } else if (isRetryable(reply->error(), status)) {
+        qWarning() << "Outbox" << flight.kind << "failed (attempt" << flight.attempts + 1 << "):"
+                   << reply->errorString();
+        retryLater(flight.id, flight.attempts + 1);
+    } else {
+        qWarning() << "Outbox" << flight.kind << "rejected with HTTP" << status << ":" << response;
+        remove(flight.id);
+        emit rejected(flight.kind, status, response);
+    }
+
+    if (m_draining) {
+        // Saat shutdown tidak ada event loop utama untuk timer; kirim berikutnya langsung
+        dispatch();
+        if (m_inFlight.isEmpty()) {
+            emit drained();
+        }
+        return;
+    }
+
+    // Slot kosong bisa langsung dipakai pesan berikutnya
+    m_timer.start(0);
+}
+
+int ApiOutbox::drain(int timeoutMs)
+{
+    m_timer.stop();
+    m_draining = true;
+    dispatch();
+
+    if (!m_inFlight.isEmpty()) {
+        QEventLoop loop;
+        QTimer deadline;
+        deadline.setSingleShot(true);
+        connect(&deadline, &QTimer::timeout, &loop, &QEventLoop::quit);
+        connect(this, &ApiOutbox::drained, &loop, &QEventLoop::quit);
+        deadline.start(timeoutMs);
+        loop.exec(QEventLoop::ExcludeUserInputEvents);
+    }
+    m_draining = false;
+    m_timer.stop();
+
+    // Request yang belum selesai dibatalkan tanpa menaikkan attempts; lease dilepas
+    // supaya pesan langsung dikirim ulang saat start berikutnya
+    QSqlQuery release(m_db);
+    release.prepare("UPDATE outbox SET next_attempt = :now WHERE id = :id");
+    const QList<QNetworkReply *> replies = m_inFlight.keys();
+    for (QNetworkReply *reply : replies) {
+        release.bindValue(":now", QDateTime::currentMSecsSinceEpoch());
+        release.bindValue(":id", m_inFlight.value(reply).id);
+        release.exec();
+        disconnect(reply, nullptr, this, nullptr);
+        reply->abort();
+        reply->deleteLater();
+    }
+    m_inFlight.clear();
+    m_inFlightByKind.clear();
+
+    return pendingCount();
+}
+
+void ApiOutbox::scheduleNext()
+{
+    QSqlQuery query(m_db);
+    if (!query.exec("SELECT MIN(next_attempt) FROM outbox WHERE held = 0") || !query.next() || query.value(0).isNull()) {
+        return;
+    }
+    const qint64 delay = query.value(0).toLongLong() - QDateTime::currentMSecsSinceEpoch();
+    m_timer.start(int(qBound<qint64>(0, delay, kMaxBackoffMs)));
+}
+
+void ApiOutbox::retryLater(qint64 id, int attempts)
+{
+    QSqlQuery query(m_db);
+    query.prepare("UPDATE outbox SET attempts = :attempts, next_attempt = :next WHERE id = :id");
+    query.bindValue(":attempts", attempts);
+    query.bindValue(":next", QDateTime::currentMSecsSinceEpoch() + backoffMs(attempts));
+    query.bindValue(":id", id);
+    if (!query.exec()) {
+        qWarning() << "Failed to reschedule outbox message:" << query.lastError().text();
+    }
+}
+
+bool ApiOutbox::hold(const QString &token)
+{
+    // Lease dilepas tanpa menaikkan attempts; baris dengan token sama ikut ditahan
+    QSqlQuery query(m_db);
+    query.prepare("UPDATE outbox SET held = 1, next_attempt = :now WHERE held = 0 AND token IS :token");
+    query.bindValue(":now", QDateTime::currentMSecsSinceEpoch());
+    query.bindValue(":token", token);
+    if (!query.exec()) {
+        qWarning() << "Failed to hold outbox messages:" << query.lastError().text();
+        return false;
+    }
+    return query.numRowsAffected() > 0;
+}
+
+void ApiOutbox::remove(qint64 id)
+{
+    QSqlQuery query(m_db);
+    query.prepare("DELETE FROM outbox WHERE id = :id");
+    query.bindValue(":id", id);
+    if (!query.exec()) {
+        qWarning() << "Failed to remove outbox message:" << query.lastError().text();
+    }
+}
+
+qint64 ApiOutbox::backoffMs(int attempts)
+{
+    // Exponential backoff dengan "equal jitter": [delay/2, delay]. Jitter menyebar
+    // pengiriman ulang agar reconnect tidak memicu lonjakan request.
+    const qint64 delay = qMin(kMaxBackoffMs, kBaseBackoffMs << qMin(attempts, 20));
+    return delay / 2 + QRandomGenerator::global()->bounded(delay / 2 + 1);
+}
@@ -0,0 +1,94 @@
+#ifndef APIOUTBOX_H
+#define APIOUTBOX_H
+
+#include <QObject>
+#include <QSqlDatabase>
+#include <QNetworkAccessManager>
+#include <QTimer>
+#include <QHash>
+#include <QSet>
+#include <QUrl>
+
+class QNetworkReply;
+
+// Outbox persisten untuk semua request API yang tidak butuh jawaban sinkron.
+// Pesan disimpan dulu di tabel outbox, lalu dikirim oleh dispatcher dengan
+// backoff eksponensial + jitter, batas konkurensi per endpoint, dan header
+// Idempotency-Key. Pesan kumulatif (mis. time_at_work) memakai coalesce key
+// sehingga hanya nilai terbaru yang tersisa di antrean. Balasan 401 menahan
+// semua pesan dengan token yang sama sampai reauthenticate() memberi token baru.
+class ApiOutbox : public QObject
+{
+    Q_OBJECT
+public:
+    struct Message {
+        QString kind;             // nama endpoint, dipakai untuk batas konkurensi
+        QByteArray method = "POST";
+        QUrl url;
+        QByteArray body;
+        QString token;
+        int userId = -1;          // pemilik pesan; token baru hanya dipasang ke pesan user yang sama
+        QString coalesceKey;      // kosong = tidak pernah digantikan pesan lain
+        QString tag;              // konteks bebas, dikembalikan lewat delivered()
+    };
+
+    explicit ApiOutbox(QNetworkAccessManager *network, QObject *parent = nullptr);
+
+    static bool createTable(QSqlDatabase &db);
+    void setDatabase(const QSqlDatabase &db);
+    void setEndpointLimit(const QString &kind, int limit);
+    // Pesan jenis ini berlaku untuk token saat enqueue saja (mis. logout): tidak
+    // dipasangi token baru, dan dibuang jika ditolak 401
+    void setTokenBound(const QString &kind);
+
+    // Dipanggil setelah login berhasil: pesan user ini yang tertahan atau masih
+    // membawa token lama dikirim dengan token baru
+    void reauthenticate(int userId, const QString &token);
+
+    bool enqueue(const Message &message);
+    int pendingCount() const;
+    int inFlightCount() const { return m_inFlight.size(); }
+
+    // Kirim sebanyak mungkin dalam batas waktu (dipakai saat shutdown); sisanya
+    // tetap di tabel dan dikirim saat aplikasi dijalankan lagi. Mengembalikan
+    // jumlah pesan yang belum terkirim.
+    int drain(int timeoutMs);
+
+public slots:
+    void dispatch();
+
+signals:
+    void delivered(const QString &kind, const QString &tag, const QByteArray &responseBody);
+    void rejected(const QString &kind, int httpStatus, const QByteArray &responseBody);
+    // Token ditolak server; pesannya ditahan sampai reauthenticate()
+    void authenticationRequired();
+    void drained();
+
+private:
+    struct InFlight {
+        qint64 id = 0;
+        QString kind;
+        QByteArray body;
+        QString token;
+        QString tag;
+        int attempts = 0;
+    };
+
+    void handleReply(QNetworkReply *reply);
+    void scheduleNext();
+    void retryLater(qint64 id, int attempts);
+    bool hold(const QString &token);
+    void remove(qint64 id);
+    static qint64 backoffMs(int attempts);
+
+    QNetworkAccessManager *m_network;
+    QSqlDatabase m_db;
+    QTimer m_timer;
+    QHash<QNetworkReply *, InFlight> m_inFlight;
+    QHash<QString, int> m_inFlightByKind;
+    QHash<QString, int> m_endpointLimits;
+    QSet<QString> m_tokenBoundKinds;
+    bool m_draining = false;
+};
+
+#endif // APIOUTBOX_H
@@ -0,0 +1,389 @@
+// Benchmark jalur panas tracker di atas riwayat sintetis.
+//
+//   cmake -DDESKMON_BUILD_BENCH=ON ... && ./deskmon_bench
+//
+// Hasil QBENCHMARK tampil di konsol seperti QtTest biasa; ringkasan ns/operasi
+// juga ditulis sebagai JSON (DESKMON_BENCH_JSON, default ./deskmon_bench.json)
+// agar regresi antar versi bisa dilacak.
+//
+// Logger bench auto-login dengan token palsu, jadi request API diarahkan ke
+// port lokal yang tertutup (atau ke deskmon_mockserver jika DESKMON_API_BASE_URL
+// sudah diset) dan tidak pernah sampai ke server produksi.
+
+#include <QtTest>
+#include <QTemporaryDir>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QJsonDocument>
+#include <QSqlDatabase>
+#include <limits>
+#include "historygenerator.h"
+#include "logger.h"
+#include "ruleindex.h"
+#include "activityrollup.h"
+#include "usagereport.h"
+#if defined(Q_OS_LINUX)
+#include "x11errors.h"
+#endif
+
+#ifndef DESKMON_VERSION
+#define DESKMON_VERSION "dev"
+#endif
+
+class LoggerBench : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void getAppProductivityType_data() { addScenarioRows(); }
+    void getAppProductivityType();
+    void productivityStats_data() { addScenarioRows(); }
+    void productivityStats();
+    void calculateTodayProductiveSeconds_data() { addScenarioRows(); }
+    void calculateTodayProductiveSeconds();
+    void usageReportBuild_data() { addScenarioRows(); }
+    void usageReportBuild();
+    void rollupLoad_data() { addScenarioRows(); }
+    void rollupLoad();
+    void logContent_data() { addScenarioRows(); }
+    void logContent();
+    void logContentQuery_data() { addScenarioRows(); }
+    void logContentQuery();
+    void taskList_data() { addScenarioRows(); }
+    void taskList();
+
+private:
+    void addScenarioRows();
+    QString prepareScenario(int days, int rules);
+    Logger *loggerFor(int days, int rules);
+    void openScenarioDatabases(int days, int rules, QSqlDatabase &activity, QSqlDatabase &productivity);
+    void record(const char *name, int days, int rules, qint64 nsecs, int iterations, int callsPerIteration = 1);
+
+    QTemporaryDir m_workDir;
+    QString m_startDir;
+    Logger *m_logger = nullptr;
+    QString m_loggerScenario;
+    QMap<QString, QJsonObject> m_results;
+};
+
+void LoggerBench::initTestCase()
+{
+    QVERIFY(m_workDir.isValid());
+    m_startDir = QDir::currentPath();
+    // Harus sebelum Logger pertama dibuat; koneksi ditolak langsung, tanpa 401
+    if (!qEnvironmentVariableIsSet("DESKMON_API_BASE_URL")) {
+        qputenv("DESKMON_API_BASE_URL", "http://127.0.0.1:9/api");
+    }
+#if defined(Q_OS_LINUX)
+    installX11ErrorHandler();
+#endif
+}
+
+void LoggerBench::cleanupTestCase()
+{
+    delete m_logger;
+    m_logger = nullptr;
+    QDir::setCurrent(m_startDir);
+
+    QJsonArray results;
+    for (const QJsonObject &result : std::as_const(m_results)) {
+        results.append(result);
+    }
+    QJsonObject root;
+    root["version"] = QStringLiteral(DESKMON_VERSION);
+    root["qt"] = QString::fromLatin1(qVersion());
+    root["timestamp"] = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
+    root["results"] = results;
+
+    QString path = qEnvironmentVariable("DESKMON_BENCH_JSON");
+    if (path.isEmpty()) {
+        path = m_startDir + "/deskmon_bench.json";
+    }
+    QFile file(path);
+    QVERIFY2(file.open(QIODevice::WriteOnly | QIODevice::Truncate), qPrintable(file.errorString()));
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Indented));
+    qInfo() << "Benchmark results written to" << path;
+}
+
+void LoggerBench::addScenarioRows()
+{
+    QTest::addColumn<int>("days");
+    QTest::addColumn<int>("rules");
+    for (int days : {1, 90, 730}) {
+        for (int rules : {50, 5000}) {
+            QTest::addRow("%dd_%drules", days, rules) << days << rules;
+        }
+    }
+}
+
+QString LoggerBench::prepareScenario(int days, int rules)
+{
+    const QString dir = m_workDir.filePath(QString("d%1_r%2").arg(days).arg(rules));
+    if (QFile::exists(dir + "/activity_logs.db")) {
+        return dir;
+    }
+    QDir().mkpath(dir);
+
+    // Skema dibuat lewat migrasi Logger sendiri agar selalu sama dengan aplikasi.
+    // Logger lain harus sudah dihapus karena nama koneksinya sama.
+    delete m_logger;
+    m_logger = nullptr;
+    m_loggerScenario.clear();
+    QDir::setCurrent(dir);
+    delete new Logger;
+
+    HistoryGenerator generator;
+    QSqlDatabase activity;
+    QSqlDatabase productivity;
+    openScenarioDatabases(days, rules, activity, productivity);
+    QElapsedTimer timer;
+    timer.start();
+    bool ok = generator.fillActivity(activity, days)
+              && generator.fillRules(productivity, rules)
+              && generator.fillTasks(productivity, 200);
+    qInfo() << "Generated scenario" << days << "days /" << rules << "rules in" << timer.elapsed() << "ms";
+    activity.close();
+    productivity.close();
+    if (!ok) {
+        // Hapus skenario setengah jadi agar tidak dipakai ulang oleh test berikutnya
+        qWarning() << "Failed to generate scenario" << dir;
+        QDir::setCurrent(m_workDir.path());
+        QDir(dir).removeRecursively();
+        return QString();
+    }
+    return dir;
+}
+
+Logger *LoggerBench::loggerFor(int days, int rules)
+{
+    const QString dir = prepareScenario(days, rules);
+    if (dir.isEmpty()) {
+        return nullptr;
+    }
+    if (m_loggerScenario != dir) {
+        delete m_logger;
+        QDir::setCurrent(dir);
+        m_logger = new Logger; // Auto-login sebagai user bench (token tersimpan)
+        m_loggerScenario = dir;
+        // Snapshot untuk QML diisi asinkron oleh thread storage; yang diukur adalah kondisi tunak
+        const bool ready = QTest::qWaitFor([this]() {
+            return !m_logger->productivityStats().isEmpty() && !m_logger->logContent().isEmpty()
+                   && !m_logger->taskList().isEmpty();
+        }, 120000);
+        if (!ready) {
+            qWarning() << "Logger snapshots not ready for scenario" << dir;
+        }
+    }
+    return m_logger;
+}
+
+void LoggerBench::openScenarioDatabases(int days, int rules, QSqlDatabase &activity, QSqlDatabase &productivity)
+{
+    const QString dir = m_workDir.filePath(QString("d%1_r%2").arg(days).arg(rules));
+    activity = QSqlDatabase::contains("bench_activity") ? QSqlDatabase::database("bench_activity", false)
+                                                        : QSqlDatabase::addDatabase("QSQLITE", "bench_activity");
+    productivity = QSqlDatabase::contains("bench_productivity") ? QSqlDatabase::database("bench_productivity", false)
+                                                                : QSqlDatabase::addDatabase("QSQLITE", "bench_productivity");
+    activity.close();
+    productivity.close();
+    activity.setDatabaseName(dir + "/activity_logs.db");
+    productivity.setDatabaseName(dir + "/produktif_app_db.db");
+    QVERIFY(activity.open());
+    QVERIFY(productivity.open());
+}
+
+void LoggerBench::record(const char *name, int days, int rules, qint64 nsecs, int iterations, int callsPerIteration)
+{
+    if (iterations <= 0) {
+        return;
+    }
+    const QString scenario = QString::fromLatin1(QTest::currentDataTag());
+    QJsonObject result;
+    result["benchmark"] = QString::fromLatin1(name);
+    result["scenario"] = scenario;
+    result["days"] = days;
+    result["rules"] = rules;
+    result["iterations"] = iterations;
+    result["ns_per_op"] = double(nsecs) / (double(iterations) * callsPerIteration);
+    // Fungsi benchmark bisa dipanggil ulang oleh QtTest; hasil terakhir yang dipakai
+    m_results.insert(QString::fromLatin1(name) + '/' + scenario, result);
+}
+
+void LoggerBench::getAppProductivityType()
+{
+    QFETCH(int, days);
+    QFETCH(int, rules);
+    Logger *logger = loggerFor(days, rules);
+    QVERIFY(logger);
+
+    HistoryGenerator generator(7);
+    QVector<QPair<QString, QString>> inputs;
+    for (int i = 0; i < 1000; ++i) {
+        inputs.append(i % 2 ? qMakePair(QString("chrome"), generator.randomUrl())
+                            : qMakePair(generator.randomApp(), QString()));
+    }
+
+    int iterations = 0;
+    int sink = 0;
+    QElapsedTimer timer;
+    timer.start();
+    QBENCHMARK {
+        ++iterations;
+        for (const auto &input : std::as_const(inputs)) {
+            sink += logger->getAppProductivityType(input.first, input.second);
+        }
+    }
+    record("getAppProductivityType", days, rules, timer.nsecsElapsed(), iterations, inputs.size());
+    QVERIFY(sink >= 0);
+}
+
+void LoggerBench::productivityStats()
+{
+    QFETCH(int, days);
+    QFETCH(int, rules);
+    Logger *logger = loggerFor(days, rules);
+    QVERIFY(logger);
+
+    int iterations = 0;
+    QElapsedTimer timer;
+    timer.start();
+    QBENCHMARK {
+        ++iterations;
+        logger->productivityStats();
+    }
+    record("productivityStats", days, rules, timer.nsecsElapsed(), iterations);
+}
+
+void LoggerBench::calculateTodayProductiveSeconds()
+{
+    QFETCH(int, days);
+    QFETCH(int, rules);
+    Logger *logger = loggerFor(days, rules);
+    QVERIFY(logger);
+    logger->calculateTodayProductiveSeconds();
+
+    int iterations = 0;
+    QElapsedTimer timer;
+    timer.start();
+    QBENCHMARK {
+        ++iterations;
+        logger->calculateTodayProductiveSeconds();
+    }
+    record("calculateTodayProductiveSeconds", days, rules, timer.nsecsElapsed(), iterations);
+}
+
+void LoggerBench::usageReportBuild()
+{
+    QFETCH(int, days);
+    QFETCH(int, rules);
+    QVERIFY(!prepareScenario(days, rules).isEmpty());
+
+    QSqlDatabase activity;
+    QSqlDatabase productivity;
+    openScenarioDatabases(days, rules, activity, productivity);
+    RuleIndex ruleIndex;
+    ruleIndex.rebuild(productivity);
+    ActivityRollup rollup;
+    QVERIFY(rollup.load(HistoryGenerator::kUserId, activity, ruleIndex));
+
+    // Tanpa watermark: kasus terburuk, seluruh entri hari ini masuk payload
+    UsageReport report;
+    int iterations = 0;
+    int entries = 0;
+    QElapsedTimer timer;
+    timer.start();
+    QBENCHMARK {
+        ++iterations;
+        entries = report.build(productivity, HistoryGenerator::kUserId, QDate::currentDate(), rollup).data.size();
+    }
+    record("usageReportBuild", days, rules, timer.nsecsElapsed(), iterations);
+    QVERIFY(entries > 0);
+}
+
+void LoggerBench::rollupLoad()
+{
+    QFETCH(int, days);
+    QFETCH(int, rules);
+    QVERIFY(!prepareScenario(days, rules).isEmpty());
+
+    QSqlDatabase activity;
+    QSqlDatabase productivity;
+    openScenarioDatabases(days, rules, activity, productivity);
+    RuleIndex ruleIndex;
+    ruleIndex.rebuild(productivity);
+
+    // Biaya start/login: satu scan teragregasi atas seluruh riwayat
+    int iterations = 0;
+    QElapsedTimer timer;
+    timer.start();
+    QBENCHMARK {
+        ++iterations;
+        ActivityRollup rollup;
+        rollup.load(HistoryGenerator::kUserId, activity, ruleIndex);
+    }
+    record("rollupLoad", days, rules, timer.nsecsElapsed(), iterations);
+}
+
+void LoggerBench::logContent()
+{
+    QFETCH(int, days);
+    QFETCH(int, rules);
+    Logger *logger = loggerFor(days, rules);
+    QVERIFY(logger);
+
+    int iterations = 0;
+    QElapsedTimer timer;
+    timer.start();
+    QBENCHMARK {
+        ++iterations;
+        logger->logContent();
+    }
+    record("logContent", days, rules, timer.nsecsElapsed(), iterations);
+}
+
+void LoggerBench::logContentQuery()
+{
+    QFETCH(int, days);
+    QFETCH(int, rules);
+    QVERIFY(!prepareScenario(days, rules).isEmpty());
+
+    QSqlDatabase activity;
+    QSqlDatabase productivity;
+    openScenarioDatabases(days, rules, activity, productivity);
+
+    // Biaya yang kini ditanggung thread storage setiap snapshot logContent diperbarui
+    int iterations = 0;
+    int length = 0;
+    QElapsedTimer timer;
+    timer.start();
+    QBENCHMARK {
+        ++iterations;
+        length = Logger::queryLogContent(activity, HistoryGenerator::kUserId,
+                                         0, std::numeric_limits<qint64>::max()).size();
+    }
+    record("logContentQuery", days, rules, timer.nsecsElapsed(), iterations);
+    QVERIFY(length > 0);
+}
+
+void LoggerBench::taskList()
+{
+    QFETCH(int, days);
+    QFETCH(int, rules);
+    Logger *logger = loggerFor(days, rules);
+    QVERIFY(logger);
+
+    int iterations = 0;
+    QElapsedTimer timer;
+    timer.start();
+    QBENCHMARK {
+        ++iterations;
+        logger->taskList();
+    }
+    record("taskList", days, rules, timer.nsecsElapsed(), iterations);
+}
+
+QTEST_MAIN(LoggerBench)
+#include "deskmon_bench.moc"
@@ -0,0 +1,158 @@
+#include "historygenerator.h"
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QRandomGenerator>
+#include <QDateTime>
+#include <QStringList>
+#include <QDebug>
+
+namespace {
+
+const QStringList kBrowsers = {"chrome", "firefox", "msedge"};
+const QStringList kApps = {
+    "code", "slack", "zoom", "outlook", "excel", "winword", "powerpnt", "teams",
+    "explorer", "terminal", "qtcreator", "figma", "postman", "dbeaver", "notion",
+    "spotify", "discord", "whatsapp", "telegram", "steam", "vlc", "obs", "gimp",
+    "inkscape", "blender", "thunderbird", "keepass", "filezilla", "putty", "anydesk",
+};
+const int kDomainCount = 400;
+const int kSegmentsPerDay = 480;   // ~8 jam kerja, rata-rata 60 detik per segmen
+
+} // namespace
+
+HistoryGenerator::HistoryGenerator(quint32 seed)
+    : m_random(seed)
+{
+}
+
+QString HistoryGenerator::domainAt(int index) const
+{
+    static const QStringList tlds = {"com", "org", "net", "io", "co.id"};
+    return QString("site%1.%2").arg(index).arg(tlds[index % tlds.size()]);
+}
+
+QString HistoryGenerator::randomApp()
+{
+    return kApps[m_random.bounded(int(kApps.size()))];
+}
+
+QString HistoryGenerator::randomUrl()
+{
+    // Distribusi miring: sebagian kecil domain mendominasi, seperti riwayat asli
+    const double r = m_random.generateDouble();
+    const int index = int(r * r * r * kDomainCount);
+    return QString("https://www.%1/page/%2").arg(domainAt(index)).arg(m_random.bounded(1000));
+}
+
+bool HistoryGenerator::fillActivity(QSqlDatabase &db, int days)
+{
+    QSqlQuery query(db);
+    query.exec("INSERT OR REPLACE INTO users (id, username, password, email, role, token) "
+               "VALUES (1, 'bench', '', 'bench@example.com', 'staff', 'bench-token')");
+
+    if (!db.transaction()) {
+        qWarning() << "Generator: cannot start transaction:" << db.lastError().text();
+        return false;
+    }
+    query.prepare("INSERT INTO log (id_user, start_time, end_time, app_name, title, url) VALUES (?, ?, ?, ?, ?, ?)");
+
+    const QDate today = QDate::currentDate();
+    for (int d = days - 1; d >= 0; --d) {
+        qint64 time = QDateTime(today.addDays(-d), QTime(9, 0)).toSecsSinceEpoch();
+        for (int i = 0; i < kSegmentsPerDay; ++i) {
+            const qint64 duration = 2 + m_random.bounded(119);
+            const int kind = m_random.bounded(100);
+            QString appName;
+            QString title;
+            QString url;
+            if (kind < 5) {
+                appName = "Idle";
+                title = "No active window";
+            } else if (kind < 65) {
+                appName = kBrowsers[m_random.bounded(int(kBrowsers.size()))];
+                url = randomUrl();
+                title = "Page - " + appName;
+            } else {
+                appName = randomApp();
+                title = appName + " window " + QString::number(m_random.bounded(20));
+            }
+
+            query.addBindValue(kUserId);
+            query.addBindValue(time);
+            query.addBindValue(time + duration);
+            query.addBindValue(appName);
+            query.addBindValue(title);
+            query.addBindValue(url.isEmpty() ? QVariant() : QVariant(url));
+            if (!query.exec()) {
+                qWarning() << "Generator: insert failed:" << query.lastError().text();
+                db.rollback();
+                return false;
+            }
+            time += duration;
+        }
+    }
+    return db.commit();
+}
+
+bool HistoryGenerator::fillRules(QSqlDatabase &db, int ruleCount)
+{
+    if (!db.transaction()) {
+        return false;
+    }
+    QSqlQuery query(db);
+    query.prepare("INSERT INTO aplikasi (aplikasi, window_title, url, jenis, productivity, for_user) "
+                  "VALUES (?, ?, ?, ?, 0, ?)");
+    for (int i = 0; i < ruleCount; ++i) {
+        const bool domainRule = i % 3 != 0;
+        const int jenis = 1 + (i % 2);
+        // Sepertiga aturan hanya berlaku untuk sebagian user, seperti daftar for_user asli
+        const QString forUser = (i % 3 == 2) ? QString("%1,%2").arg(kUserId).arg(kUserId + i % 7 + 1) : QString("0");
+        QString appName;
+        QString url;
+        if (domainRule) {
+            // Domain unik per aturan: (aplikasi, url, for_user) adalah natural key tabel aplikasi
+            url = "https://" + domainAt(i);
+            appName = kBrowsers[i % kBrowsers.size()];
+        } else {
+            // Aturan awal memakai nama aplikasi nyata; sisanya sintetis
+            appName = i / 3 < kApps.size() ? kApps[i / 3] : QString("tool%1").arg(i);
+        }
+        query.addBindValue(appName);
+        query.addBindValue(QString());
+        query.addBindValue(url);
+        query.addBindValue(jenis);
+        query.addBindValue(forUser);
+        if (!query.exec()) {
+            qWarning() << "Generator: rule insert failed:" << query.lastError().text();
+            db.rollback();
+            return false;
+        }
+    }
+    return db.commit();
+}
+
+bool HistoryGenerator::fillTasks(QSqlDatabase &db, int taskCount)
+{
+    if (!db.transaction()) {
+        return false;
+    }
+    QSqlQuery query(db);
+    query.prepare("INSERT INTO task (project_name, task, max_time, time_usage, active, status, paused, user_id) "
+                  "VALUES (?, ?, ?, ?, ?, ?, 0, ?)");
+    static const QStringList statuses = {"Pending", "on-progress", "review", "completed"};
+    for (int i = 0; i < taskCount; ++i) {
+        query.addBindValue(QString("Project %1").arg(i % 12));
+        query.addBindValue(QString("Task %1").arg(i));
+        query.addBindValue(3600 + m_random.bounded(36000));
+        query.addBindValue(m_random.bounded(3600));
+        query.addBindValue(i == 0);
+        query.addBindValue(i == 0 ? QString("on-progress") : statuses[i % statuses.size()]);
+        query.addBindValue(kUserId);
+        if (!query.exec()) {
+            qWarning() << "Generator: task insert failed:" << query.lastError().text();
+            db.rollback();
+            return false;
+        }
+    }
+    return db.commit();
+}
@@ -0,0 +1,32 @@
+#ifndef HISTORYGENERATOR_H
+#define HISTORYGENERATOR_H
+
+#include <QString>
+#include <QSqlDatabase>
+#include <QRandomGenerator>
+
+// Mengisi activity_logs.db / produktif_app_db.db dengan riwayat sintetis yang
+// deterministik (seed tetap), supaya hasil benchmark antar versi bisa dibandingkan.
+// Skema dibuat oleh Logger sendiri; generator hanya menulis baris data.
+class HistoryGenerator
+{
+public:
+    static const int kUserId = 1;
+
+    explicit HistoryGenerator(quint32 seed = 20240601);
+
+    bool fillActivity(QSqlDatabase &db, int days);
+    bool fillRules(QSqlDatabase &db, int ruleCount);
+    bool fillTasks(QSqlDatabase &db, int taskCount);
+
+    // Pasangan (app, url) acak dari kumpulan yang sama dengan riwayat
+    QString randomApp();
+    QString randomUrl();
+
+private:
+    QString domainAt(int index) const;
+
+    QRandomGenerator m_random;
+};
+
+#endif // HISTORYGENERATOR_H
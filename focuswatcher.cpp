@@ -0,0 +1,114 @@
+#include "focuswatcher.h"
+#include <QSocketNotifier>
+#include <QDebug>
+
+#include <X11/Xlib.h>
+#include <X11/Xatom.h>
+
+FocusWatcher::FocusWatcher(QObject *parent) : QObject(parent)
+{
+    m_display = XOpenDisplay(nullptr);
+    if (!m_display) {
+        qWarning() << "Failed to open X11 display, focus events unavailable";
+        return;
+    }
+
+    m_root = DefaultRootWindow(m_display);
+    m_atomActiveWindow = XInternAtom(m_display, "_NET_ACTIVE_WINDOW", False);
+    m_atomWmName = XInternAtom(m_display, "_NET_WM_NAME", False);
+
+    XSelectInput(m_display, m_root, PropertyChangeMask);
+    trackActiveWindow();
+
+    m_notifier = new QSocketNotifier(ConnectionNumber(m_display), QSocketNotifier::Read, this);
+    connect(m_notifier, &QSocketNotifier::activated, this, &FocusWatcher::processEvents);
+
+    // Event bisa sudah masuk antrean Xlib saat setup, sebelum notifier aktif
+    processEvents();
+}
+
+FocusWatcher::~FocusWatcher()
+{
+    if (m_display) {
+        delete m_notifier;
+        m_notifier = nullptr;
+        XCloseDisplay(m_display);
+        m_display = nullptr;
+    }
+}
+
+void FocusWatcher::processEvents()
+{
+    bool changed = false;
+    bool activeChanged = false;
+
+    // Kuras semua event yang ada lalu emit sekali, agar burst event tidak
+    // memicu banyak pembacaan jendela aktif
+    while (XPending(m_display) > 0) {
+        XEvent event;
+        XNextEvent(m_display, &event);
+        if (event.type != PropertyNotify) {
+            continue;
+        }
+        const XPropertyEvent &property = event.xproperty;
+        if (property.window == m_root && property.atom == m_atomActiveWindow) {
+            activeChanged = true;
+            changed = true;
+        } else if (property.window == m_activeWindow &&
+                   (property.atom == m_atomWmName || property.atom == XA_WM_NAME)) {
+            changed = true;
+        }
+    }
+
+    if (activeChanged) {
+        trackActiveWindow();
+        // Round-trip di trackActiveWindow dapat menarik event baru ke antrean Xlib
+        // tanpa membuat socket readable lagi
+        if (XPending(m_display) > 0) {
+            QMetaObject::invokeMethod(this, &FocusWatcher::processEvents, Qt::QueuedConnection);
+        }
+    }
+
+    if (changed) {
+        emit activeWindowChanged();
+    }
+}
+
+void FocusWatcher::trackActiveWindow()
+{
+    quint64 window = readActiveWindow();
+    if (window == m_activeWindow) {
+        return;
+    }
+
+    // Pantau perubahan judul hanya pada jendela yang sedang aktif (mis. ganti tab browser)
+    if (m_activeWindow != 0) {
+        XSelectInput(m_display, m_activeWindow, NoEventMask);
+    }
+    m_activeWindow = window;
+    if (m_activeWindow != 0) {
+        XSelectInput(m_display, m_activeWindow, PropertyChangeMask);
+    }
+    XFlush(m_display);
+}
+
+quint64 FocusWatcher::readActiveWindow() const
+{
+    Atom actualType = None;
+    int actualFormat = 0;
+    unsigned long itemCount = 0;
+    unsigned long bytesAfter = 0;
+    unsigned char *data = nullptr;
+
+    quint64 window = 0;
+    if (XGetWindowProperty(m_display, m_root, m_atomActiveWindow, 0, 1, False, XA_WINDOW,
+                           &actualType, &actualFormat, &itemCount, &bytesAfter, &data) == Success) {
+        if (data && actualType == XA_WINDOW && actualFormat == 32 && itemCount > 0) {
+            window = reinterpret_cast<unsigned long *>(data)[0];
+        }
+    }
+    if (data) {
+        XFree(data);
+    }
+    return window;
+}
@@ -0,0 +1,39 @@
+#ifndef FOCUSWATCHER_H
+#define FOCUSWATCHER_H
+
+#include <QObject>
+
+struct _XDisplay;
+class QSocketNotifier;
+
+// Sumber event perubahan fokus: berlangganan PropertyNotify untuk
+// _NET_ACTIVE_WINDOW (root) dan judul jendela aktif, lewat socket X11
+// yang dipantau event loop Qt. Tidak ada wakeup selama fokus tidak berubah.
+class FocusWatcher : public QObject
+{
+    Q_OBJECT
+public:
+    explicit FocusWatcher(QObject *parent = nullptr);
+    ~FocusWatcher();
+
+    bool isAvailable() const { return m_display != nullptr; }
+
+signals:
+    void activeWindowChanged();
+
+private slots:
+    void processEvents();
+
+private:
+    void trackActiveWindow();
+    quint64 readActiveWindow() const;
+
+    _XDisplay *m_display = nullptr;
+    QSocketNotifier *m_notifier = nullptr;
+    quint64 m_root = 0;
+    quint64 m_activeWindow = 0;
+    quint64 m_atomActiveWindow = 0;
+    quint64 m_atomWmName = 0;
+};
+
+#endif // FOCUSWATCHER_H
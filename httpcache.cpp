@@ -0,0 +1,124 @@
+#include "httpcache.h"
+#include <QNetworkRequest>
+#include <QNetworkReply>
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QDateTime>
+#include <QVariant>
+#include <QDebug>
+
+bool HttpCache::createTable(QSqlDatabase &db)
+{
+    QSqlQuery query(db);
+    if (!query.exec("CREATE TABLE IF NOT EXISTS http_cache ("
+                    "endpoint TEXT NOT NULL, "
+                    "user_id INTEGER NOT NULL, "
+                    "etag TEXT, "
+                    "last_modified TEXT, "
+                    "updated_at INTEGER NOT NULL, "
+                    "PRIMARY KEY(endpoint, user_id))")) {
+        qWarning() << "Failed to create http_cache table:" << query.lastError().text();
+        return false;
+    }
+    return true;
+}
+
+void HttpCache::setDatabase(const QSqlDatabase &db)
+{
+    m_db = db;
+    m_entries.clear();
+}
+
+QString HttpCache::cacheKey(const QString &endpoint, int userId)
+{
+    return endpoint + QLatin1Char('|') + QString::number(userId);
+}
+
+const HttpCache::Validators &HttpCache::lookup(const QString &endpoint, int userId)
+{
+    const QString key = cacheKey(endpoint, userId);
+    auto it = m_entries.find(key);
+    if (it != m_entries.end()) {
+        return it.value();
+    }
+
+    // Dibaca dari database sekali per sesi, selanjutnya dari memori
+    Validators validators;
+    if (m_db.isOpen()) {
+        QSqlQuery query(m_db);
+        query.prepare("SELECT etag, last_modified FROM http_cache WHERE endpoint = :endpoint AND user_id = :user_id");
+        query.bindValue(":endpoint", endpoint);
+        query.bindValue(":user_id", userId);
+        if (!query.exec()) {
+            qWarning() << "Failed to read http_cache:" << query.lastError().text();
+        } else if (query.next()) {
+            validators.etag = query.value(0).toByteArray();
+            validators.lastModified = query.value(1).toByteArray();
+        }
+    }
+    return m_entries.insert(key, validators).value();
+}
+
+void HttpCache::prepare(QNetworkRequest &request, const QString &endpoint, int userId)
+{
+    const Validators &validators = lookup(endpoint, userId);
+    if (!validators.etag.isEmpty()) {
+        request.setRawHeader("If-None-Match", validators.etag);
+    }
+    if (!validators.lastModified.isEmpty()) {
+        request.setRawHeader("If-Modified-Since", validators.lastModified);
+    }
+}
+
+bool HttpCache::isNotModified(const QNetworkReply *reply)
+{
+    return reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() == 304;
+}
+
+void HttpCache::store(const QString &endpoint, int userId, const QNetworkReply *reply)
+{
+    Validators fresh;
+    fresh.etag = reply->rawHeader("ETag");
+    fresh.lastModified = reply->rawHeader("Last-Modified");
+
+    const Validators &current = lookup(endpoint, userId);
+    if (current.etag == fresh.etag && current.lastModified == fresh.lastModified) {
+        return;
+    }
+
+    QSqlQuery query(m_db);
+    if (fresh.etag.isEmpty() && fresh.lastModified.isEmpty()) {
+        query.prepare("DELETE FROM http_cache WHERE endpoint = :endpoint AND user_id = :user_id");
+    } else {
+        query.prepare("INSERT OR REPLACE INTO http_cache (endpoint, user_id, etag, last_modified, updated_at) "
+                      "VALUES (:endpoint, :user_id, :etag, :last_modified, :updated_at)");
+        query.bindValue(":etag", fresh.etag.isEmpty() ? QVariant() : QVariant(QString::fromLatin1(fresh.etag)));
+        query.bindValue(":last_modified", fresh.lastModified.isEmpty() ? QVariant()
+                                                                        : QVariant(QString::fromLatin1(fresh.lastModified)));
+        query.bindValue(":updated_at", QDateTime::currentSecsSinceEpoch());
+    }
+    query.bindValue(":endpoint", endpoint);
+    query.bindValue(":user_id", userId);
+    if (!query.exec()) {
+        qWarning() << "Failed to write http_cache:" << query.lastError().text();
+        return;
+    }
+    m_entries.insert(cacheKey(endpoint, userId), fresh);
+}
+
+void HttpCache::invalidate(const QString &endpoint, int userId)
+{
+    const Validators &current = lookup(endpoint, userId);
+    if (current.etag.isEmpty() && current.lastModified.isEmpty()) {
+        return;
+    }
+
+    QSqlQuery query(m_db);
+    query.prepare("DELETE FROM http_cache WHERE endpoint = :endpoint AND user_id = :user_id");
+    query.bindValue(":endpoint", endpoint);
+    query.bindValue(":user_id", userId);
+    if (!query.exec()) {
+        qWarning() << "Failed to invalidate http_cache:" << query.lastError().text();
+    }
+    m_entries.insert(cacheKey(endpoint, userId), Validators());
+}
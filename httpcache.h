@@ -0,0 +1,43 @@
+#ifndef HTTPCACHE_H
+#define HTTPCACHE_H
+
+#include <QString>
+#include <QByteArray>
+#include <QHash>
+#include <QSqlDatabase>
+
+class QNetworkRequest;
+class QNetworkReply;
+
+// Validator HTTP (ETag/Last-Modified) per endpoint dan user, disimpan di tabel
+// http_cache. Body tidak disimpan: isi respons terakhir sudah ada di tabel
+// lokal, jadi 304 cukup berarti "tidak ada yang perlu ditulis". Validator baru
+// disimpan setelah data respons berhasil di-commit.
+class HttpCache
+{
+public:
+    static bool createTable(QSqlDatabase &db);
+    void setDatabase(const QSqlDatabase &db);
+
+    // Tambahkan If-None-Match / If-Modified-Since jika ada validator tersimpan
+    void prepare(QNetworkRequest &request, const QString &endpoint, int userId);
+    static bool isNotModified(const QNetworkReply *reply);
+    // Tidak menulis ke disk jika validator sama dengan yang tersimpan
+    void store(const QString &endpoint, int userId, const QNetworkReply *reply);
+    // Dipanggil jika data lokal berubah di luar respons server, agar fetch berikutnya penuh
+    void invalidate(const QString &endpoint, int userId);
+
+private:
+    struct Validators {
+        QByteArray etag;
+        QByteArray lastModified;
+    };
+
+    const Validators &lookup(const QString &endpoint, int userId);
+    static QString cacheKey(const QString &endpoint, int userId);
+
+    QSqlDatabase m_db;
+    QHash<QString, Validators> m_entries;
+};
+
+#endif // HTTPCACHE_H
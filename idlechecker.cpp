@@ -1,7 +1,9 @@
 // idlechecker.cpp
 
 #include "idlechecker.h"
+#include "logcategories.h"
 #include "logger.h"
+#include "perfstats.h"
 #include <QDateTime>
 #include <QDebug>
 #include <QProcess>
@@ -25,12 +27,32 @@
 #include <X11/extensions/scrnsaver.h>
 #endif
 
+namespace {
+
+// Selang pemeriksaan saat idle (agar kembali aktif cepat terdeteksi) dan saat
+// tracking tidak berjalan (perubahan state juga memicu pemeriksaan ulang)
+const int kIdleCheckIntervalMs = 1000;
+const int kInactiveCheckIntervalMs = 5000;
+
+} // namespace
+
 IdleChecker::IdleChecker(Logger *logger, QObject *parent) : QObject(parent), m_logger(logger)
 {
-    m_timer.setInterval(1000);
+#if defined(Q_OS_LINUX)
+    m_display = XOpenDisplay(nullptr);
+    if (m_display) {
+        m_screenSaverInfo = XScreenSaverAllocInfo();
+    } else {
+        qWarning() << "Failed to open X11 display";
+    }
+#endif
+
+    // Single-shot: selang berikutnya dihitung dari sisa waktu menuju threshold
+    m_timer.setSingleShot(true);
     connect(&m_timer, &QTimer::timeout, this, &IdleChecker::checkIdleTime);
+    connect(this, &IdleChecker::idleThresholdChanged, this, [this]() { scheduleNextCheck(0); });
     if (m_logger) {
-        connect(m_logger, &Logger::idleThresholdChanged, this, &IdleChecker::updateIdleThresholdFromDatabase);
+        connect(m_logger, &Logger::idleThresholdChanged, this, &IdleChecker::updateIdleThresholdFromSettings);
         connect(m_logger, &Logger::trackingActiveChanged, this, [this]() {
             if (m_logger->isTrackingActive()) {
                 // Reset idle state when tracking is reactivated
@@ -43,6 +65,7 @@ IdleChecker::IdleChecker(Logger *logger, QObject *parent) : QObject(parent), m_l
                 m_lastIdleLogTime = 0;
                 m_lastActiveTime = 0;
             }
+            scheduleNextCheck(0);
         });
         connect(m_logger, &Logger::taskPausedChanged, this, [this]() {
             if (m_logger->isTaskPaused()) {
@@ -51,34 +74,52 @@ IdleChecker::IdleChecker(Logger *logger, QObject *parent) : QObject(parent), m_l
                 m_lastIdleLogTime = 0;
                 m_lastActiveTime = 0;
             }
+            scheduleNextCheck(0);
         });
-        updateIdleThresholdFromDatabase();
+        updateIdleThresholdFromSettings();
     } else {
         qWarning() << "IdleChecker initialized with null logger, using default threshold:" << m_idleThreshold << "seconds";
     }
-    m_timer.start();
+    scheduleNextCheck(kIdleCheckIntervalMs);
 }
 
 IdleChecker::~IdleChecker()
 {
     m_timer.stop();
+#if defined(Q_OS_LINUX)
+    if (m_screenSaverInfo) {
+        XFree(m_screenSaverInfo);
+        m_screenSaverInfo = nullptr;
+    }
+    if (m_display) {
+        XCloseDisplay(m_display);
+        m_display = nullptr;
+    }
+#endif
 }
 
-void IdleChecker::updateIdleThresholdFromDatabase()
+void IdleChecker::scheduleNextCheck(int msec)
+{
+    // Jangan menunda pemeriksaan yang sudah dijadwalkan lebih awal
+    if (m_timer.isActive() && m_timer.remainingTime() <= msec) {
+        return;
+    }
+    m_timer.start(qMax(0, msec));
+}
+
+void IdleChecker::updateIdleThresholdFromSettings()
 {
     if (!m_logger) {
         qWarning() << "Logger is null, cannot update idle threshold";
         return;
     }
-    int dbThreshold = m_logger->getIdleThreshold();
-    qDebug() << "Retrieved idle threshold from database:" << dbThreshold << "seconds";
-    if (dbThreshold > 0) {
-        setIdleThreshold(dbThreshold);
-        qDebug() << "Idle threshold set to:" << dbThreshold << "seconds";
+    // Dibaca dari cache pengaturan Logger, tanpa query database
+    int threshold = m_logger->getIdleThreshold();
+    if (threshold > 0) {
+        setIdleThreshold(threshold);
     } else {
-        qDebug() << "Invalid threshold from database, using default:" << m_idleThreshold << "seconds";
+        qCDebug(lcTracking) << "Invalid idle threshold, using default:" << m_idleThreshold << "seconds";
     }
-    m_lastThresholdCheckTime = QDateTime::currentSecsSinceEpoch();
 }
 
 int IdleChecker::idleThreshold() const
@@ -90,7 +131,7 @@ void IdleChecker::setIdleThreshold(int seconds)
 {
     if (m_idleThreshold != seconds && seconds > 0) {
         m_idleThreshold = seconds;
-        qDebug() << "Idle threshold updated to:" << m_idleThreshold << "seconds";
+        qCDebug(lcTracking) << "Idle threshold updated to:" << m_idleThreshold << "seconds";
         emit idleThresholdChanged();
     }
 }
@@ -108,7 +149,7 @@ void IdleChecker::checkIdleTime()
             m_lastIdleLogTime = 0;
             m_lastActiveTime = 0;
         }
-        qDebug() << "Idle check skipped: user not logged in";
+        scheduleNextCheck(kInactiveCheckIntervalMs);
         return;
     }
     // Skip checking if tracking is not active or task is paused
@@ -118,21 +159,18 @@ void IdleChecker::checkIdleTime()
             m_isIdle = false;
             m_lastIdleLogTime = 0;
             m_lastActiveTime = 0;
-            qDebug() << "Idle checking stopped due to pause or tracking inactive";
+            qCDebug(lcTracking) << "Idle checking stopped due to pause or tracking inactive";
         }
+        scheduleNextCheck(kInactiveCheckIntervalMs);
         return;
     }
 
     qint64 currentTime = QDateTime::currentSecsSinceEpoch();
 
-    // Check database threshold every 10 seconds
-    if (currentTime - m_lastThresholdCheckTime >= 10) {
-        updateIdleThresholdFromDatabase();
-    }
-
     qint64 idleTime = getSystemIdleTime() / 1000; // Convert to seconds
     if (idleTime < 0) {
         qWarning() << "Skipping idle check due to system error";
+        scheduleNextCheck(kInactiveCheckIntervalMs);
         return;
     }
 
@@ -142,14 +180,14 @@ void IdleChecker::checkIdleTime()
             m_lastActiveTime = currentTime - idleTime;
             m_lastIdleLogTime = currentTime;
             m_isIdle = true;
-            qDebug() << "Idle detected, started at:" << QDateTime::fromSecsSinceEpoch(m_lastActiveTime).toString();
+            qCDebug(lcTracking) << "Idle detected, started at:" << QDateTime::fromSecsSinceEpoch(m_lastActiveTime).toString();
             emit showIdleNotification("Idle Terdeteksi");
-            qDebug() << "Sent idle notification: You have been idle";
+            qCDebug(lcTracking) << "Sent idle notification: You have been idle";
 
             // === PERUBAHAN DIMULAI DI SINI ===
             // Secara otomatis menjeda tugas yang aktif jika pengguna menjadi idle
             if (m_logger && !m_logger->isTaskPaused()) {
-                qDebug() << "Idle state detected. Automatically pausing the active task.";
+                qCDebug(lcTracking) << "Idle state detected. Automatically pausing the active task.";
                 m_logger->toggleTaskPause();
             }
             // === PERUBAHAN SELESAI ===
@@ -162,25 +200,33 @@ void IdleChecker::checkIdleTime()
             int minutes = idleTime / 60;
             int seconds = idleTime % 60;
             QString durationText = QString("%1m %2s").arg(minutes).arg(seconds);
-            qDebug() << "Logged idle period, duration:" << durationText;
+            qCDebug(lcTracking) << "Logged idle period, duration:" << durationText;
         }
     } else {
         if (m_isIdle) {
             // Returning from idle
             if (currentTime > m_lastIdleLogTime) {
                 emit idleDetected(m_lastIdleLogTime, currentTime);
-                qDebug() << "Logged final idle period, ended at:" << QDateTime::fromSecsSinceEpoch(currentTime).toString();
+                qCDebug(lcTracking) << "Logged final idle period, ended at:" << QDateTime::fromSecsSinceEpoch(currentTime).toString();
             }
             m_isIdle = false;
             m_lastIdleLogTime = 0;
             m_lastActiveTime = 0;
-            qDebug() << "Returned from idle";
+            qCDebug(lcTracking) << "Returned from idle";
         }
     }
+
+    if (m_isIdle) {
+        scheduleNextCheck(kIdleCheckIntervalMs);
+    } else {
+        // Idle time tidak mungkin mencapai threshold sebelum sisa waktu ini habis
+        scheduleNextCheck(int(qMax<qint64>(1, m_idleThreshold - idleTime)) * 1000);
+    }
 }
 
 qint64 IdleChecker::getSystemIdleTime() const
 {
+    ScopedPerfTimer perf("probe.idle");
 #ifdef Q_OS_WIN
     return getSystemIdleTimeWindows();
 #elif defined(Q_OS_MACOS)
@@ -220,25 +266,17 @@ qint64 IdleChecker::getSystemIdleTimeMacOS() const {
 #elif defined(Q_OS_LINUX)
 qint64 IdleChecker::getSystemIdleTimeLinux() const
 {
-    Display *display = XOpenDisplay(nullptr);
-    if (!display) {
-        qWarning() << "Failed to open X11 display";
+    if (!m_display) {
         return -1;
     }
-    XScreenSaverInfo *info = XScreenSaverAllocInfo();
+    XScreenSaverInfo *info = static_cast<XScreenSaverInfo *>(m_screenSaverInfo);
     if (!info) {
-        XCloseDisplay(display);
         qWarning() << "Failed to allocate XScreenSaverInfo";
         return -1;
     }
-    if (XScreenSaverQueryInfo(display, DefaultRootWindow(display), info)) {
-        qint64 idleTime = info->idle;
-        XFree(info);
-        XCloseDisplay(display);
-        return idleTime;
+    if (XScreenSaverQueryInfo(m_display, DefaultRootWindow(m_display), info)) {
+        return static_cast<qint64>(info->idle);
     }
-    XFree(info);
-    XCloseDisplay(display);
     qWarning() << "Failed to query XScreenSaverInfo";
     return -1;
 }
@@ -3,6 +3,7 @@
 #include <QObject>
 #include <QTimer>
 class Logger;
+struct _XDisplay;
 
 class IdleChecker : public QObject
 {
@@ -14,7 +15,7 @@ public:
     int idleThreshold() const;
     void setIdleThreshold(int seconds);
     bool isIdle() const;
-    void updateIdleThresholdFromDatabase();
+    void updateIdleThresholdFromSettings();
 signals:
     void idleDetected(qint64 startTime, qint64 endTime);
     void idleThresholdChanged();
@@ -24,6 +25,7 @@ private slots:
     void checkIdleTime();
 private:
     qint64 getSystemIdleTime() const;
+    void scheduleNextCheck(int msec);
 
 #ifdef Q_OS_WIN
     qint64 getSystemIdleTimeWindows() const;
@@ -31,12 +33,13 @@ private:
     qint64 getSystemIdleTimeMacOS() const;
 #else
     qint64 getSystemIdleTimeLinux() const;
+    _XDisplay *m_display = nullptr;
+    void *m_screenSaverInfo = nullptr; // XScreenSaverInfo*, dipakai ulang setiap query
 #endif
     QTimer m_timer;
     int m_idleThreshold = 180; // Default 2 menit
     qint64 m_lastActiveTime = 0;
     qint64 m_lastIdleLogTime = 0; // Waktu terakhir log idle dicatat
-    qint64 m_lastThresholdCheckTime = 0; // Waktu terakhir pemeriksaan threshold
     bool m_isIdle = false;
     Logger* m_logger;
 };
@@ -0,0 +1,9 @@
+#include "logcategories.h"
+
+Q_LOGGING_CATEGORY(lcTracking, "deskmon.tracking", QtInfoMsg)
+Q_LOGGING_CATEGORY(lcStats, "deskmon.stats", QtInfoMsg)
+Q_LOGGING_CATEGORY(lcTasks, "deskmon.tasks", QtInfoMsg)
+Q_LOGGING_CATEGORY(lcApi, "deskmon.api", QtInfoMsg)
+Q_LOGGING_CATEGORY(lcAuth, "deskmon.auth", QtInfoMsg)
+Q_LOGGING_CATEGORY(lcDb, "deskmon.db", QtInfoMsg)
+Q_LOGGING_CATEGORY(lcUi, "deskmon.ui", QtInfoMsg)
@@ -0,0 +1,17 @@
+#ifndef LOGCATEGORIES_H
+#define LOGCATEGORIES_H
+
+#include <QLoggingCategory>
+
+// Kategori log Deskmon. Pesan debug dimatikan secara default dan dapat dinyalakan
+// lewat QT_LOGGING_RULES, mis. "deskmon.api.debug=true". Pada build release
+// QT_NO_DEBUG_OUTPUT menghapus qCDebug sepenuhnya saat kompilasi.
+Q_DECLARE_LOGGING_CATEGORY(lcTracking) // jendela aktif, idle, segmen log
+Q_DECLARE_LOGGING_CATEGORY(lcStats)    // rollup, statistik produktivitas
+Q_DECLARE_LOGGING_CATEGORY(lcTasks)    // daftar tugas, task aktif, pause/play
+Q_DECLARE_LOGGING_CATEGORY(lcApi)      // request/response API dan outbox
+Q_DECLARE_LOGGING_CATEGORY(lcAuth)     // login, logout, token
+Q_DECLARE_LOGGING_CATEGORY(lcDb)       // skema, migrasi, pengaturan
+Q_DECLARE_LOGGING_CATEGORY(lcUi)       // profil, ikon, dialog
+
+#endif // LOGCATEGORIES_H
@@ -0,0 +1,223 @@
+#include "logentrymodel.h"
+#include "storageworker.h"
+#include "perfstats.h"
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QDateTime>
+#include <QDebug>
+#include <limits>
+
+namespace {
+
+const int kPageSize = 100;
+
+} // namespace
+
+LogEntryModel::LogEntryModel(QObject *parent) : QAbstractListModel(parent)
+{
+}
+
+void LogEntryModel::setStorage(StorageWorker *storage)
+{
+    m_storage = storage;
+}
+
+void LogEntryModel::reset(int userId, const QDate &from, const QDate &to)
+{
+    beginResetModel();
+    m_entries.clear();
+    ++m_generation;
+    m_fetching = false;
+    m_userId = userId;
+    m_fromEpoch = from.isValid() ? from.startOfDay().toSecsSinceEpoch() : 0;
+    m_toEpoch = to.isValid() ? to.addDays(1).startOfDay().toSecsSinceEpoch() - 1
+                             : std::numeric_limits<qint64>::max();
+    m_hasCursor = false;
+    m_cursorStart = 0;
+    m_cursorId = 0;
+    m_atEnd = userId == -1;
+    endResetModel();
+
+    // Halaman pertama langsung dimuat agar view tidak kosong sesaat
+    if (!m_atEnd) {
+        fetchMore(QModelIndex());
+    }
+}
+
+bool LogEntryModel::inRange(qint64 startTime) const
+{
+    return startTime >= m_fromEpoch && startTime <= m_toEpoch;
+}
+
+void LogEntryModel::insertSegment(int userId, qint64 startTime, qint64 endTime,
+                                  const QString &appName, const QString &title, const QString &url)
+{
+    if (userId != m_userId || !inRange(startTime) || appName.isEmpty() || title.isEmpty()) {
+        return;
+    }
+
+    Entry entry;
+    entry.startTime = startTime;
+    entry.endTime = endTime;
+    entry.appName = appName;
+    entry.title = title;
+    entry.url = url;
+
+    // Segmen baru hampir selalu yang terbaru, jadi posisinya di baris 0
+    int row = 0;
+    while (row < m_entries.size() && m_entries[row].startTime > startTime) {
+        ++row;
+    }
+    beginInsertRows(QModelIndex(), row, row);
+    m_entries.insert(row, entry);
+    endInsertRows();
+}
+
+int LogEntryModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : m_entries.size();
+}
+
+QVariant LogEntryModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() < 0 || index.row() >= m_entries.size()) {
+        return QVariant();
+    }
+
+    const Entry &entry = m_entries[index.row()];
+    switch (role) {
+    case StartTimeRole:
+        return entry.startTime;
+    case EndTimeRole:
+        return entry.endTime;
+    case DurationRole:
+        return entry.endTime - entry.startTime;
+    case StartTextRole:
+        return QDateTime::fromSecsSinceEpoch(entry.startTime).toString("hh:mm:ss");
+    case DurationTextRole: {
+        const qint64 seconds = entry.endTime - entry.startTime;
+        return QString("%1m %2s").arg(seconds / 60).arg(seconds % 60);
+    }
+    case Qt::DisplayRole:
+    case AppNameRole:
+        return entry.appName;
+    case TitleRole:
+        return entry.title;
+    case UrlRole:
+        return entry.url;
+    default:
+        return QVariant();
+    }
+}
+
+QHash<int, QByteArray> LogEntryModel::roleNames() const
+{
+    return {
+        {StartTimeRole, "startTime"},
+        {EndTimeRole, "endTime"},
+        {DurationRole, "duration"},
+        {StartTextRole, "startText"},
+        {DurationTextRole, "durationText"},
+        {AppNameRole, "appName"},
+        {TitleRole, "title"},
+        {UrlRole, "url"}
+    };
+}
+
+bool LogEntryModel::canFetchMore(const QModelIndex &parent) const
+{
+    return !parent.isValid() && !m_atEnd && !m_fetching;
+}
+
+void LogEntryModel::fetchMore(const QModelIndex &parent)
+{
+    if (parent.isValid() || m_atEnd || m_fetching) {
+        return;
+    }
+    if (!m_storage) {
+        qWarning() << "Cannot fetch log entries: No storage worker";
+        return;
+    }
+
+    // Halaman dibaca di thread storage; hasil dari reset() sebelumnya diabaikan
+    m_fetching = true;
+    const quint64 generation = m_generation;
+    const int userId = m_userId;
+    const qint64 fromEpoch = m_fromEpoch;
+    const qint64 toEpoch = m_toEpoch;
+    const bool hasCursor = m_hasCursor;
+    const qint64 cursorStart = m_cursorStart;
+    const qint64 cursorId = m_cursorId;
+    m_storage->run(StorageWorker::Activity, [=](QSqlDatabase &db) {
+        QVector<Entry> page;
+        const bool ok = fetchPage(db, userId, fromEpoch, toEpoch, hasCursor, cursorStart, cursorId, page);
+        return qMakePair(ok, page);
+    }).then(this, [this, generation](const QPair<bool, QVector<Entry>> &result) {
+        if (generation != m_generation) {
+            return;
+        }
+        m_fetching = false;
+        appendPage(result.first, result.second);
+    });
+}
+
+bool LogEntryModel::fetchPage(QSqlDatabase &db, int userId, qint64 fromEpoch, qint64 toEpoch,
+                              bool hasCursor, qint64 cursorStart, qint64 cursorId, QVector<Entry> &page)
+{
+    if (!db.isOpen()) {
+        qWarning() << "Cannot fetch log entries: Database is not open";
+        return false;
+    }
+
+    ScopedPerfTimer perf("sql.log_page");
+    // Keyset paging di atas indeks (id_user, start_time); tidak pernah OFFSET
+    QSqlQuery query(db);
+    query.prepare(QString(
+        "SELECT id, start_time, end_time, app_name, title, url FROM log "
+        "WHERE id_user = :id_user AND start_time BETWEEN :from AND :to "
+        "AND app_name IS NOT NULL AND title IS NOT NULL %1"
+        "ORDER BY start_time DESC, id DESC LIMIT :limit")
+        .arg(hasCursor ? "AND (start_time < :cursor_start OR (start_time = :cursor_start2 AND id < :cursor_id)) " : ""));
+    query.bindValue(":id_user", userId);
+    query.bindValue(":from", fromEpoch);
+    query.bindValue(":to", toEpoch);
+    if (hasCursor) {
+        query.bindValue(":cursor_start", cursorStart);
+        query.bindValue(":cursor_start2", cursorStart);
+        query.bindValue(":cursor_id", cursorId);
+    }
+    query.bindValue(":limit", kPageSize);
+
+    if (!query.exec()) {
+        qWarning() << "Failed to fetch log entries:" << query.lastError().text();
+        return false;
+    }
+
+    page.reserve(kPageSize);
+    while (query.next()) {
+        Entry entry;
+        entry.id = query.value(0).toLongLong();
+        entry.startTime = query.value(1).toLongLong();
+        entry.endTime = query.value(2).toLongLong();
+        entry.appName = query.value(3).toString();
+        entry.title = query.value(4).toString();
+        entry.url = query.value(5).toString();
+        page.append(entry);
+    }
+    return true;
+}
+
+void LogEntryModel::appendPage(bool ok, const QVector<Entry> &page)
+{
+    m_atEnd = !ok || page.size() < kPageSize;
+    if (page.isEmpty()) {
+        return;
+    }
+    m_hasCursor = true;
+    m_cursorStart = page.constLast().startTime;
+    m_cursorId = page.constLast().id;
+
+    beginInsertRows(QModelIndex(), m_entries.size(), m_entries.size() + page.size() - 1);
+    m_entries.append(page);
+    endInsertRows();
+}
@@ -0,0 +1,73 @@
+#ifndef LOGENTRYMODEL_H
+#define LOGENTRYMODEL_H
+
+#include <QAbstractListModel>
+#include <QSqlDatabase>
+#include <QDate>
+#include <QVector>
+
+class StorageWorker;
+
+// Riwayat aktivitas (tabel log) sebagai model ber-paging: baris dimuat per
+// halaman dengan keyset (start_time, id) menurun, dan segmen baru disisipkan
+// di atas tanpa memuat ulang seluruh riwayat. Halaman dibaca asinkron di
+// StorageWorker.
+class LogEntryModel : public QAbstractListModel
+{
+    Q_OBJECT
+public:
+    enum Roles {
+        StartTimeRole = Qt::UserRole + 1,
+        EndTimeRole,
+        DurationRole,
+        StartTextRole,
+        DurationTextRole,
+        AppNameRole,
+        TitleRole,
+        UrlRole
+    };
+
+    explicit LogEntryModel(QObject *parent = nullptr);
+
+    void setStorage(StorageWorker *storage);
+    // Mengosongkan model lalu memuat halaman pertama untuk user dan rentang tanggal ini
+    void reset(int userId, const QDate &from, const QDate &to);
+    void insertSegment(int userId, qint64 startTime, qint64 endTime,
+                       const QString &appName, const QString &title, const QString &url);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QHash<int, QByteArray> roleNames() const override;
+    bool canFetchMore(const QModelIndex &parent) const override;
+    void fetchMore(const QModelIndex &parent) override;
+
+private:
+    struct Entry {
+        qint64 id = 0;          // 0 untuk segmen yang disisipkan sebelum ditulis ke database
+        qint64 startTime = 0;
+        qint64 endTime = 0;
+        QString appName;
+        QString title;
+        QString url;
+    };
+
+    bool inRange(qint64 startTime) const;
+    static bool fetchPage(QSqlDatabase &db, int userId, qint64 fromEpoch, qint64 toEpoch,
+                          bool hasCursor, qint64 cursorStart, qint64 cursorId, QVector<Entry> &page);
+    void appendPage(bool ok, const QVector<Entry> &page);
+
+    StorageWorker *m_storage = nullptr;
+    QVector<Entry> m_entries;
+    int m_userId = -1;
+    qint64 m_fromEpoch = 0;
+    qint64 m_toEpoch = 0;
+    // Kursor keyset: baris tertua yang sudah dimuat dari database
+    qint64 m_cursorStart = 0;
+    qint64 m_cursorId = 0;
+    bool m_hasCursor = false;
+    bool m_atEnd = true;
+    bool m_fetching = false;
+    quint64 m_generation = 0;
+};
+
+#endif // LOGENTRYMODEL_H
@@ -1,4 +1,7 @@
 #include "logger.h"
+#include "logcategories.h"
+#include "perfstats.h"
+#include "statementcache.h"
 #include <QSqlQuery>
 #include <QSqlError>
 #include <QDateTime>
@@ -17,6 +20,12 @@
 #include <QBuffer>
 #include <QRegularExpression>
 #include <QMessageBox>
+#include <QThread>
+#include <QElapsedTimer>
+#include <QFutureWatcher>
+#include <QtConcurrent/QtConcurrentRun>
+#include <limits>
+#include <utility>
 
 #ifdef Q_OS_WIN
 #include <windows.h>
@@ -37,8 +46,7 @@
 #include <IOKit/IOKitLib.h>
 
 #else
-#include <X11/Xlib.h>
-#include <X11/Xutil.h>
+#include "x11windowprobe.h"
 #endif
 
 #pragma comment(lib, "psapi.lib")
@@ -47,11 +55,284 @@
 #pragma comment(lib, "shlwapi.lib")
 #pragma comment(lib, "uiautomationcore.lib")
 
+namespace {
+
+bool execSchema(QSqlDatabase &db, const QStringList &statements)
+{
+    QSqlQuery query(db);
+    for (const QString &statement : statements) {
+        if (!query.exec(statement)) {
+            qWarning() << "Schema statement failed:" << query.lastError().text() << statement;
+            return false;
+        }
+    }
+    return true;
+}
+
+// Batas epoch [awal hari `from`, akhir hari `to`] dalam waktu lokal, untuk
+// `start_time BETWEEN ? AND ?` yang bisa memakai indeks (id_user, start_time).
+// Tanggal tidak valid berarti sisi itu tidak dibatasi.
+void localDayBounds(const QDate &from, const QDate &to, qint64 &startEpoch, qint64 &endEpoch)
+{
+    startEpoch = from.isValid() ? from.startOfDay().toSecsSinceEpoch() : 0;
+    endEpoch = to.isValid() ? to.addDays(1).startOfDay().toSecsSinceEpoch() - 1
+                            : std::numeric_limits<qint64>::max();
+}
+
+bool hasColumn(QSqlDatabase &db, const QString &table, const QString &column)
+{
+    QSqlQuery query(db);
+    query.exec(QString("PRAGMA table_info(%1)").arg(table));
+    while (query.next()) {
+        if (query.value("name").toString() == column) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Migrasi berversi (PRAGMA user_version). Versi 1 adalah skema lama; IF NOT EXISTS
+// dipertahankan agar database yang dibuat sebelum ada versioning tetap bisa di-upgrade.
+// Tambahkan langkah baru di akhir, jangan ubah langkah yang sudah dirilis.
+const QVector<SqliteSetup::Migration> &activityMigrations()
+{
+    static const QVector<SqliteSetup::Migration> migrations = {
+        [](QSqlDatabase &db) {
+            return execSchema(db, {
+                "CREATE TABLE IF NOT EXISTS log ("
+                "id INTEGER PRIMARY KEY AUTOINCREMENT, "
+                "id_user INTEGER NOT NULL, "
+                "start_time INTEGER NOT NULL, "
+                "end_time INTEGER NOT NULL, "
+                "app_name TEXT, "
+                "title TEXT, "
+                "url TEXT, "
+                "FOREIGN KEY(id_user) REFERENCES users(id) ON DELETE CASCADE)",
+                "CREATE TABLE IF NOT EXISTS users ("
+                "id INTEGER PRIMARY KEY AUTOINCREMENT, "
+                "username TEXT UNIQUE NOT NULL, "
+                "password TEXT NOT NULL, "
+                "department TEXT, "
+                "profile_image TEXT, "
+                "email TEXT, "
+                "role TEXT, "
+                "token TEXT)"
+            });
+        },
+        [](QSqlDatabase &db) {
+            // Semua reader memfilter per user dan rentang start_time
+            return execSchema(db, {
+                "CREATE INDEX IF NOT EXISTS idx_log_user_start ON log(id_user, start_time)"
+            });
+        },
+    };
+    return migrations;
+}
+
+const QVector<SqliteSetup::Migration> &productivityMigrations()
+{
+    static const QVector<SqliteSetup::Migration> migrations = {
+        [](QSqlDatabase &db) {
+            bool ok = execSchema(db, {
+                "CREATE TABLE IF NOT EXISTS aplikasi ("
+                "id INTEGER PRIMARY KEY AUTOINCREMENT, "
+                "aplikasi TEXT NOT NULL, "
+                "window_title TEXT, "
+                "url TEXT, "
+                "jenis INTEGER NOT NULL, "
+                "productivity INTEGER NOT NULL DEFAULT 0, "
+                "for_user TEXT NOT NULL DEFAULT '0')",
+                "CREATE TABLE IF NOT EXISTS task ("
+                "id INTEGER PRIMARY KEY AUTOINCREMENT, "
+                "project_name TEXT NOT NULL, "
+                "task TEXT, "
+                "max_time INTEGER NOT NULL, "
+                "time_usage INTEGER NOT NULL, "
+                "active BOOLEAN NOT NULL, "
+                "status TEXT NOT NULL, "
+                "paused BOOLEAN NOT NULL DEFAULT 0,"
+                "user_id INTEGER NOT NULL)",
+                "CREATE TABLE IF NOT EXISTS completed_tasks ("
+                "id INTEGER PRIMARY KEY AUTOINCREMENT, "
+                "project_name TEXT NOT NULL, "
+                "task TEXT NOT NULL, "
+                "max_time INTEGER NOT NULL, "
+                "time_usage INTEGER NOT NULL, "
+                "completed_time INTEGER NOT NULL, "
+                "user_id INTEGER NOT NULL)",
+                "CREATE TABLE IF NOT EXISTS idle_settings ("
+                "id INTEGER PRIMARY KEY AUTOINCREMENT, "
+                "threshold_seconds INTEGER)",
+                "CREATE TABLE IF NOT EXISTS log_paused ("
+                "id INTEGER PRIMARY KEY AUTOINCREMENT, "
+                "task_id INTEGER NOT NULL, "
+                "start_reality TEXT NOT NULL, "  // ISO 8601 format: 'YYYY-MM-DDTHH:MM:SS.SSSSSSZ'
+                "end_reality TEXT, "
+                "current_status TEXT NOT NULL, "  // 'pause' or 'play'
+                "FOREIGN KEY(task_id) REFERENCES task(id))",
+                "CREATE TABLE IF NOT EXISTS work_time ("
+                "id INTEGER PRIMARY KEY AUTOINCREMENT, "
+                "user_id INTEGER NOT NULL, "
+                "date TEXT NOT NULL, "
+                "elapsed_seconds INTEGER NOT NULL DEFAULT 0, "
+                "UNIQUE(user_id, date))"
+            });
+            ok = ok && SettingsCache::createTable(db);
+
+            // Database lama: tabel task/completed_tasks dibuat sebelum ada kolom user_id
+            for (const QString &table : {QStringLiteral("task"), QStringLiteral("completed_tasks")}) {
+                if (ok && !hasColumn(db, table, "user_id")) {
+                    ok = execSchema(db, {QString("ALTER TABLE %1 ADD COLUMN user_id INTEGER NOT NULL DEFAULT 0").arg(table)});
+                }
+            }
+            return ok;
+        },
+        [](QSqlDatabase &db) {
+            return ApiOutbox::createTable(db);
+        },
+        [](QSqlDatabase &db) {
+            bool ok = UsageReport::createTable(db);
+            if (ok && !hasColumn(db, "outbox", "tag")) {
+                ok = execSchema(db, {"ALTER TABLE outbox ADD COLUMN tag TEXT"});
+            }
+            return ok;
+        },
+        [](QSqlDatabase &db) {
+            return HttpCache::createTable(db);
+        },
+        [](QSqlDatabase &db) {
+            // Kunci alami untuk upsert aturan. Duplikat lama dibuang lebih dulu;
+            // aturan yang sudah diputuskan server (jenis != 0) diutamakan.
+            bool ok = execSchema(db, {
+                "DELETE FROM aplikasi WHERE id NOT IN ("
+                "SELECT id FROM (SELECT id, ROW_NUMBER() OVER ("
+                "PARTITION BY aplikasi, COALESCE(url, ''), for_user ORDER BY jenis <> 0 DESC, id) AS rn "
+                "FROM aplikasi) WHERE rn = 1)",
+                "CREATE UNIQUE INDEX IF NOT EXISTS idx_aplikasi_app_url_user "
+                "ON aplikasi(aplikasi, COALESCE(url, ''), for_user)"
+            });
+            // Generasi sync terakhir yang memuat baris ini; NULL = baris lokal
+            for (const QString &table : {QStringLiteral("aplikasi"), QStringLiteral("task")}) {
+                if (ok && !hasColumn(db, table, "sync_gen")) {
+                    ok = execSchema(db, {QString("ALTER TABLE %1 ADD COLUMN sync_gen INTEGER").arg(table)});
+                }
+            }
+            return ok;
+        },
+    };
+    return migrations;
+}
+
+const int kLoginTimeoutMs = 15000;
+const int kShutdownDrainMs = 500;
+const int kPerfDumpIntervalSeconds = 60;
+const int kDefaultTaskMaxTime = 8 * 3600; // tugas tanpa duration dari server
+
+void writeWorkTime(QSqlDatabase &db, int userId, const QString &date, int seconds)
+{
+    ScopedPerfTimer perf("sql.work_time_save");
+    // INSERT OR REPLACE: membuat baru atau memperbarui yang sudah ada
+    StatementCache::Query query = StatementCache::get(db, StatementCache::WorkTimeUpsert);
+    if (!query.isValid()) {
+        return;
+    }
+    query->bindValue(":user_id", userId);
+    query->bindValue(":date", date);
+    query->bindValue(":seconds", seconds);
+
+    if (!query.exec()) {
+        qWarning() << "Failed to save work time:" << query->lastError().text();
+    }
+}
+
+// Kunci http_cache untuk download yang memakai conditional request
+const QString kTaskListCacheKey = QStringLiteral("task-by-user");
+const QString kRulesCacheKey = QStringLiteral("app-request/all");
+
+struct LoginUser {
+    int id = -1;
+    QString username;
+    QString email;
+    QString role;
+    QString token;
+    QString passwordHash;
+};
+
+// Dijalankan di thread pool; QSqlDatabase tidak boleh dipakai lintas thread,
+// jadi buka koneksi sendiri ke file yang sama (WAL mengizinkan penulis ini)
+bool upsertLoginUser(const QString &databasePath, const LoginUser &user)
+{
+    const QString connectionName = QString("login_upsert_%1").arg(quintptr(QThread::currentThreadId()));
+    bool ok = false;
+    {
+        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connectionName);
+        db.setDatabaseName(databasePath);
+        db.setConnectOptions("QSQLITE_BUSY_TIMEOUT=5000");
+        if (!db.open()) {
+            qWarning() << "Login upsert: failed to open database:" << db.lastError().text();
+        } else {
+            QSqlQuery query(db);
+            query.prepare(
+                "INSERT OR REPLACE INTO users "
+                "(id, username, password, email, role, token) "
+                "VALUES (:id, :username, :password, :email, :role, :token)"
+                );
+            query.bindValue(":id", user.id);
+            query.bindValue(":username", user.username);
+            query.bindValue(":password", user.passwordHash);
+            query.bindValue(":email", user.email);
+            query.bindValue(":role", user.role);
+            query.bindValue(":token", user.token);
+            ok = query.exec();
+            if (!ok) {
+                qWarning() << "Login upsert failed:" << query.lastError().text();
+            }
+            db.close();
+        }
+    }
+    QSqlDatabase::removeDatabase(connectionName);
+    return ok;
+}
+
+} // namespace
+
 Logger::Logger(QObject *parent) : QObject(parent)
 {
+    // Server API dapat diarahkan ke mock server lokal untuk pengujian
+    m_apiBaseUrl = qEnvironmentVariable("DESKMON_API_BASE_URL", "https://deskmon.pranala-dt.co.id/api");
+    while (m_apiBaseUrl.endsWith('/')) {
+        m_apiBaseUrl.chop(1);
+    }
+    m_sqliteProfile = SqliteSetup::Profile::fromEnvironment();
+    m_logEntryModel = new LogEntryModel(this);
+    m_appUsageModel = new UsageModel(UsageModel::Apps, this);
+    m_domainUsageModel = new UsageModel(UsageModel::Domains, this);
+    m_taskModel = new TaskListModel(this);
     initializeDatabase();
     initializeProductivityDatabase();
+    // Koneksi GUI di atas hanya untuk migrasi dan operasi jarang; query berat,
+    // write berkala dan snapshot untuk QML berjalan di thread storage
+    m_storage = new StorageWorker(m_db.databaseName(), m_productivityDb.databaseName(), m_sqliteProfile, this);
+    m_logQueue.setStorage(m_storage);
+    m_logEntryModel->setStorage(m_storage);
+    rebuildRuleIndex();
+    connect(this, &Logger::productivityAppsChanged, this, &Logger::rebuildRuleIndex);
+    // logContent dibaca dari database, jadi baru berubah setelah buffer ditulis
+    connect(&m_logQueue, &LogWriteQueue::flushed, this, &Logger::scheduleLogContentRefresh);
+    connect(this, &Logger::currentUserIdChanged, this, &Logger::refreshLogEntries);
+    connect(this, &Logger::currentUserIdChanged, this, &Logger::scheduleLogContentRefresh);
+    connect(this, &Logger::currentUserIdChanged, this, &Logger::invalidateUsageModels);
+    // Banyak emit taskListChanged dalam satu giliran event loop cukup satu reload
+    connect(this, &Logger::taskListChanged, this, &Logger::scheduleTaskListReload);
+    connect(this, &Logger::currentUserIdChanged, this, &Logger::scheduleTaskListReload);
+    auto syncActiveTaskRow = [this]() { m_taskModel->setActiveTask(m_activeTaskId, m_isTaskPaused); };
+    connect(this, &Logger::activeTaskChanged, this, syncActiveTaskRow);
+    connect(this, &Logger::taskPausedChanged, this, syncActiveTaskRow);
     checkTaskStatusBeforeStart();
+    refreshLogEntries();
+    reloadTaskList();
+    scheduleStatsRefresh();
+    scheduleLogContentRefresh();
 
     m_productiveAppsModel = new QSqlQueryModel(this);
     m_nonProductiveAppsModel = new QSqlQueryModel(this);
@@ -64,7 +345,23 @@ Logger::Logger(QObject *parent) : QObject(parent)
     m_isTrackingActive = true;
     m_networkManager = new QNetworkAccessManager(this);
 
-    m_pingTimer.setInterval(30000); // 1 menit
+    // Semua request fire-and-forget lewat outbox persisten; sisa antrean dari
+    // sesi sebelumnya langsung dikirim ulang
+    m_outbox = new ApiOutbox(m_networkManager, this);
+    m_outbox->setDatabase(m_productivityDb);
+    m_outbox->setTokenBound("logout");
+    m_httpCache.setDatabase(m_productivityDb);
+    connect(m_outbox, &ApiOutbox::delivered, this, &Logger::handleOutboxDelivered);
+    connect(m_outbox, &ApiOutbox::rejected, this, &Logger::handleOutboxRejected);
+    // Queued: dialog modal tidak boleh berjalan di dalam handler balasan outbox
+    connect(m_outbox, &ApiOutbox::authenticationRequired, this, &Logger::showAuthTokenErrorMessage, Qt::QueuedConnection);
+    QTimer::singleShot(0, m_outbox, &ApiOutbox::dispatch);
+
+    m_taskStatusSync = new TaskStatusSync(m_networkManager, this);
+    m_taskStatusSync->setApiBaseUrl(m_apiBaseUrl);
+    connect(m_taskStatusSync, &TaskStatusSync::statusesChanged, this, &Logger::applyTaskStatuses);
+
+    m_pingTimer.setInterval(settings().pingIntervalMs); // default 30 detik
     connect(&m_pingTimer, &QTimer::timeout, this, [this]() {
         if (m_activeTaskId != -1 && !m_isTaskPaused) {
             sendPing(m_activeTaskId);
@@ -76,20 +373,47 @@ Logger::Logger(QObject *parent) : QObject(parent)
     m_workTimer.start(1000); // 1 detik
      // Update setiap detik
 
-    m_productivePingTimer.setInterval(180000); // 3 menit = 180000 ms
+    m_productivePingTimer.setInterval(settings().productivePingIntervalMs); // default 3 menit
     connect(&m_productivePingTimer, &QTimer::timeout, this, &Logger::sendProductiveTimeToAPI);
     m_productivePingTimer.start();
 
-    m_usageReportTimer.setInterval(300000); // 5 menit = 300,000 ms
+    m_usageReportTimer.setInterval(settings().usageReportIntervalMs); // default 5 menit
     connect(&m_usageReportTimer, &QTimer::timeout, this, &Logger::sendDailyUsageReport);
 
+    // Checkpoint WAL berkala agar file -wal tidak tumbuh tanpa batas
+    if (m_sqliteProfile.checkpointIntervalMs > 0) {
+        connect(&m_checkpointTimer, &QTimer::timeout, this, [this]() {
+            SqliteSetup::checkpoint(m_db);
+            SqliteSetup::checkpoint(m_productivityDb);
+        });
+        m_checkpointTimer.start(m_sqliteProfile.checkpointIntervalMs);
+    }
+
+    // DESKMON_PERF_DUMP=<file> menulis snapshot histogram secara berkala
+    m_perfDumpPath = qEnvironmentVariable("DESKMON_PERF_DUMP");
+    if (!m_perfDumpPath.isEmpty()) {
+        bool ok = false;
+        int intervalSeconds = qEnvironmentVariableIntValue("DESKMON_PERF_DUMP_INTERVAL", &ok);
+        if (!ok || intervalSeconds <= 0) {
+            intervalSeconds = kPerfDumpIntervalSeconds;
+        }
+        connect(&m_perfDumpTimer, &QTimer::timeout, this, [this]() { PerfStats::writeJson(m_perfDumpPath); });
+        m_perfDumpTimer.start(intervalSeconds * 1000);
+    }
+
 
 }
 Logger::~Logger()
 {
-    // Pastikan data terakhir disimpan sebelum aplikasi ditutup
-    saveWorkTimeData();
-    sendWorkTimeToAPI();
+    // Normalnya shutdown() sudah dipanggil dari aboutToQuit; ini hanya jaring pengaman lokal
+    if (!m_shutdownDone) {
+        m_storage->stop();
+        flushPendingLogs();
+        saveWorkTimeData();
+    }
+    m_storage->stop();
+    StatementCache::release(m_db.connectionName());
+    StatementCache::release(m_productivityDb.connectionName());
     if (m_db.isOpen()) {
         m_db.close();
     }
@@ -100,6 +424,11 @@ Logger::~Logger()
     delete m_nonProductiveAppsModel;
 }
 
+QUrl Logger::endpoint(const QString &path) const
+{
+    return QUrl(m_apiBaseUrl + '/' + path);
+}
+
 // Implementasi getter untuk properti baru
 int Logger::workTimeElapsedSeconds() const
 {
@@ -116,11 +445,12 @@ void Logger::startGlobalTimer()
 bool Logger::ensureDatabaseOpen() const
 {
     if (!m_db.isOpen()) {
+        StatementCache::release(m_db.connectionName());
         if (!m_db.open()) {
             qWarning() << "Failed to reopen activity database:" << m_db.lastError().text();
             return false;
         }
-        qDebug() << "Activity database reopened successfully";
+        qCDebug(lcDb) << "Activity database reopened successfully";
     }
     return true;
 }
@@ -128,11 +458,12 @@ bool Logger::ensureDatabaseOpen() const
 bool Logger::ensureProductivityDatabaseOpen() const
 {
     if (!m_productivityDb.isOpen()) {
+        StatementCache::release(m_productivityDb.connectionName());
         if (!m_productivityDb.open()) {
             qWarning() << "Failed to reopen productivity database:" << m_productivityDb.lastError().text();
             return false;
         }
-        qDebug() << "Productivity database reopened successfully";
+        qCDebug(lcDb) << "Productivity database reopened successfully";
     }
     return true;
 }
@@ -173,10 +504,10 @@ void Logger::refreshAll()
         return;
     }
 
-    qDebug() << "Starting system refresh for user_id:" << m_currentUserId;
+    qCDebug(lcTasks) << "Starting system refresh for user_id:" << m_currentUserId;
 
     // 1. Sinkronkan data dari server (hanya sekali untuk setiap sumber data)
-    qDebug() << "Fetching tasks and productivity apps from server...";
+    qCDebug(lcTasks) << "Fetching tasks and productivity apps from server...";
     fetchAndStoreTasks();
     fetchAndStoreProductivityApps();
 
@@ -189,14 +520,15 @@ void Logger::refreshAll()
             setActiveTask(taskId);
             m_taskStartTime = QDateTime::currentSecsSinceEpoch();
 
-            QSqlQuery timeQuery(m_productivityDb);
-            timeQuery.prepare("SELECT time_usage FROM task WHERE id = :id");
-            timeQuery.bindValue(":id", taskId);
-            if (timeQuery.exec() && timeQuery.next()) {
-                m_taskTimeOffset = timeQuery.value(0).toInt();
+            StatementCache::Query timeQuery = StatementCache::get(m_productivityDb, StatementCache::TaskTimeUsageSelect);
+            if (timeQuery.isValid()) {
+                timeQuery->bindValue(":id", taskId);
+                if (timeQuery.exec() && timeQuery->next()) {
+                    m_taskTimeOffset = timeQuery->value(0).toInt();
+                }
             }
 
-            qDebug() << "Task with status 'on-progress' activated. Task ID:" << taskId;
+            qCDebug(lcTasks) << "Task with status 'on-progress' activated. Task ID:" << taskId;
         }
     }
 
@@ -215,7 +547,7 @@ void Logger::refreshAll()
             bool newPausedState = query.value(1).toBool();
 
             if (m_activeTaskId != newActiveTaskId) {
-                qDebug() << "Active task has changed via sync. Old:" << m_activeTaskId << "New:" << newActiveTaskId;
+                qCDebug(lcTasks) << "Active task has changed via sync. Old:" << m_activeTaskId << "New:" << newActiveTaskId;
                 m_activeTaskId = newActiveTaskId;
             }
 
@@ -224,12 +556,12 @@ void Logger::refreshAll()
             if (!m_isTaskPaused) {
                 m_taskStartTime = QDateTime::currentSecsSinceEpoch();
             }
-            qDebug() << "Internal state synchronized. Active Task ID:" << m_activeTaskId << "Paused:" << m_isTaskPaused;
+            qCDebug(lcTasks) << "Internal state synchronized. Active Task ID:" << m_activeTaskId << "Paused:" << m_isTaskPaused;
 
         } else {
             // Tidak ada tugas aktif yang ditemukan, reset status internal.
             if (m_activeTaskId != -1) {
-                qDebug() << "Previously active task" << m_activeTaskId << "is no longer active after sync.";
+                qCDebug(lcTasks) << "Previously active task" << m_activeTaskId << "is no longer active after sync.";
                 m_activeTaskId = -1;
                 m_isTaskPaused = false;
                 m_taskTimeOffset = 0;
@@ -245,9 +577,8 @@ void Logger::refreshAll()
 
     // 4. Pancarkan sinyal untuk memberitahu UI agar memperbarui tampilannya.
     emit taskListChanged();
-    emit logContentChanged();
-    emit logCountChanged();
-    emit productivityStatsChanged();
+    scheduleLogContentRefresh();
+    scheduleStatsRefresh();
     emit currentAppNameChanged();
     emit currentWindowTitleChanged();
     emit globalTimeUsageChanged();
@@ -255,7 +586,7 @@ void Logger::refreshAll()
     emit taskPausedChanged();
     emit activeTaskChanged();
 
-    qDebug() << "Refresh all completed.";
+    qCDebug(lcTasks) << "Refresh all completed.";
 }
 
 
@@ -266,57 +597,93 @@ void Logger::sendLogoutToAPI()
         return;
     }
 
-    QJsonObject payload;
-
-    QEventLoop loop;
-    QNetworkRequest request(QUrl("https://deskmon.pranala-dt.co.id/api/logout"));
-    request.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
-    request.setRawHeader("Authorization", "Bearer " + m_authToken.toUtf8());
-
-    qDebug() << "Sending logout to API:" << QJsonDocument(payload).toJson();
+    ApiOutbox::Message message;
+    message.kind = "logout";
+    message.url = endpoint("logout");
+    message.body = QJsonDocument(QJsonObject()).toJson(QJsonDocument::Compact);
+    message.token = m_authToken;
+    message.userId = m_currentUserId;
 
-    QNetworkReply* reply = m_networkManager->post(request, QJsonDocument(QJsonObject()).toJson());
-    connect(reply, &QNetworkReply::finished, &loop, &QEventLoop::quit);
-    QTimer::singleShot(5000, &loop, &QEventLoop::quit); // timeout jaga-jaga
-    loop.exec();
-
-    if (reply->error() == QNetworkReply::NoError) {
-        qDebug() << "Logout success:" << reply->readAll();
-    } else {
-        qWarning() << "Logout failed:" << reply->errorString();
-    }
-    reply->deleteLater();
+    qCDebug(lcAuth) << "Queueing logout for API";
+    m_outbox->enqueue(message);
 }
 
-void Logger::logout()
+void Logger::closeSession()
 {
+    // 1. State lokal disimpan sinkron; ini murah (satu transaksi log + satu UPDATE)
+    flushPendingLogs();
     saveWorkTimeData();
-    sendWorkTimeToAPI();
-    sendLogoutToAPI();
     m_workTimer.stop();
 
-    // Stop all active tracking
+    if (m_currentUserId == -1) {
+        return;
+    }
+
+    // 2. Semua kerja jaringan hanya masuk outbox. Harus sebelum state user dibersihkan
+    //    karena payload butuh user id dan token.
     if (m_activeTaskId != -1) {
-        setActiveTask(-1); // This will stop the current task
+        setActiveTask(-1); // Simpan time_usage dan antrekan status stop
     }
+    sendWorkTimeToAPI();
+    sendDailyUsageReport();
 
-    if (m_activeTaskId != -1 && !m_isTaskPaused) {
-        QString currentTime = QDateTime::currentDateTime().toString(Qt::ISODateWithMs);
-        sendPausePlayDataToAPI(
-            m_activeTaskId,
-            m_lastPlayStartTime.toString(Qt::ISODateWithMs),
-            currentTime,
-            "pause"
-            );
-        qDebug() << "Sent pause status to server before logout. From" << m_lastPlayStartTime << "to" << currentTime;
+    // Stop all timers
+    m_taskTimer.stop();
+    m_pingTimer.stop();
+    m_usageReportTimer.stop();
+}
+
+void Logger::shutdown()
+{
+    if (m_shutdownDone) {
+        return;
     }
+    m_shutdownDone = true;
 
+    QElapsedTimer elapsed;
+    elapsed.start();
 
+    // Job storage yang sudah antre diselesaikan dulu; setelah itu write terakhir
+    // (log, work_time) berjalan sinkron di koneksi GUI agar tidak ada yang tertinggal
+    m_storage->stop();
 
+    // Token lokal sengaja tidak dihapus agar auto-login tetap berjalan saat start
+    // berikutnya, jadi logout ke server juga tidak dikirim: token itu masih dipakai
+    closeSession();
 
-    // Stop all timers
-    m_taskTimer.stop();
-    m_pingTimer.stop();
+    // Sisa waktu dipakai mengirim outbox; yang belum terkirim dikirim saat start berikutnya
+    const int remaining = m_outbox->drain(kShutdownDrainMs);
+
+    // Batch log yang gagal di worker dikembalikan ke buffer selama drain
+    flushPendingLogs();
+    qCDebug(lcApi) << "Shutdown finished in" << elapsed.elapsed() << "ms," << remaining
+             << "outbox messages left for next start";
+
+    if (!m_perfDumpPath.isEmpty()) {
+        m_perfDumpTimer.stop();
+        PerfStats::writeJson(m_perfDumpPath);
+    }
+}
+
+void Logger::logout()
+{
+    closeSession();
+
+    // Hanya logout eksplisit yang mencabut token di server; jika server sudah
+    // menolak token ini tidak ada yang perlu dicabut
+    if (m_currentUserId != -1 && !m_isTokenErrorVisible) {
+        sendLogoutToAPI();
+    }
+
+    // Hapus token tersimpan sebelum user id direset, agar UPDATE mengenai baris yang benar
+    if (m_currentUserId != -1) {
+        QSqlQuery clearTokenQuery(m_db);
+        clearTokenQuery.prepare("UPDATE users SET token = '' WHERE id = :id");
+        clearTokenQuery.bindValue(":id", m_currentUserId);
+        if (!clearTokenQuery.exec()) {
+            qWarning() << "Failed to clear stored token:" << clearTokenQuery.lastError().text();
+        }
+    }
 
     // Reset tracking state
     m_isTrackingActive = false;
@@ -332,15 +699,7 @@ void Logger::logout()
     m_currentUserEmail.clear();
     m_userEmail.clear();
     m_authToken.clear();
-    QSqlQuery clearTokenQuery(m_db);
-    clearTokenQuery.prepare("UPDATE users SET token = '' WHERE id = :id");
-    clearTokenQuery.bindValue(":id", m_currentUserId);
-    clearTokenQuery.exec();
-
-    m_usageReportTimer.stop();
-    qDebug() << "Daily usage report timer stopped.";
-    sendDailyUsageReport();
-
+    m_taskStatusSync->clear();
 
     // Emit signals to update UI
     emit activeTaskChanged();
@@ -352,9 +711,7 @@ void Logger::logout()
     emit userEmailChanged();
     emit taskListChanged();
 
-
-
-    qDebug() << "User logged out, all tracking stopped";
+    qCDebug(lcAuth) << "User logged out, all tracking stopped";
 }
 
 bool Logger::validateFilePath(const QString &filePath)
@@ -382,12 +739,13 @@ bool Logger::validateFilePath(const QString &filePath)
         return false;
     }
 
-    qDebug() << "File validated successfully:" << localPath;
+    qCDebug(lcUi) << "File validated successfully:" << localPath;
     return true;
 }
 
 void Logger::initializeDatabase()
 {
+    StatementCache::release("activity_db"); // nama koneksi bisa dipakai ulang oleh Logger baru
     m_db = QSqlDatabase::addDatabase("QSQLITE", "activity_db");
     m_db.setDatabaseName("activity_logs.db");
 
@@ -395,38 +753,13 @@ void Logger::initializeDatabase()
         qWarning() << "Failed to open activity database:" << m_db.lastError().text();
         return;
     }
-
-    QSqlQuery query(m_db);
-    // Dalam fungsi initializeDatabase()
-    if (!query.exec("CREATE TABLE IF NOT EXISTS log ("
-                    "id INTEGER PRIMARY KEY AUTOINCREMENT, "
-                    "id_user INTEGER NOT NULL, "
-                    "start_time INTEGER NOT NULL, "
-                    "end_time INTEGER NOT NULL, "
-                    "app_name TEXT, "
-                    "title TEXT, "
-                    "url TEXT, "  // Tambahkan kolom baru untuk URL
-                    "FOREIGN KEY(id_user) REFERENCES users(id) ON DELETE CASCADE)")) {
-        qWarning() << "Failed to create log table:" << query.lastError().text();
-    }
-
-    // Dalam fungsi initializeDatabase()
-    if (!query.exec("CREATE TABLE IF NOT EXISTS users ("
-                    "id INTEGER PRIMARY KEY AUTOINCREMENT, "
-                    "username TEXT UNIQUE NOT NULL, "
-                    "password TEXT NOT NULL, "
-                    "department TEXT, "
-                    "profile_image TEXT, "
-                    "email TEXT, "
-                    "role TEXT, "
-                    "token TEXT)")) {  // <-- Tambah kolom token
-        qWarning() << "Failed to create users table:" << query.lastError().text();
-    }
-    emit logCountChanged();
+    SqliteSetup::applyProfile(m_db, m_sqliteProfile);
+    SqliteSetup::migrate(m_db, activityMigrations());
 }
 
 void Logger::initializeProductivityDatabase()
 {
+    StatementCache::release("productivity_db");
     m_productivityDb = QSqlDatabase::addDatabase("QSQLITE", "productivity_db");
     m_productivityDb.setDatabaseName("produktif_app_db.db");
 
@@ -434,68 +767,8 @@ void Logger::initializeProductivityDatabase()
         qWarning() << "Failed to open productivity database:" << m_productivityDb.lastError().text();
         return;
     }
-
-    migrateProductivityDatabase();
-
-    QSqlQuery query(m_productivityDb);
-    if (!query.exec("CREATE TABLE IF NOT EXISTS aplikasi ("
-                    "id INTEGER PRIMARY KEY AUTOINCREMENT, "
-                    "aplikasi TEXT NOT NULL, "
-                    "window_title TEXT, "
-                    "url TEXT, "  // Kolom baru untuk URL/domain
-                    "jenis INTEGER NOT NULL, "
-                    "productivity INTEGER NOT NULL DEFAULT 0, "
-                    "for_user TEXT NOT NULL DEFAULT '0')")) {
-        qWarning() << "Failed to create aplikasi table:" << query.lastError().text();
-    }
-
-    if (!query.exec("CREATE TABLE IF NOT EXISTS task ("
-                    "id INTEGER PRIMARY KEY AUTOINCREMENT, "
-                    "project_name TEXT NOT NULL, "
-                    "task TEXT, "
-                    "max_time INTEGER NOT NULL, "
-                    "time_usage INTEGER NOT NULL, "
-                    "active BOOLEAN NOT NULL, "
-                    "status TEXT NOT NULL, "
-                    "paused BOOLEAN NOT NULL DEFAULT 0,"
-                    "user_id INTEGER NOT NULL)")) {
-        qWarning() << "Failed to create task table:" << query.lastError().text();
-    }
-
-    if (!query.exec("CREATE TABLE IF NOT EXISTS completed_tasks ("
-                    "id INTEGER PRIMARY KEY AUTOINCREMENT, "
-                    "project_name TEXT NOT NULL, "
-                    "task TEXT NOT NULL, "
-                    "max_time INTEGER NOT NULL, "
-                    "time_usage INTEGER NOT NULL, "
-                    "completed_time INTEGER NOT NULL)"
-                    "user_id INTEGER NOT NULL)")) {
-        qWarning() << "Failed to create completed_tasks table:" << query.lastError().text();
-    }
-    // Di logger.cpp - fungsi initializeProductivityDatabase()
-    if (!query.exec("CREATE TABLE IF NOT EXISTS idle_settings ("
-                    "id INTEGER PRIMARY KEY AUTOINCREMENT, "
-                    "threshold_seconds INTEGER)")) {
-        qWarning() << "Failed to create idle_settings table:" << query.lastError().text();
-    }
-    if (!query.exec("CREATE TABLE IF NOT EXISTS log_paused ("
-                    "id INTEGER PRIMARY KEY AUTOINCREMENT, "
-                    "task_id INTEGER NOT NULL, "
-                    "start_reality TEXT NOT NULL, "  // ISO 8601 format: 'YYYY-MM-DDTHH:MM:SS.SSSSSSZ'
-                    "end_reality TEXT, "
-                    "current_status TEXT NOT NULL, "  // 'pause' or 'play'
-                    "FOREIGN KEY(task_id) REFERENCES task(id))")) {
-        qWarning() << "Failed to create log_paused table:" << query.lastError().text();
-    }
-    // Buat tabel baru untuk "Time at Work"
-    if (!query.exec("CREATE TABLE IF NOT EXISTS work_time ("
-                    "id INTEGER PRIMARY KEY AUTOINCREMENT, "
-                    "user_id INTEGER NOT NULL, "
-                    "date TEXT NOT NULL, "
-                    "elapsed_seconds INTEGER NOT NULL DEFAULT 0, "
-                    "UNIQUE(user_id, date))")) {
-        qWarning() << "Failed to create work_time table:" << query.lastError().text();
-    }
+    SqliteSetup::applyProfile(m_productivityDb, m_sqliteProfile);
+    SqliteSetup::migrate(m_productivityDb, productivityMigrations());
 }
 
 
@@ -505,22 +778,25 @@ void Logger::checkAndCreateNewDayRecord()
 
     QString today = QDate::currentDate().toString("yyyy-MM-dd");
 
-    QSqlQuery query(m_productivityDb);
     // Cek apakah ada record untuk hari ini
-    query.prepare("SELECT elapsed_seconds FROM work_time WHERE user_id = :user_id AND date = :date");
-    query.bindValue(":user_id", m_currentUserId);
-    query.bindValue(":date", today);
-
-    if (query.exec() && query.next()) {
-        // Record untuk hari ini sudah ada, tidak perlu melakukan apa-apa
-        return;
-    } else {
-        // Tidak ada record untuk hari ini, buat record baru dengan waktu 0
-        m_workTimeElapsedSeconds = 0;
-        emit workTimeElapsedSecondsChanged();
-        saveWorkTimeData(); // Simpan nilai awal 0
-        qDebug() << "New day detected. Work time reset for user:" << m_currentUserId;
+    {
+        StatementCache::Query query = StatementCache::get(m_productivityDb, StatementCache::WorkTimeSelect);
+        if (!query.isValid()) {
+            return;
+        }
+        query->bindValue(":user_id", m_currentUserId);
+        query->bindValue(":date", today);
+        if (query.exec() && query->next()) {
+            // Record untuk hari ini sudah ada, tidak perlu melakukan apa-apa
+            return;
+        }
     }
+
+    // Tidak ada record untuk hari ini, buat record baru dengan waktu 0
+    m_workTimeElapsedSeconds = 0;
+    emit workTimeElapsedSecondsChanged();
+    saveWorkTimeData(); // Simpan nilai awal 0
+    qCDebug(lcStats) << "New day detected. Work time reset for user:" << m_currentUserId;
 }
 
 void Logger::loadWorkTimeData()
@@ -532,39 +808,42 @@ void Logger::loadWorkTimeData()
     }
 
     QString today = QDate::currentDate().toString("yyyy-MM-dd");
-    QSqlQuery query(m_productivityDb);
-    query.prepare("SELECT elapsed_seconds FROM work_time WHERE user_id = :user_id AND date = :date");
-    query.bindValue(":user_id", m_currentUserId);
-    query.bindValue(":date", today);
+    StatementCache::Query query = StatementCache::get(m_productivityDb, StatementCache::WorkTimeSelect);
+    if (query.isValid()) {
+        query->bindValue(":user_id", m_currentUserId);
+        query->bindValue(":date", today);
+    }
 
-    if (query.exec() && query.next()) {
-        m_workTimeElapsedSeconds = query.value(0).toInt();
+    if (query.isValid() && query.exec() && query->next()) {
+        m_workTimeElapsedSeconds = query->value(0).toInt();
     } else {
         // Tidak ada record untuk hari ini, berarti waktu kerja adalah 0
         m_workTimeElapsedSeconds = 0;
         // Buat record untuk hari baru
         saveWorkTimeData();
     }
-    qDebug() << "Loaded work time for" << today << ":" << m_workTimeElapsedSeconds << "seconds";
+    qCDebug(lcStats) << "Loaded work time for" << today << ":" << m_workTimeElapsedSeconds << "seconds";
     emit workTimeElapsedSecondsChanged();
 }
 
 void Logger::saveWorkTimeData()
 {
-    if (m_currentUserId == -1 || !ensureProductivityDatabaseOpen()) return;
-
-    QString today = QDate::currentDate().toString("yyyy-MM-dd");
-    QSqlQuery query(m_productivityDb);
-    // Gunakan INSERT OR REPLACE untuk menyederhanakan (membuat baru atau memperbarui yang sudah ada)
-    query.prepare("INSERT OR REPLACE INTO work_time (user_id, date, elapsed_seconds) "
-                  "VALUES (:user_id, :date, :seconds)");
-    query.bindValue(":user_id", m_currentUserId);
-    query.bindValue(":date", today);
-    query.bindValue(":seconds", m_workTimeElapsedSeconds);
-
-    if (!query.exec()) {
-        qWarning() << "Failed to save work time:" << query.lastError().text();
+    if (m_currentUserId == -1) return;
+
+    // Dipanggil dari timer 1 detik; write dilakukan thread storage
+    const int userId = m_currentUserId;
+    const QString today = QDate::currentDate().toString("yyyy-MM-dd");
+    const int seconds = m_workTimeElapsedSeconds;
+    if (m_storage->isStopped()) {
+        // Shutdown: write terakhir langsung di koneksi GUI
+        if (ensureProductivityDatabaseOpen()) {
+            writeWorkTime(m_productivityDb, userId, today, seconds);
+        }
+        return;
     }
+    m_storage->run(StorageWorker::Productivity, [userId, today, seconds](QSqlDatabase &db) {
+        writeWorkTime(db, userId, today, seconds);
+    });
 }
 
 void Logger::sendWorkTimeToAPI()
@@ -579,31 +858,17 @@ void Logger::sendWorkTimeToAPI()
     payload["user_id"] = m_currentUserId;
     payload["time_at_work"] = m_workTimeElapsedSeconds;
 
-    // Configure request
-    QNetworkRequest request(QUrl("https://deskmon.pranala-dt.co.id/api/send-time-at-work"));
-    request.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
-    request.setRawHeader("Authorization", "Bearer " + m_authToken.toUtf8());
-
-    qDebug() << "Sending work time to API:" << QJsonDocument(payload).toJson();
-
-    // Send POST request
-    QNetworkReply* reply = m_networkManager->post(request, QJsonDocument(payload).toJson());
-
-    // Handle timeout (10 seconds)
-    QTimer::singleShot(10000, reply, &QNetworkReply::abort);
-
-    // Handle response
-    connect(reply, &QNetworkReply::finished, [this, reply]() {
-        if (reply->error() == QNetworkReply::NoError) {
-            QByteArray response = reply->readAll();
-            qDebug() << "Work time successfully sent to API. Response:" << response;
-        } else {
-            qWarning() << "Failed to send work time to API:" << reply->errorString();
-            qDebug() << "HTTP Status:" << reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
-            qDebug() << "Response Body:" << reply->readAll();
-        }
-        reply->deleteLater();
-    });
+    qCDebug(lcApi) << "Queueing work time for API:" << QJsonDocument(payload).toJson(QJsonDocument::Compact);
+
+    // Nilai kumulatif: hanya nilai terbaru per user per hari yang perlu dikirim
+    ApiOutbox::Message message;
+    message.kind = "send-time-at-work";
+    message.url = endpoint("send-time-at-work");
+    message.body = QJsonDocument(payload).toJson(QJsonDocument::Compact);
+    message.token = m_authToken;
+    message.userId = m_currentUserId;
+    message.coalesceKey = QString("time_at_work:%1:%2").arg(m_currentUserId).arg(QDate::currentDate().toString(Qt::ISODate));
+    m_outbox->enqueue(message);
 }
 
 void Logger::updateWorkTimeAndSave() {
@@ -617,382 +882,137 @@ void Logger::updateWorkTimeAndSave() {
     }
 }
 
-// Updated getAppProductivityType function
-int Logger::getAppProductivityType(const QString &appName, const QString &url) const
+void Logger::rebuildRuleIndex()
 {
-    if (!ensureProductivityDatabaseOpen() || m_currentUserId == -1) {
-        return 0;
+    if (!ensureProductivityDatabaseOpen()) {
+        m_ruleIndex.clear();
+        return;
     }
-
-    // Helper function untuk normalisasi string
-    auto normalizeString = [](const QString &str) {
-        return str.toLower()
-        .remove(' ')
-            .remove('-')
-            .remove('_')
-            .remove('.');
-    };
-
-    // Helper function untuk cek user permission
-    auto checkUserPermission = [this](const QString &forUsers) -> bool {
-        if (forUsers == "0") {
-            return true; // Global untuk semua user
-        }
-
-        QString currentUserStr = QString::number(m_currentUserId);
-        QStringList userList = forUsers.split(',', Qt::SkipEmptyParts);
-
-        for (const QString &userId : userList) {
-            if (userId.trimmed() == currentUserStr) {
-                return true;
-            }
+    m_ruleIndex.rebuild(m_productivityDb);
+    QVector<QPair<int, QDate>> changedDays = m_rollup.reclassify(m_ruleIndex);
+    // Rollup yang sedang dimuat langsung memakai aturan baru, jadi perubahan
+    // statusnya tidak terlihat oleh reclassify()
+    if (m_rollupLoading && m_currentUserId != -1) {
+        changedDays.append(qMakePair(m_currentUserId, QDate::currentDate()));
+    }
+
+    // Penanda disimpan agar laporan ulang tetap terkirim walau aplikasi ditutup
+    // sebelum server mengonfirmasi; ack lebih lama dari 7 hari sudah dibuang
+    const qint64 now = QDateTime::currentSecsSinceEpoch();
+    const QDate oldest = QDate::currentDate().addDays(-7);
+    for (const auto &day : std::as_const(changedDays)) {
+        if (day.second >= oldest) {
+            m_usageReport.markReclassified(m_productivityDb, day.first, day.second, now);
         }
+    }
+    invalidateUsageModels();
+}
 
+// Tidak pernah memblokir: jika rollup belum ada, pemuatan dimulai di thread
+// storage dan snapshot statistik diperbarui setelah selesai
+bool Logger::ensureRollupLoaded()
+{
+    if (m_currentUserId == -1) {
         return false;
-    };
-    auto extractDomain = [](const QString &url) -> QString {
-        if (url.isEmpty()) return "";
-
-        QUrl qurl(url);
-        QString domain = qurl.host();
-
-        // Jika QUrl gagal parse, coba ekstrak manual
-        if (domain.isEmpty()) {
-            QRegularExpression domainRegex(R"((?:https?://)?(?:www\.)?([^/]+))");
-            QRegularExpressionMatch match = domainRegex.match(url);
-            if (match.hasMatch()) {
-                domain = match.captured(1);
-            }
-        }
-
-        // Hapus www. prefix
-        if (domain.startsWith("www.")) {
-            domain = domain.mid(4);
-        }
-
-        return domain.toLower();
-    };
-
-    // Cek apakah ini aplikasi browser atau non-browser
-    bool isBrowserApp = !url.isEmpty();
-
-    if (isBrowserApp) {
-        // BROWSER APPLICATION: Gunakan domain matching
-        QString domain = extractDomain(url);
-        if (domain.isEmpty()) {
-            return 0; // Tidak bisa ekstrak domain
-        }
-
-        QSqlQuery query(m_productivityDb);
-        query.prepare(R"(
-            SELECT url, jenis, for_user
-            FROM aplikasi
-            WHERE url IS NOT NULL
-            AND url != ''
-        )");
-        query.bindValue(":userPattern", "%," + QString::number(m_currentUserId) + ",%");
-
-        if (query.exec()) {
-            while (query.next()) {
-                QString dbUrl = query.value(0).toString();
-                int jenis = query.value(1).toInt();
-                QString forUsers = query.value(2).toString();
-
-                // Check user permission
-                if (!checkUserPermission(forUsers)) {
-                    continue;
-                }
-
-                QString dbDomain = extractDomain(dbUrl);
-                if (dbDomain.isEmpty()) continue;
-
-                // Exact domain match
-                if (domain == dbDomain) {
-                    return jenis;
-                }
+    }
+    if (m_rollup.isLoaded(m_currentUserId)) {
+        return true;
+    }
+    loadRollupAsync();
+    return false;
+}
 
-                // Check if domain contains subdomain match
-                if (domain.endsWith("." + dbDomain) || dbDomain.endsWith("." + domain)) {
-                    return jenis;
-                }
+void Logger::loadRollupAsync()
+{
+    if (m_rollupLoading || m_currentUserId == -1) {
+        return;
+    }
+    m_rollupLoading = true;
+    m_rollupBacklog.clear();
+
+    // Segmen yang masih di buffer harus tertulis sebelum scan; job storage berjalan FIFO.
+    // Segmen yang ditutup setelah titik ini masuk backlog dan diterapkan setelah assign().
+    m_logQueue.flush();
+    const int userId = m_currentUserId;
+    m_storage->run(StorageWorker::Activity, [userId](QSqlDatabase &db) {
+        QVector<ActivityRollup::Row> rows;
+        const bool ok = ActivityRollup::fetch(userId, db, rows);
+        return qMakePair(ok, rows);
+    }).then(this, [this, userId](const QPair<bool, QVector<ActivityRollup::Row>> &result) {
+        m_rollupLoading = false;
+        const QVector<LogWriteQueue::Segment> backlog = std::exchange(m_rollupBacklog, {});
+        if (result.first && userId == m_currentUserId) {
+            m_rollup.assign(userId, result.second, m_ruleIndex);
+            for (const LogWriteQueue::Segment &segment : backlog) {
+                m_rollup.addSegment(userId, segment.startTime, segment.endTime,
+                                    segment.appName, segment.url, m_ruleIndex);
             }
         }
-    } else {
-        // NON-BROWSER APPLICATION: Gunakan app name matching
-        QString normApp = normalizeString(appName);
-
-        QSqlQuery query(m_productivityDb);
-        query.prepare(R"(
-            SELECT aplikasi, jenis, for_user
-            FROM aplikasi
-            WHERE (url IS NULL OR url = '')
-            AND aplikasi IS NOT NULL
-            AND aplikasi != ''
-        )");
-        query.bindValue(":userPattern", "%," + QString::number(m_currentUserId) + ",%");
-
-        if (query.exec()) {
-            while (query.next()) {
-                QString dbApp = query.value(0).toString();
-                int jenis = query.value(1).toInt();
-                QString forUsers = query.value(2).toString();
-
-                // Check user permission
-                if (!checkUserPermission(forUsers)) {
-                    continue;
-                }
-
-                QString normDbApp = normalizeString(dbApp);
-
-                // Exact match
-                if (normApp == normDbApp) {
-                    return jenis;
-                }
-
-                // Contains match (kedua arah)
-                if (normApp.contains(normDbApp) || normDbApp.contains(normApp)) {
-                    return jenis;
-                }
-            }
+        // User bisa berganti selama pemuatan; refresh akan memuat rollup user yang baru
+        if (result.first || userId != m_currentUserId) {
+            invalidateUsageModels();
         }
+    });
+}
+
+// Klasifikasi memakai RuleIndex di memori, tanpa query SQL per panggilan
+int Logger::getAppProductivityType(const QString &appName, const QString &url) const
+{
+    if (m_currentUserId == -1) {
+        return 0;
     }
 
-    return 0; // Default neutral
+    return m_ruleIndex.classify(m_currentUserId, appName, url);
 }
 
 // Updated calculateTodayProductiveSeconds function
 int Logger::calculateTodayProductiveSeconds() const
 {
-    if (!ensureDatabaseOpen() || m_currentUserId == -1) {
+    if (m_currentUserId == -1 || !m_rollup.isLoaded(m_currentUserId)) {
         return 0;
     }
 
-    QString today = QDate::currentDate().toString("yyyy-MM-dd");
-    int totalProductiveSeconds = 0;
-
-    // Helper function untuk cek user permission
-    auto checkUserPermission = [this](const QString &forUsers) -> bool {
-        if (forUsers == "0") {
-            return true; // Global untuk semua user
-        }
-
-        QString currentUserStr = QString::number(m_currentUserId);
-        QStringList userList = forUsers.split(',', Qt::SkipEmptyParts);
-
-        for (const QString &userId : userList) {
-            if (userId.trimmed() == currentUserStr) {
-                return true;
-            }
-        }
-
-        return false;
-    };
-    auto extractDomain = [](const QString &url) -> QString {
-        if (url.isEmpty()) return QString();
-
-        QUrl qurl(url);
-        QString host = qurl.host();
-
-        if (host.isEmpty()) {
-            QRegularExpression domainRegex(R"((?:https?://)?(?:www\.)?([^/]+))");
-            QRegularExpressionMatch match = domainRegex.match(url);
-            if (match.hasMatch()) {
-                host = match.captured(1);
-            }
-        }
-
-        if (host.startsWith("www.")) {
-            host = host.mid(4);
-        }
-
-        return host.toLower();
-    };
-
-    // Helper function untuk normalisasi string
-    auto normalizeString = [](const QString &str) {
-        return str.toLower()
-        .remove(' ')
-            .remove('-')
-            .remove('_')
-            .remove('.');
-    };
-
-    // 1. Load productivity rules from database
-    QHash<QString, int> productiveApps;     // Non-browser apps
-    QHash<QString, int> productiveDomains;  // Browser domains
-
-    if (ensureProductivityDatabaseOpen()) {
-        QSqlQuery query(m_productivityDb);
-        query.prepare(R"(
-            SELECT aplikasi, url, jenis, for_user
-            FROM aplikasi
-            WHERE jenis IN (1, 2)
-        )");
-        query.bindValue(":userPattern", "%," + QString::number(m_currentUserId) + ",%");
-
-        if (query.exec()) {
-            while (query.next()) {
-                QString appName = query.value(0).toString();
-                QString url = query.value(1).toString();
-                int type = query.value(2).toInt();
-                QString forUsers = query.value(3).toString();
-
-                // Check user permission
-                if (!checkUserPermission(forUsers)) {
-                    continue;
-                }
-
-                if (!url.isEmpty()) {
-                    // Browser app rule - store by domain
-                    QString domain = extractDomain(url);
-                    if (!domain.isEmpty()) {
-                        productiveDomains[domain] = type;
-                    }
-                } else if (!appName.isEmpty()) {
-                    // Non-browser app rule
-                    productiveApps[appName] = type;
-                }
-            }
-        }
+    // Dibaca dari agregat hari ini, tidak lagi scan tabel log
+    const ActivityRollup::Day *today = m_rollup.day(m_currentUserId, QDate::currentDate());
+    if (!today) {
+        return 0;
     }
 
-    // 2. Process today's activity logs
-    QSqlQuery logQuery(m_db);
-    logQuery.prepare(R"(
-        SELECT start_time, end_time, app_name, title, url
-        FROM log
-        WHERE id_user = :user_id
-        AND date(start_time, 'unixepoch', 'localtime') = :today
-        ORDER BY start_time ASC
-    )");
-    logQuery.bindValue(":user_id", m_currentUserId);
-    logQuery.bindValue(":today", today);
-
-    if (logQuery.exec()) {
-        QHash<QString, int> appProductivityTime;
-        QHash<QString, int> domainProductivityTime;
-        QHash<QString, int> matchStats;
-
-        while (logQuery.next()) {
-            qint64 start = logQuery.value(0).toLongLong();
-            qint64 end = logQuery.value(1).toLongLong();
-            QString appName = logQuery.value(2).toString();
-            QString title = logQuery.value(3).toString();
-            QString url = logQuery.value(4).toString();
-
-            int duration = end - start;
-            if (duration <= 0) continue;
-
-            int productivityType = 0;
-            QString matchMethod = "none";
-            QString matchedItem = "";
-
-            bool isBrowserApp = !url.isEmpty();
-
-            if (isBrowserApp) {
-                // Browser application - check domain
-                QString domain = extractDomain(url);
-                if (!domain.isEmpty()) {
-                    // Direct domain match
-                    if (productiveDomains.contains(domain)) {
-                        productivityType = productiveDomains[domain];
-                        matchMethod = "domain_exact";
-                        matchedItem = domain;
-                    } else {
-                        // Check for subdomain matches
-                        for (auto it = productiveDomains.begin(); it != productiveDomains.end(); ++it) {
-                            const QString &ruleDomain = it.key();
-                            if (domain.endsWith("." + ruleDomain) || ruleDomain.endsWith("." + domain)) {
-                                productivityType = it.value();
-                                matchMethod = "domain_subdomain";
-                                matchedItem = ruleDomain;
-                                break;
-                            }
-                        }
-                    }
-                }
-            } else {
-                // Non-browser application - check app name
-                QString normApp = normalizeString(appName);
-
-                // Direct app match
-                for (auto it = productiveApps.begin(); it != productiveApps.end(); ++it) {
-                    const QString &ruleApp = it.key();
-                    QString normRuleApp = normalizeString(ruleApp);
-
-                    if (normApp == normRuleApp) {
-                        productivityType = it.value();
-                        matchMethod = "app_exact";
-                        matchedItem = ruleApp;
-                        break;
-                    } else if (normApp.contains(normRuleApp) || normRuleApp.contains(normApp)) {
-                        productivityType = it.value();
-                        matchMethod = "app_contains";
-                        matchedItem = ruleApp;
-                        break;
-                    }
-                }
-            }
-
-            bool isProductive = (productivityType == 1);
-
-            if (isProductive) {
-                totalProductiveSeconds += duration;
-
-                if (isBrowserApp) {
-                    QString domain = extractDomain(url);
-                    if (!domain.isEmpty()) {
-                        domainProductivityTime[domain] += duration;
-                    }
-                } else {
-                    appProductivityTime[appName] += duration;
-                }
-
-                matchStats[matchMethod] += duration;
-            }
-        }
+    int totalProductiveSeconds = today->categorySeconds[ActivityRollup::Productive];
+    if (!lcStats().isDebugEnabled()) {
+        return totalProductiveSeconds; // Rincian di bawah hanya untuk debug
+    }
 
-        // 3. Debug output
-        qDebug() << "==== Updated Productivity Breakdown ====";
-        qDebug() << "Total Productive Time:" << formatDuration(totalProductiveSeconds);
-
-        qDebug() << "\nMatching Method Statistics:";
-        for (auto it = matchStats.begin(); it != matchStats.end(); ++it) {
-            if (totalProductiveSeconds > 0) {
-                double percentage = (double)it.value() / totalProductiveSeconds * 100;
-                qDebug() << QString("%1: %2 (%3%)")
-                                .arg(it.key(), -20)
-                                .arg(formatDuration(it.value()))
-                                .arg(percentage, 0, 'f', 1);
-            }
+    // Debug output
+    qCDebug(lcStats) << "==== Updated Productivity Breakdown ====";
+    qCDebug(lcStats) << "Total Productive Time:" << formatDuration(totalProductiveSeconds);
+
+    QList<QPair<qint64, QString>> sortedDomains;
+    QList<QPair<qint64, QString>> sortedApps;
+    for (auto it = today->entries.constBegin(); it != today->entries.constEnd(); ++it) {
+        const ActivityRollup::Entry &entry = it.value();
+        if (entry.category != ActivityRollup::Productive || entry.seconds <= 0) {
+            continue;
         }
-
-        qDebug() << "\nTop Productive Domains (Browser Apps):";
-        QList<QPair<int, QString>> sortedDomains;
-        for (auto it = domainProductivityTime.begin(); it != domainProductivityTime.end(); ++it) {
-            if (it.value() > 0) {
-                sortedDomains.append(qMakePair(it.value(), it.key()));
+        if (entry.browser) {
+            if (!entry.domain.isEmpty()) {
+                sortedDomains.append(qMakePair(entry.seconds, entry.domain));
             }
+        } else {
+            sortedApps.append(qMakePair(entry.seconds, entry.appName));
         }
-        std::sort(sortedDomains.begin(), sortedDomains.end(), std::greater<QPair<int, QString>>());
-        for (const auto &pair : sortedDomains.mid(0, 10)) {
-            qDebug() << QString("%1: %2").arg(pair.second, -30).arg(formatDuration(pair.first));
-        }
+    }
 
-        qDebug() << "\nTop Productive Apps (Non-Browser):";
-        QList<QPair<int, QString>> sortedApps;
-        for (auto it = appProductivityTime.begin(); it != appProductivityTime.end(); ++it) {
-            if (it.value() > 0) {
-                sortedApps.append(qMakePair(it.value(), it.key()));
-            }
-        }
-        std::sort(sortedApps.begin(), sortedApps.end(), std::greater<QPair<int, QString>>());
-        for (const auto &pair : sortedApps.mid(0, 10)) {
-            qDebug() << QString("%1: %2").arg(pair.second, -30).arg(formatDuration(pair.first));
-        }
+    qCDebug(lcStats) << "\nTop Productive Domains (Browser Apps):";
+    std::sort(sortedDomains.begin(), sortedDomains.end(), std::greater<QPair<qint64, QString>>());
+    for (const auto &pair : sortedDomains.mid(0, 10)) {
+        qCDebug(lcStats) << QString("%1: %2").arg(pair.second, -30).arg(formatDuration(pair.first));
+    }
 
-    } else {
-        qWarning() << "Failed to fetch today's logs:" << logQuery.lastError().text();
+    qCDebug(lcStats) << "\nTop Productive Apps (Non-Browser):";
+    std::sort(sortedApps.begin(), sortedApps.end(), std::greater<QPair<qint64, QString>>());
+    for (const auto &pair : sortedApps.mid(0, 10)) {
+        qCDebug(lcStats) << QString("%1: %2").arg(pair.second, -30).arg(formatDuration(pair.first));
     }
 
     return totalProductiveSeconds;
@@ -1001,67 +1021,84 @@ int Logger::calculateTodayProductiveSeconds() const
 // Updated productivityStats function
 QVariantMap Logger::productivityStats() const
 {
-    if (!ensureDatabaseOpen() || !ensureProductivityDatabaseOpen()) {
-        qWarning() << "Cannot compute productivity stats: Database is not open";
-        return QVariantMap();
-    }
-    if (m_currentUserId == -1) {
-        qWarning() << "Cannot compute productivity stats: No user logged in";
-        return QVariantMap();
+    ScopedPerfTimer perf("qml.productivityStats");
+    return m_statsSnapshot;
+}
+
+void Logger::scheduleStatsRefresh()
+{
+    // Banyak perubahan (segmen, filter, reklasifikasi) dalam satu giliran cukup satu hitung ulang
+    if (m_statsRefreshPending) {
+        return;
     }
+    m_statsRefreshPending = true;
+    QTimer::singleShot(0, this, &Logger::refreshStatsSnapshot);
+}
 
-    QVariantMap stats;
-    double productiveTime = 0;
-    double nonProductiveTime = 0;
-    double neutralTime = 0;
-    double totalTime = 0;
+void Logger::refreshStatsSnapshot()
+{
+    m_statsRefreshPending = false;
 
-    QString queryStr = "SELECT start_time, end_time, app_name, title, url FROM log "
-                       "WHERE app_name IS NOT NULL AND id_user = :id_user ";
+    QVariantMap stats;
+    int count = 0;
+    if (ensureRollupLoaded()) {
+        const QDate from = QDate::fromString(m_startDateFilter, Qt::ISODate);
+        const QDate to = QDate::fromString(m_endDateFilter, Qt::ISODate);
+        stats = computeProductivityStats();
+        count = m_rollup.segmentCount(m_currentUserId, from, to);
+        if (m_usageModelsDirty) {
+            m_usageModelsDirty = false;
+            m_appUsageModel->rebuild(m_rollup, m_currentUserId, from, to, m_ruleIndex);
+            m_domainUsageModel->rebuild(m_rollup, m_currentUserId, from, to, m_ruleIndex);
+        }
+    } else if (m_currentUserId == -1) {
+        m_appUsageModel->clear();
+        m_domainUsageModel->clear();
+    }
 
-    if (!m_startDateFilter.isEmpty()) {
-        queryStr += QString("AND date(start_time, 'unixepoch', 'localtime') >= date('%1') ")
-        .arg(m_startDateFilter);
+    if (stats != m_statsSnapshot) {
+        m_statsSnapshot = stats;
+        emit productivityStatsChanged();
     }
-    if (!m_endDateFilter.isEmpty()) {
-        queryStr += QString("AND date(start_time, 'unixepoch', 'localtime') <= date('%1') ")
-        .arg(m_endDateFilter);
+    if (count != m_logCountSnapshot) {
+        m_logCountSnapshot = count;
+        emit logCountChanged();
     }
+}
 
-    QSqlQuery query(m_db);
-    query.prepare(queryStr);
-    query.bindValue(":id_user", m_currentUserId);
+void Logger::invalidateUsageModels()
+{
+    m_usageModelsDirty = true;
+    scheduleStatsRefresh();
+}
 
-    if (!query.exec()) {
-        qWarning() << "Failed to fetch logs for productivity stats:" << query.lastError().text();
-        return stats;
+// Model durasi diperbarui per segmen; hanya filter, user atau aturan yang memicu rebuild
+void Logger::addSegmentToUsageModels(qint64 startTime, qint64 endTime, const QString &appName, const QString &url)
+{
+    if (m_usageModelsDirty || m_rollupLoading || !m_rollup.isLoaded(m_currentUserId)) {
+        return;
     }
 
-    while (query.next()) {
-        qint64 start = query.value(0).toLongLong();
-        qint64 end = query.value(1).toLongLong();
-        QString appName = query.value(2).toString();
-        QString url = query.value(4).toString();
-
-        double duration = end - start;
-        if (duration <= 0) continue;
-
-        // Use updated function that focuses on app vs domain
-        int type = getAppProductivityType(appName, url);
-
-        switch (type) {
-        case 1:
-            productiveTime += duration;
-            break;
-        case 2:
-            nonProductiveTime += duration;
-            break;
-        default:
-            neutralTime += duration;
-            break;
-        }
-        totalTime += duration;
+    const QDate date = QDateTime::fromSecsSinceEpoch(startTime).date();
+    const qint64 seconds = endTime - startTime;
+    m_appUsageModel->addSegment(m_currentUserId, date, appName, QString(), seconds, m_ruleIndex);
+    if (!url.isEmpty()) {
+        const QString domain = RuleIndex::hostOf(url).toString().toLower();
+        m_domainUsageModel->addSegment(m_currentUserId, date, appName, domain, seconds, m_ruleIndex);
     }
+}
+
+QVariantMap Logger::computeProductivityStats() const
+{
+    // Dibaca dari agregat berjalan, biayanya tidak bergantung pada panjang riwayat
+    QDate from = QDate::fromString(m_startDateFilter, Qt::ISODate);
+    QDate to = QDate::fromString(m_endDateFilter, Qt::ISODate);
+
+    QVariantMap stats;
+    double productiveTime = m_rollup.categorySeconds(m_currentUserId, ActivityRollup::Productive, from, to);
+    double nonProductiveTime = m_rollup.categorySeconds(m_currentUserId, ActivityRollup::NonProductive, from, to);
+    double neutralTime = m_rollup.categorySeconds(m_currentUserId, ActivityRollup::Neutral, from, to);
+    double totalTime = productiveTime + nonProductiveTime + neutralTime;
 
     double total = totalTime > 0 ? totalTime : 1;
     stats["productive"] = (productiveTime / total) * 100;
@@ -1077,30 +1114,27 @@ void Logger::sendProductiveTimeToAPI()
         qWarning() << "Cannot send productive time: Not logged in or missing token";
         return;
     }
+    // Nilai kumulatif; mengirim 0 sebelum rollup siap akan menimpa nilai di server
+    if (!ensureRollupLoaded()) {
+        qCDebug(lcApi) << "Activity rollup still loading, productive time deferred";
+        return;
+    }
 
     int productiveSeconds = calculateTodayProductiveSeconds();
-    qDebug() << "Sending productive time:" << productiveSeconds << "seconds";
+    qCDebug(lcApi) << "Sending productive time:" << productiveSeconds << "seconds";
 
     QJsonObject payload;
     payload["user_id"] = m_currentUserId;
     payload["productive_time"] = productiveSeconds;
 
-    QNetworkRequest request(QUrl("https://deskmon.pranala-dt.co.id/api/send-productive-time"));
-    request.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
-    request.setRawHeader("Authorization", "Bearer " + m_authToken.toUtf8());
-
-    QNetworkReply *reply = m_networkManager->post(request, QJsonDocument(payload).toJson());
-
-    QTimer::singleShot(10000, reply, &QNetworkReply::abort); // Timeout 10 detik
-
-    connect(reply, &QNetworkReply::finished, this, [this, reply]() {
-        if (reply->error() == QNetworkReply::NoError) {
-            qDebug() << "Productive time sent successfully. Response:" << reply->readAll();
-        } else {
-            qWarning() << "Failed to send productive time:" << reply->errorString();
-        }
-        reply->deleteLater();
-    });
+    ApiOutbox::Message message;
+    message.kind = "send-productive-time";
+    message.url = endpoint("send-productive-time");
+    message.body = QJsonDocument(payload).toJson(QJsonDocument::Compact);
+    message.token = m_authToken;
+    message.userId = m_currentUserId;
+    message.coalesceKey = QString("productive_time:%1:%2").arg(m_currentUserId).arg(QDate::currentDate().toString(Qt::ISODate));
+    m_outbox->enqueue(message);
 }
 
 
@@ -1145,15 +1179,16 @@ void Logger::checkTaskStatusBeforeStart()
 
         if (!m_isTaskPaused) {
             m_taskStartTime = QDateTime::currentSecsSinceEpoch();
-            QSqlQuery timeQuery(m_productivityDb);
-            timeQuery.prepare("SELECT time_usage FROM task WHERE id = :id");
-            timeQuery.addBindValue(m_activeTaskId);
-            if (timeQuery.exec() && timeQuery.next()) {
-                m_taskTimeOffset = timeQuery.value(0).toInt();
+            StatementCache::Query timeQuery = StatementCache::get(m_productivityDb, StatementCache::TaskTimeUsageSelect);
+            if (timeQuery.isValid()) {
+                timeQuery->bindValue(":id", m_activeTaskId);
+                if (timeQuery.exec() && timeQuery->next()) {
+                    m_taskTimeOffset = timeQuery->value(0).toInt();
+                }
             }
         }
 
-        qDebug() << "Active task found. ID:" << m_activeTaskId
+        qCDebug(lcTasks) << "Active task found. ID:" << m_activeTaskId
                  << "| Paused:" << m_isTaskPaused
                  << "| Status:" << status
                  << "| Tracking:" << m_isTrackingActive;
@@ -1161,7 +1196,7 @@ void Logger::checkTaskStatusBeforeStart()
         m_activeTaskId = -1;
         m_isTaskPaused = false;
         m_isTrackingActive = true;
-        qDebug() << "No active task found for user_id:" << m_currentUserId;
+        qCDebug(lcTasks) << "No active task found for user_id:" << m_currentUserId;
     }
     // Cari user yang memiliki token login
     QSqlQuery autoLoginQuery(m_db);
@@ -1171,7 +1206,7 @@ void Logger::checkTaskStatusBeforeStart()
             m_currentUsername = autoLoginQuery.value(1).toString();
             m_currentUserEmail = autoLoginQuery.value(2).toString();
             m_authToken = autoLoginQuery.value(3).toString();
-            qDebug() << "Auto login as user ID:" << m_currentUserId << "Username:" << m_currentUsername;
+            qCDebug(lcTasks) << "Auto login as user ID:" << m_currentUserId << "Username:" << m_currentUsername;
             emit currentUserIdChanged();
             emit currentUsernameChanged();
             emit currentUserEmailChanged();
@@ -1192,24 +1227,32 @@ void Logger::checkTaskStatusBeforeStart()
 
 int Logger::getIdleThreshold() const
 {
-    if (!ensureProductivityDatabaseOpen()) {
-        qWarning() << "Cannot access productivity database, returning default idle threshold: 120 seconds";
-        return 180;
+    return settings().idleThresholdSeconds;
+}
+
+const SettingsCache::Values &Logger::settings() const
+{
+    // Hanya akses pertama (atau setelah invalidate) yang menyentuh database
+    if (!m_settings.isLoaded()) {
+        ensureProductivityDatabaseOpen();
+        m_settings.load(m_productivityDb);
+    }
+    return m_settings.values();
+}
+
+void Logger::applySettings()
+{
+    const SettingsCache::Values &values = settings();
+    if (m_pingTimer.interval() != values.pingIntervalMs) {
+        m_pingTimer.setInterval(values.pingIntervalMs);
     }
-
-    QSqlQuery query(m_productivityDb);
-    query.prepare("SELECT threshold_seconds FROM idle_settings LIMIT 1");
-    if (query.exec() && query.next()) {
-        int threshold = query.value(0).toInt();
-        if (threshold > 0) {
-            qDebug() << "Retrieved idle threshold from database:" << threshold << "seconds";
-            return threshold;
-        }
-        qWarning() << "Invalid threshold in database (null or <= 0), returning default: 180 seconds";
-        return 180;
+    if (m_productivePingTimer.interval() != values.productivePingIntervalMs) {
+        m_productivePingTimer.setInterval(values.productivePingIntervalMs);
     }
-    qWarning() << "No threshold found in database, returning default: 120 seconds";
-    return 180;
+    if (m_usageReportTimer.interval() != values.usageReportIntervalMs) {
+        m_usageReportTimer.setInterval(values.usageReportIntervalMs);
+    }
+    emit idleThresholdChanged();
 }
 
 
@@ -1256,13 +1299,8 @@ void Logger::setIdleThreshold(int seconds)
         return;
     }
 
-    QSqlQuery query(m_productivityDb);
-    query.prepare("INSERT OR REPLACE INTO idle_settings (id, threshold_seconds) VALUES (1, :threshold)");
-    query.bindValue(":threshold", seconds);
-    if (!query.exec()) {
-        qWarning() << "Failed to set idle threshold:" << query.lastError().text();
-    } else {
-        qDebug() << "Idle threshold updated to:" << seconds << "seconds";
+    if (m_settings.setIdleThreshold(m_productivityDb, seconds)) {
+        qCDebug(lcDb) << "Idle threshold updated to:" << seconds << "seconds";
         emit idleThresholdChanged();
     }
 }
@@ -1279,75 +1317,88 @@ QString Logger::currentWindowTitle() const
 
 int Logger::logCount() const
 {
-    if (!ensureDatabaseOpen()) {
-        qWarning() << "Cannot count logs: Database is not open";
-        return 0;
-    }
-    if (m_currentUserId == -1) {
-        qWarning() << "Cannot count logs: No user logged in";
-        return 0;
-    }
+    return m_logCountSnapshot;
+}
 
-    QString queryStr = "SELECT COUNT(*) FROM log WHERE app_name IS NOT NULL AND title IS NOT NULL AND id_user = :id_user";
-    if (!m_startDateFilter.isEmpty()) {
-        queryStr += QString(" AND date(start_time, 'unixepoch', 'localtime') >= date('%1')")
-        .arg(m_startDateFilter);
-    }
-    if (!m_endDateFilter.isEmpty()) {
-        queryStr += QString(" AND date(start_time, 'unixepoch', 'localtime') <= date('%1')")
-        .arg(m_endDateFilter);
+QString Logger::logContent() const
+{
+    ScopedPerfTimer perf("qml.logContent");
+    return m_logContentSnapshot;
+}
+
+void Logger::scheduleLogContentRefresh()
+{
+    if (m_logContentRefreshPending) {
+        return;
     }
+    m_logContentRefreshPending = true;
+    QTimer::singleShot(0, this, &Logger::refreshLogContent);
+}
 
-    QSqlQuery query(m_db);
-    query.prepare(queryStr);
-    query.bindValue(":id_user", m_currentUserId);
-    if (!query.exec()) {
-        qWarning() << "Failed to count logs:" << query.lastError().text();
-        return 0;
+void Logger::refreshLogContent()
+{
+    m_logContentRefreshPending = false;
+    if (m_logContentLoading) {
+        m_logContentDirty = true; // Diulang setelah query yang sedang berjalan selesai
+        return;
     }
-    if (query.next()) {
-        return query.value(0).toInt();
+    if (m_currentUserId == -1) {
+        if (!m_logContentSnapshot.isEmpty()) {
+            m_logContentSnapshot.clear();
+            emit logContentChanged();
+        }
+        return;
     }
 
-    return 0;
+    qint64 fromEpoch = 0;
+    qint64 toEpoch = 0;
+    localDayBounds(QDate::fromString(m_startDateFilter, Qt::ISODate),
+                   QDate::fromString(m_endDateFilter, Qt::ISODate), fromEpoch, toEpoch);
+
+    m_logContentLoading = true;
+    const int userId = m_currentUserId;
+    m_storage->run(StorageWorker::Activity, [userId, fromEpoch, toEpoch](QSqlDatabase &db) {
+        return queryLogContent(db, userId, fromEpoch, toEpoch);
+    }).then(this, [this](const QString &content) {
+        m_logContentLoading = false;
+        if (m_logContentDirty) {
+            // User atau filter berubah selama query; hasil ini sudah usang
+            m_logContentDirty = false;
+            scheduleLogContentRefresh();
+            return;
+        }
+        if (content != m_logContentSnapshot) {
+            m_logContentSnapshot = content;
+            emit logContentChanged();
+        }
+    });
 }
 
-QString Logger::logContent() const
+QString Logger::queryLogContent(QSqlDatabase &db, int userId, qint64 fromEpoch, qint64 toEpoch)
 {
-    if (!ensureDatabaseOpen()) {
+    QString content;
+    if (!db.isOpen()) {
         qWarning() << "Cannot fetch log content: Database is not open";
-        return "";
-    }
-
-    if (m_currentUserId == -1) {
-        qWarning() << "Cannot fetch log content: No user logged in";
-        return "";
+        return content;
     }
 
-    QString content;
+    ScopedPerfTimer perf("sql.log_content");
     // MODIFIKASI 1: Tambahkan 'url' ke dalam query SELECT
     QString queryStr = "SELECT start_time, end_time, app_name, title, url FROM log "
-                       "WHERE app_name IS NOT NULL AND title IS NOT NULL AND id_user = :id_user ";
-
-    if (!m_startDateFilter.isEmpty()) {
-        queryStr += QString("AND date(start_time, 'unixepoch', 'localtime') >= date('%1') ")
-        .arg(m_startDateFilter);
-    }
-    if (!m_endDateFilter.isEmpty()) {
-        queryStr += QString("AND date(start_time, 'unixepoch', 'localtime') <= date('%1') ")
-        .arg(m_endDateFilter);
-    }
+                       "WHERE id_user = :id_user AND start_time BETWEEN :from AND :to "
+                       "AND app_name IS NOT NULL AND title IS NOT NULL "
+                       "ORDER BY start_time DESC";
 
-    queryStr += "ORDER BY start_time DESC";
-
-    QSqlQuery query(m_db);
+    QSqlQuery query(db);
     query.prepare(queryStr);
-    query.bindValue(":id_user", m_currentUserId);
+    query.bindValue(":id_user", userId);
+    query.bindValue(":from", fromEpoch);
+    query.bindValue(":to", toEpoch);
     if (!query.exec()) {
         qWarning() << "Failed to fetch log content:" << query.lastError().text();
         return content;
     }
-    qDebug() << "logContent query executed, userId:" << m_currentUserId << ", rows:" << query.size();
+    qCDebug(lcTracking) << "logContent query executed, userId:" << userId;
     while (query.next()) {
         qint64 start = query.value(0).toLongLong();
         qint64 end = query.value(1).toLongLong();
@@ -1363,7 +1414,7 @@ QString Logger::logContent() const
                        .arg(title)
                        .arg(url); // Tambahkan URL di sini
     }
-    qDebug() << "logContent returned" << content.count('\n') << "lines";
+    qCDebug(lcTracking) << "logContent returned" << content.count('\n') << "lines";
     return content;
 }
 
@@ -1412,10 +1463,11 @@ void Logger::addProductivityApp(const QString &appName, const QString &windowTit
         return;
     }
 
-    // 1. Simpan ke database lokal terlebih dahulu
+    // 1. Simpan ke database lokal terlebih dahulu; aturan yang sudah ada untuk
+    // aplikasi/url/user yang sama tidak ditimpa (indeks unik idx_aplikasi_app_url_user)
     QSqlQuery query(m_productivityDb);
     query.prepare("INSERT INTO aplikasi (aplikasi, window_title, url, jenis, productivity) "
-                  "VALUES (:app, :window, :url, :type, :prod)");
+                  "VALUES (:app, :window, :url, :type, :prod) ON CONFLICT DO NOTHING");
     query.bindValue(":app", appName);
     query.bindValue(":window", windowTitle.isEmpty() ? QVariant() : windowTitle);
     query.bindValue(":url", url.isEmpty() ? QVariant() : url);
@@ -1423,7 +1475,11 @@ void Logger::addProductivityApp(const QString &appName, const QString &windowTit
     query.bindValue(":prod", productivityType);
 
     if (query.exec()) {
-        qDebug() << "Aplikasi ditambahkan. Menunggu approval admin.";
+        if (query.numRowsAffected() > 0) {
+            qCDebug(lcApi) << "Aplikasi ditambahkan. Menunggu approval admin.";
+        } else {
+            qCDebug(lcApi) << "Aturan untuk aplikasi ini sudah ada, permintaan tetap dikirim ke server";
+        }
 
         // 2. Kirim data ke API
         sendProductivityAppToAPI(appName, windowTitle, url, productivityType);
@@ -1472,19 +1528,20 @@ void Logger::sendProductivityAppToAPI(const QString &appName, const QString &win
         payload["url"] = url;
     }
 
-    QNetworkRequest request(QUrl("https://deskmon.pranala-dt.co.id/api/app-request/store"));
+    QNetworkRequest request(endpoint("app-request/store"));
     request.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
     request.setRawHeader("Authorization", "Bearer " + m_authToken.toUtf8());
 
-    qDebug() << "Sending productivity app to API:" << QJsonDocument(payload).toJson();
+    qCDebug(lcApi) << "Sending productivity app to API:" << QJsonDocument(payload).toJson();
 
     QNetworkReply* reply = m_networkManager->post(request, QJsonDocument(payload).toJson());
+    PerfStats::trackReply(reply, "api.app-request/store");
     QTimer::singleShot(30000, reply, &QNetworkReply::abort);
 
     connect(reply, &QNetworkReply::finished, [this, reply]() {
         if (reply->error() == QNetworkReply::NoError) {
             QByteArray response = reply->readAll();
-            qDebug() << "Productivity app successfully sent to API. Response:" << response;
+            qCDebug(lcApi) << "Productivity app successfully sent to API. Response:" << response;
         } else {
             qWarning() << "Failed to send productivity app to API:" << reply->errorString();
             if (reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() == 401) {
@@ -1513,19 +1570,21 @@ void Logger::fetchAndStoreProductivityApps()
     }
 
     // 2. Buat request ke API
-    QNetworkRequest request(QUrl("https://deskmon.pranala-dt.co.id/api/app-request/all"));
+    QNetworkRequest request(endpoint("app-request/all"));
     request.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
     request.setRawHeader("Authorization", "Bearer " + m_authToken.toUtf8());
+    m_httpCache.prepare(request, kRulesCacheKey, m_currentUserId);
 
-    qDebug() << "Fetching productivity apps from API for user:" << m_currentUserId;
+    qCDebug(lcApi) << "Fetching productivity apps from API for user:" << m_currentUserId;
 
     // 3. Kirim GET request dengan timeout
     QNetworkReply *reply = m_networkManager->get(request);
+    PerfStats::trackReply(reply, "api.app-request/all");
     QTimer::singleShot(30000, reply, &QNetworkReply::abort); // Timeout 30 detik
 
     // Debug raw request
-    qDebug() << "Request URL:" << request.url().toString();
-    qDebug() << "Request Headers:" << request.rawHeaderList();
+    qCDebug(lcApi) << "Request URL:" << request.url().toString();
+    qCDebug(lcApi) << "Request Headers:" << request.rawHeaderList();
 
     connect(reply, &QNetworkReply::finished, this, [this, reply]() {
         handleProductivityAppsResponse(reply);
@@ -1536,6 +1595,11 @@ void Logger::handleProductivityAppsResponse(QNetworkReply *reply)
 {
     QScopedPointer<QNetworkReply, QScopedPointerDeleteLater> replyPtr(reply);
 
+    // Daftar aturan global bisa besar; 304 berarti tabel aplikasi sudah terkini
+    if (HttpCache::isNotModified(reply)) {
+        qCDebug(lcApi) << "Productivity apps not modified";
+        return;
+    }
     if (reply->error() != QNetworkReply::NoError) {
         qWarning() << "Failed to fetch productivity apps:" << reply->errorString();
         return;
@@ -1555,80 +1619,92 @@ void Logger::handleProductivityAppsResponse(QNetworkReply *reply)
         return;
     }
 
-    QJsonArray appsArray = jsonObj["data"].isArray() ? jsonObj["data"].toArray() : QJsonArray();
-
-    if (!m_productivityDb.transaction()) {
-        qWarning() << "Failed to start transaction";
+    if (!jsonObj["data"].isArray()) {
+        qWarning() << "Productivity apps response has no data array";
         return;
     }
+    const QJsonArray appsArray = jsonObj["data"].toArray();
 
-    QSqlQuery query(m_productivityDb);
-    bool success = true;
-
-    // Ambil semua aplikasi yang sudah ada untuk pengecekan duplikat
-    QHash<QPair<QString, QString>, int> existingApps; // <appName, url> -> id
-    query.prepare("SELECT id, aplikasi, url FROM aplikasi");
-    if (query.exec()) {
-        while (query.next()) {
-            existingApps.insert(
-                qMakePair(query.value(1).toString(), query.value(2).toString()),
-                query.value(0).toInt()
-                );
-        }
-    }
-
+    // Kolom untuk execBatch; memori sebanding dengan ukuran respons, bukan tabel lokal
+    QVariantList appNames, windowTitles, urls, types, forUsers;
+    appNames.reserve(appsArray.size());
+    windowTitles.reserve(appsArray.size());
+    urls.reserve(appsArray.size());
+    types.reserve(appsArray.size());
+    forUsers.reserve(appsArray.size());
     for (const QJsonValue &appValue : appsArray) {
         if (!appValue.isObject()) continue;
 
         QJsonObject appObj = appValue.toObject();
-        QString appName = appObj["application_name"].toString();
         QString status = appObj["productivity_status"].toString().toLower();
         QString processName = appObj["process_name"].toString();
         QString url = appObj["url"].toString();
-        int userId = appObj["user_id"].toInt();
 
         int jenis = 0;
         if (status == "productive") jenis = 1;
         else if (status == "non-productive") jenis = 2;
 
-        QString forUsers = QString::number(userId); // Format: "9" untuk single user
+        appNames.append(appObj["application_name"].toString());
+        windowTitles.append(processName.isEmpty() ? QVariant() : QVariant(processName));
+        urls.append(url.isEmpty() ? QVariant() : QVariant(url));
+        types.append(jenis);
+        forUsers.append(QString::number(appObj["user_id"].toInt())); // Format: "9" untuk single user
+    }
 
-        // Cek apakah aplikasi dengan nama dan URL yang sama sudah ada
-        QPair<QString, QString> appKey(appName, url);
-        if (existingApps.contains(appKey)) {
-            int existingId = existingApps[appKey];
+    ScopedPerfTimer perf("sql.rules_ingest");
+    // Setiap sync diberi generasi baru; aturan server yang tidak ikut respons ini sudah dihapus di server
+    const qint64 generation = QDateTime::currentMSecsSinceEpoch();
+    QVariantList generations;
+    generations.reserve(appNames.size());
+    for (qsizetype i = 0; i < appNames.size(); ++i) {
+        generations.append(generation);
+    }
 
-            // Update hanya jika for_user adalah 0 (global) atau sama dengan user ID
-            query.prepare(
-                "UPDATE aplikasi SET jenis = :jenis "
-                "WHERE id = :id AND (for_user = '0' OR for_user = :forUsers)"
-                );
-            query.bindValue(":jenis", jenis);
-            query.bindValue(":id", existingId);
-            query.bindValue(":forUsers", forUsers);
+    if (!m_productivityDb.transaction()) {
+        qWarning() << "Failed to start transaction";
+        return;
+    }
 
-            if (!query.exec()) {
-                qWarning() << "Failed to update existing app:" << query.lastError();
-                success = false;
-                break;
-            }
-        } else {
-            // Insert baru jika tidak ada duplikat
-            query.prepare(
-                "INSERT INTO aplikasi (aplikasi, window_title, url, jenis, for_user) "
-                "VALUES (:app, :window, :url, :type, :forUsers)"
-                );
-            query.bindValue(":app", appName);
-            query.bindValue(":window", processName.isEmpty() ? QVariant() : processName);
-            query.bindValue(":url", url.isEmpty() ? QVariant() : url);
-            query.bindValue(":type", jenis);
-            query.bindValue(":forUsers", forUsers);
+    // Kunci alami (aplikasi, url, for_user): aturan user lain dan aturan global tidak saling menimpa
+    QSqlQuery query(m_productivityDb);
+    query.prepare("INSERT INTO aplikasi (aplikasi, window_title, url, jenis, for_user, sync_gen) "
+                  "VALUES (?, ?, ?, ?, ?, ?) "
+                  "ON CONFLICT(aplikasi, COALESCE(url, ''), for_user) DO UPDATE SET "
+                  "jenis = excluded.jenis, "
+                  "sync_gen = excluded.sync_gen");
+    query.addBindValue(appNames);
+    query.addBindValue(windowTitles);
+    query.addBindValue(urls);
+    query.addBindValue(types);
+    query.addBindValue(forUsers);
+    query.addBindValue(generations);
+    bool success = query.execBatch();
+    if (!success) {
+        qWarning() << "Failed to upsert productivity apps:" << query.lastError().text();
+    }
 
-            if (!query.exec()) {
-                qWarning() << "Failed to insert new app:" << query.lastError();
-                success = false;
-                break;
-            }
+    if (success) {
+        // Baris lokal (permintaan yang belum diproses server) tidak punya sync_gen
+        query.prepare("DELETE FROM aplikasi WHERE sync_gen IS NOT NULL AND sync_gen <> ?");
+        query.addBindValue(generation);
+        success = query.exec();
+        if (!success) {
+            qWarning() << "Failed to remove stale productivity apps:" << query.lastError().text();
+        } else if (query.numRowsAffected() > 0) {
+            qCDebug(lcApi) << "Removed" << query.numRowsAffected() << "productivity apps no longer on server";
+        }
+    }
+
+    if (success) {
+        // Permintaan lokal yang sudah diputuskan server untuk user tertentu tidak
+        // lagi bertabrakan dengan barisnya, jadi dibuang di sini
+        query.prepare("DELETE FROM aplikasi WHERE sync_gen IS NULL AND jenis = 0 AND EXISTS ("
+                      "SELECT 1 FROM aplikasi s WHERE s.sync_gen = ? AND s.aplikasi = aplikasi.aplikasi "
+                      "AND COALESCE(s.url, '') = COALESCE(aplikasi.url, ''))");
+        query.addBindValue(generation);
+        success = query.exec();
+        if (!success) {
+            qWarning() << "Failed to remove answered productivity app requests:" << query.lastError().text();
         }
     }
 
@@ -1637,6 +1713,7 @@ void Logger::handleProductivityAppsResponse(QNetworkReply *reply)
             qWarning() << "Failed to commit transaction";
             m_productivityDb.rollback();
         } else {
+            m_httpCache.store(kRulesCacheKey, m_currentUserId, reply);
             refreshProductivityModels();
             emit productivityAppsChanged();
         }
@@ -1674,8 +1751,8 @@ void Logger::refreshProductivityModels()
     m_nonProductiveAppsModel->setQuery(nonProductiveQuery, m_productivityDb);
 
     // Debug output
-    qDebug() << "Productive apps count:" << m_productiveAppsModel->rowCount();
-    qDebug() << "Non-productive apps count:" << m_nonProductiveAppsModel->rowCount();
+    qCDebug(lcStats) << "Productive apps count:" << m_productiveAppsModel->rowCount();
+    qCDebug(lcStats) << "Non-productive apps count:" << m_nonProductiveAppsModel->rowCount();
 }
 
 
@@ -1690,211 +1767,41 @@ void Logger::sendDailyUsageReport()
         return;
     }
 
-    if (!ensureDatabaseOpen() || !ensureProductivityDatabaseOpen()) {
+    if (!ensureProductivityDatabaseOpen()) {
         qWarning() << "Cannot send usage report: Database not accessible.";
         return;
     }
-
-    qDebug() << "Preparing aggregated daily usage report...";
-    QString today = QDate::currentDate().toString("yyyy-MM-dd");
-
-    // Struktur data untuk menyimpan agregasi
-    QHash<QString, qint64> appDurations; // Untuk aplikasi non-browser
-    QHash<QString, int> appProductivity;
-    QHash<QPair<QString, QString>, qint64> browserUsage; // <appName, url> -> duration
-    QHash<QString, int> domainProductivity;
-
-    QSqlQuery logQuery(m_db);
-    logQuery.prepare(R"(
-        SELECT app_name, title, url, start_time, end_time
-        FROM log
-        WHERE id_user = :user_id
-        AND date(start_time, 'unixepoch', 'localtime') = :today
-        AND app_name != 'Idle'
-    )");
-    logQuery.bindValue(":user_id", m_currentUserId);
-    logQuery.bindValue(":today", today);
-
-    if (!logQuery.exec()) {
-        qWarning() << "Failed to fetch logs for aggregation:" << logQuery.lastError().text();
+    if (!ensureRollupLoaded()) {
+        qCDebug(lcApi) << "Activity rollup still loading, usage report deferred";
         return;
     }
 
-    // Helper function untuk ekstrak domain dari URL
-
-    // Helper function untuk ekstrak domain dari URL - VERSI YANG DIPERBAIKI
-    auto extractDomain = [](const QString& url) -> QString {
-        if (url.isEmpty()) return "";
-
-        QString cleanUrl = url;
-
-        // Tambahkan scheme jika belum ada
-        if (!cleanUrl.startsWith("http://") && !cleanUrl.startsWith("https://")) {
-            cleanUrl = "https://" + cleanUrl;
-        }
-
-        QUrl qurl(cleanUrl);
-        QString domain = qurl.host();
-
-        // Jika masih kosong, coba parsing manual
-        if (domain.isEmpty()) {
-            // Hapus scheme jika ada
-            QString temp = url;
-            temp.remove(QRegularExpression("^https?://"));
-
-            // Ambil bagian sebelum slash pertama
-            int slashPos = temp.indexOf('/');
-            if (slashPos != -1) {
-                temp = temp.left(slashPos);
-            }
-
-            // Ambil bagian sebelum query parameter atau fragment
-            int queryPos = temp.indexOf('?');
-            if (queryPos != -1) {
-                temp = temp.left(queryPos);
-            }
-
-            int fragmentPos = temp.indexOf('#');
-            if (fragmentPos != -1) {
-                temp = temp.left(fragmentPos);
-            }
-
-            domain = temp;
-        }
-
-        // Hapus www. prefix
-        if (domain.startsWith("www.")) {
-            domain = domain.mid(4);
-        }
-
-        return domain;
-    };
-
-    qDebug() << "==== RAW LOG DATA ====";
-    while (logQuery.next()) {
-        QString appName = logQuery.value(0).toString();
-        QString title = logQuery.value(1).toString();
-        QString urlString = logQuery.value(2).toString();
-        qint64 startTime = logQuery.value(3).toLongLong();
-        qint64 endTime = logQuery.value(4).toLongLong();
-        qint64 duration = endTime - startTime;
-
-        if (duration <= 0) continue;
-
-        // Cek apakah ini aplikasi browser (punya URL)
-        bool isBrowserApp = !urlString.isEmpty();
-
-        if (isBrowserApp) {
-            // Untuk browser, simpan per URL
-            QString domain = extractDomain(urlString);
-            QPair<QString, QString> key(appName, domain);
-            browserUsage[key] += duration;
-
-            if (!domainProductivity.contains(domain)) {
-                domainProductivity[domain] = getAppProductivityType(appName, urlString);
-            }
-        } else {
-            // Untuk non-browser, simpan per aplikasi
-            appDurations[appName] += duration;
-            if (!appProductivity.contains(appName)) {
-                appProductivity[appName] = getAppProductivityType(appName, "");
-            }
-        }
-    }
-
-    // --- Membuat Payload ---
-    QJsonArray dataArray;
-
-    qDebug() << "==== NON-BROWSER APPLICATION USAGE ====";
-    // 1. Tambahkan aplikasi non-browser
-    for (auto it = appDurations.constBegin(); it != appDurations.constEnd(); ++it) {
-        QString appName = it.key();
-        int prodType = appProductivity.value(appName, 0);
-        QString statusString = "neutral";
-        if (prodType == 1) statusString = "productive";
-        else if (prodType == 2) statusString = "non-productive";
-
-        qDebug() << "App:" << appName
-                 << "| Total Duration:" << it.value() << "seconds ("
-                 << formatDuration(it.value()) << ")"
-                 << "| Status:" << statusString;
-
-        QJsonObject appObject;
-        appObject["user_id"] = m_currentUserId;
-        appObject["app_name"] = appName;
-        appObject["duration"] = it.value();
-        appObject["url"] = QJsonValue(); // Null untuk non-browser
-        appObject["status"] = statusString;
-        dataArray.append(appObject);
-    }
-
-    qDebug() << "==== BROWSER USAGE BY DOMAIN ====";
-    // 2. Tambahkan penggunaan browser per domain
-    for (auto it = browserUsage.constBegin(); it != browserUsage.constEnd(); ++it) {
-        QString appName = it.key().first;  // Nama browser (chrome, firefox, etc)
-        QString domain = it.key().second;  // Domain
-        int prodType = domainProductivity.value(domain, 0);
-        QString statusString = "neutral";
-        if (prodType == 1) statusString = "productive";
-        else if (prodType == 2) statusString = "non-productive";
-
-        qDebug() << "Browser:" << appName
-                 << "| Domain:" << domain
-                 << "| Duration:" << it.value() << "seconds ("
-                 << formatDuration(it.value()) << ")"
-                 << "| Status:" << statusString;
-
-        QJsonObject browserObject;
-        browserObject["user_id"] = m_currentUserId;
-        browserObject["app_name"] = appName;
-        browserObject["duration"] = it.value();
-        browserObject["url"] = domain;  // Simpan domain sebagai URL
-        browserObject["status"] = statusString;
-        dataArray.append(browserObject);
-    }
-
-    if (dataArray.isEmpty()) {
-        qDebug() << "No aggregated data to report. Skipping API call.";
+    // Dibangun dari rollup hari ini; hanya entri yang berubah sejak ack terakhir
+    const QDate today = QDate::currentDate();
+    UsageReport::Delta delta = m_usageReport.build(m_productivityDb, m_currentUserId, today, m_rollup);
+    if (delta.data.isEmpty()) {
+        qCDebug(lcApi) << "No usage changes since last acknowledged report. Skipping API call.";
         return;
     }
 
-    // Buat payload akhir
     QJsonObject payload;
-    payload["data"] = dataArray;
-
-    // Log payload yang akan dikirim
-    qDebug() << "==== FINAL PAYLOAD TO SEND ====";
-    qDebug() << "User ID:" << m_currentUserId;
-    qDebug() << "Date:" << today;
-    qDebug() << "Total Entries:" << dataArray.count();
-    qDebug() << "Payload JSON:" << QJsonDocument(payload).toJson(QJsonDocument::Indented);
-
-    // Kirim request
-    QNetworkRequest request(QUrl("https://deskmon.pranala-dt.co.id/api/productivity-app"));
-    request.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
-    request.setRawHeader("Authorization", "Bearer " + m_authToken.toUtf8());
-
-    qDebug() << "Sending aggregated usage report to API. Entries:" << dataArray.count();
-    QNetworkReply *reply = m_networkManager->post(request, QJsonDocument(payload).toJson());
-    connect(reply, &QNetworkReply::finished, this, [this, reply]() {
-        handleDailyUsageReportResponse(reply);
-    });
-}
-
-void Logger::handleDailyUsageReportResponse(QNetworkReply *reply)
-{
-    if (reply->error() == QNetworkReply::NoError) {
-        QByteArray response = reply->readAll();
-        qDebug() << "Daily usage report sent successfully. Response:" << response;
-    } else {
-        qWarning() << "Failed to send daily usage report:" << reply->errorString();
-        qDebug() << "HTTP Status:" << reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
-        qDebug() << "Response Body:" << reply->readAll();
-    }
-    reply->deleteLater();
+    payload["data"] = delta.data;
+
+    // Laporan yang belum terkirim digantikan yang terbaru; karena watermark baru maju
+    // setelah ack, laporan baru selalu mencakup semua entri di laporan lama
+    ApiOutbox::Message message;
+    message.kind = "productivity-app";
+    message.url = endpoint("productivity-app");
+    message.body = QJsonDocument(payload).toJson(QJsonDocument::Compact);
+    message.token = m_authToken;
+    message.userId = m_currentUserId;
+    message.coalesceKey = QString("usage_report:%1:%2").arg(m_currentUserId).arg(today.toString(Qt::ISODate));
+    message.tag = UsageReport::tagFor(m_currentUserId, today, delta.until);
+
+    qCDebug(lcApi) << "Queueing usage report delta for API. Entries:" << delta.data.count();
+    m_outbox->enqueue(message);
 }
 
-
 QVariantList Logger::getPendingApplicationRequests() {
     QVariantList requests;
 
@@ -1964,7 +1871,7 @@ void Logger::fetchAndStoreTasks()
         tokenQuery.addBindValue(m_currentUserId);
         if (tokenQuery.exec() && tokenQuery.next()) {
             m_authToken = tokenQuery.value(0).toString();
-            qDebug() << "Token retrieved from database:" << m_authToken;
+            qCDebug(lcTasks) << "Token retrieved from database";
         }
 
         // Jika token masih kosong, hentikan proses dan beri sinyal kesalahan
@@ -1976,16 +1883,18 @@ void Logger::fetchAndStoreTasks()
     }
 
     // 4. Siapkan permintaan HTTP GET ke endpoint server dengan user_id
-    QString apiUrl = QString("https://deskmon.pranala-dt.co.id/api/task-by-user/%1").arg(m_currentUserId);
+    QString apiUrl = endpoint(QString("task-by-user/%1").arg(m_currentUserId)).toString();
     QNetworkRequest request;
     request.setUrl(QUrl(apiUrl));
     request.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
     request.setRawHeader("Authorization", "Bearer " + m_authToken.toUtf8());
+    m_httpCache.prepare(request, kTaskListCacheKey, m_currentUserId);
 
-    qDebug() << "Sending request to:" << apiUrl << "with token:" << m_authToken;
+    qCDebug(lcTasks) << "Sending request to:" << apiUrl;
 
     // 5. Kirim permintaan ke server dan hubungkan respons ke slot penanganan
     QNetworkReply *reply = m_networkManager->get(request);
+    PerfStats::trackReply(reply, "api.task-by-user");
     connect(reply, &QNetworkReply::finished, this, [=]() {
         handleTaskFetchReply(reply);
     });
@@ -1995,7 +1904,14 @@ void Logger::handleTaskFetchReply(QNetworkReply *reply)
 {
     // 5. Periksa kode status HTTP dari respons
     int statusCode = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
-    qDebug() << "HTTP Status Code:" << statusCode;
+    qCDebug(lcTasks) << "HTTP Status Code:" << statusCode;
+
+    // Daftar tugas di server tidak berubah sejak download terakhir: tidak ada parse atau write
+    if (HttpCache::isNotModified(reply)) {
+        qCDebug(lcTasks) << "Task list not modified";
+        reply->deleteLater();
+        return;
+    }
 
     // 6. Tangani kesalahan jaringan jika ada
     if (reply->error() != QNetworkReply::NoError) {
@@ -2006,7 +1922,7 @@ void Logger::handleTaskFetchReply(QNetworkReply *reply)
 
     // 7. Baca data respons dari server
     QByteArray responseData = reply->readAll();
-    qDebug() << "Response data:" << responseData;
+    qCDebug(lcTasks) << "Response data:" << responseData;
 
     // 8. Tangani kasus autentikasi gagal (token tidak valid atau kedaluwarsa)
     if (statusCode == 401) {
@@ -2036,36 +1952,18 @@ void Logger::handleTaskFetchReply(QNetworkReply *reply)
     // 11. Ambil array tugas dari respons
     QJsonArray tasksArray = jsonObj["data"].toArray();
     if (tasksArray.isEmpty()) {
-        qDebug() << "No tasks found in response";
+        qCDebug(lcTasks) << "No tasks found in response";
+        m_httpCache.store(kTaskListCacheKey, m_currentUserId, reply);
         reply->deleteLater();
         return;
     }
 
-    // 12. Mulai transaksi database untuk memastikan integritas data
-    QSqlQuery query(m_productivityDb);
-    m_productivityDb.transaction();
-
-    // 13. Ambil tugas yang sudah ada di database lokal untuk perbandingan
-    QMap<int, QPair<int, int>> existingTasks; // taskId -> (max_time, time_usage)
-    query.exec("SELECT id, max_time, time_usage FROM task");
-    while (query.next()) {
-        int taskId = query.value(0).toInt();
-        int maxTime = query.value(1).toInt();
-        int timeUsage = query.value(2).toInt();
-        existingTasks.insert(taskId, QPair<int, int>(maxTime, timeUsage));
-    }
-
-    // 14. Proses setiap tugas dari respons server
+    // 12. Kumpulkan kolom untuk execBatch; tidak ada lagi pemuatan seluruh tabel task
+    QVariantList ids, projectNames, taskDescs, maxTimes, timeUsages, userIds, serverMaxTimes;
+    QVariantList completedIds;
     for (const QJsonValue &taskValue : tasksArray) {
         QJsonObject taskObj = taskValue.toObject();
 
-        // Lewati tugas yang sudah selesai
-        QString status = taskObj["status"].toString();
-        if (status == "completed") {
-            qDebug() << "Skipping completed task ID" << taskObj["id"].toInt();
-            continue;
-        }
-
         // Validasi bahwa semua field wajib ada
         if (!taskObj.contains("id") || !taskObj.contains("title") ||
             !taskObj.contains("description") || !taskObj.contains("user_id")) {
@@ -2074,21 +1972,24 @@ void Logger::handleTaskFetchReply(QNetworkReply *reply)
         }
 
         int taskId = taskObj["id"].toInt();
-        QString projectName = taskObj["title"].toString();
-        QString taskDesc = taskObj["description"].toString();
         int userId = taskObj["user_id"].toInt();
 
         // Lewati tugas yang bukan milik pengguna saat ini
         if (userId != m_currentUserId) {
-            qDebug() << "Skipping task ID" << taskId << "for user ID" << userId << "(not current user)";
+            qCDebug(lcTasks) << "Skipping task ID" << taskId << "for user ID" << userId << "(not current user)";
             continue;
         }
 
-        // Ambil data duration dan total_duration dari server
-        QJsonValue durationValue = taskObj["duration"];
-        QJsonValue totalDurationValue = taskObj["total_duration"];
+        // Tugas selesai tidak disimpan, tapi tetap ditandai agar tidak dianggap hilang;
+        // penyelesaian lokal (completed_tasks) dilakukan lewat sinkronisasi status
+        if (taskObj["status"].toString() == "completed") {
+            qCDebug(lcTasks) << "Skipping completed task ID" << taskId;
+            completedIds.append(taskId);
+            continue;
+        }
 
         // Konversi duration dari server (dalam jam) ke detik untuk max_time
+        QJsonValue durationValue = taskObj["duration"];
         int serverMaxTime = 0;
         if (!durationValue.isNull()) {
             if (durationValue.isString()) {
@@ -2099,6 +2000,7 @@ void Logger::handleTaskFetchReply(QNetworkReply *reply)
         }
 
         // Konversi total_duration dari server (dalam jam) ke detik untuk time_usage
+        QJsonValue totalDurationValue = taskObj["total_duration"];
         int serverTimeUsage = 0;
         if (!totalDurationValue.isNull()) {
             if (totalDurationValue.isString()) {
@@ -2108,81 +2010,103 @@ void Logger::handleTaskFetchReply(QNetworkReply *reply)
             }
         }
 
-        bool taskExists = existingTasks.contains(taskId);
-
-        if (taskExists) {
-            // 15. Untuk tugas yang sudah ada, update berdasarkan data server
-            QPair<int, int> currentValues = existingTasks[taskId];
-            int currentMaxTime = currentValues.first;
-            int currentTimeUsage = currentValues.second;
-
-            // Tentukan max_time yang akan digunakan
-            int finalMaxTime = currentMaxTime;
-            if (serverMaxTime > 0) {
-                // Jika server memberikan duration, gunakan yang lebih besar
-                finalMaxTime = qMax(serverMaxTime, currentMaxTime);
-            } else if (currentMaxTime == 0) {
-                // Jika tidak ada di server dan lokal juga 0, set default 8 jam
-                finalMaxTime = 8 * 3600;
-            }
+        ids.append(taskId);
+        projectNames.append(taskObj["title"].toString());
+        taskDescs.append(taskObj["description"].toString());
+        maxTimes.append(serverMaxTime > 0 ? serverMaxTime : kDefaultTaskMaxTime);
+        timeUsages.append(qMax(serverTimeUsage, 0));
+        userIds.append(userId);
+        serverMaxTimes.append(serverMaxTime);
+    }
 
-            // Tentukan time_usage yang akan digunakan
-            int finalTimeUsage = currentTimeUsage;
-            if (serverTimeUsage > 0) {
-                // Jika server memberikan total_duration, gunakan nilai server
-                finalTimeUsage = serverTimeUsage;
-            }
+    ScopedPerfTimer perf("sql.task_ingest");
+    const qint64 generation = QDateTime::currentMSecsSinceEpoch();
+    QVariantList generations;
+    generations.reserve(ids.size());
+    for (qsizetype i = 0; i < ids.size(); ++i) {
+        generations.append(generation);
+    }
 
-            query.prepare("UPDATE task SET project_name = :projectName, task = :taskDesc, "
-                          "max_time = :maxTime, time_usage = :timeUsage WHERE id = :id");
-            query.bindValue(":id", taskId);
-            query.bindValue(":projectName", projectName);
-            query.bindValue(":taskDesc", taskDesc);
-            query.bindValue(":maxTime", finalMaxTime);
-            query.bindValue(":timeUsage", finalTimeUsage);
-
-            qDebug() << "Updating task ID" << taskId
-                     << "- max_time:" << finalMaxTime << "(current:" << currentMaxTime << ", server:" << serverMaxTime << ")"
-                     << "- time_usage:" << finalTimeUsage << "(current:" << currentTimeUsage << ", server:" << serverTimeUsage << ")";
-        } else {
-            // 16. Untuk tugas baru, masukkan dengan nilai dari server atau default
-            int finalMaxTime = (serverMaxTime > 0) ? serverMaxTime : 8 * 3600; // default 8 jam
-            int finalTimeUsage = (serverTimeUsage > 0) ? serverTimeUsage : 0;
-
-            query.prepare("INSERT INTO task (id, project_name, task, max_time, time_usage, active, status, paused, user_id) "
-                          "VALUES (:id, :projectName, :taskDesc, :maxTime, :timeUsage, 0, 'Pending', 0, :userId)");
-            query.bindValue(":id", taskId);
-            query.bindValue(":projectName", projectName);
-            query.bindValue(":taskDesc", taskDesc);
-            query.bindValue(":maxTime", finalMaxTime);
-            query.bindValue(":timeUsage", finalTimeUsage);
-            query.bindValue(":userId", userId);
-
-            qDebug() << "Inserting new task ID" << taskId
-                     << "with max_time:" << finalMaxTime
-                     << "and time_usage:" << finalTimeUsage;
+    // 13. Satu transaksi: upsert, tandai tugas selesai, hapus yang tidak lagi ada di server
+    if (!m_productivityDb.transaction()) {
+        qWarning() << "Failed to start task transaction:" << m_productivityDb.lastError().text();
+        reply->deleteLater();
+        return;
+    }
+
+    // 14. Tugas baru memakai nilai server atau default. Tugas lama: max_time diambil yang
+    // lebih besar jika server memberi duration, time_usage mengikuti server jika > 0.
+    QSqlQuery query(m_productivityDb);
+    query.prepare("INSERT INTO task (id, project_name, task, max_time, time_usage, active, status, paused, user_id, sync_gen) "
+                  "VALUES (?, ?, ?, ?, ?, 0, 'Pending', 0, ?, ?) "
+                  "ON CONFLICT(id) DO UPDATE SET "
+                  "project_name = excluded.project_name, "
+                  "task = excluded.task, "
+                  "max_time = CASE WHEN ? > 0 THEN MAX(excluded.max_time, task.max_time) "
+                  "WHEN task.max_time = 0 THEN excluded.max_time ELSE task.max_time END, "
+                  "time_usage = CASE WHEN excluded.time_usage > 0 THEN excluded.time_usage ELSE task.time_usage END, "
+                  "sync_gen = excluded.sync_gen");
+    query.addBindValue(ids);
+    query.addBindValue(projectNames);
+    query.addBindValue(taskDescs);
+    query.addBindValue(maxTimes);
+    query.addBindValue(timeUsages);
+    query.addBindValue(userIds);
+    query.addBindValue(generations);
+    query.addBindValue(serverMaxTimes);
+    bool success = query.execBatch();
+    if (!success) {
+        qWarning() << "Failed to upsert tasks:" << query.lastError().text();
+    }
+
+    // 15. Tugas yang selesai di server tetap dianggap terlihat pada generasi ini
+    if (success && !completedIds.isEmpty()) {
+        QVariantList completedGenerations;
+        completedGenerations.reserve(completedIds.size());
+        for (qsizetype i = 0; i < completedIds.size(); ++i) {
+            completedGenerations.append(generation);
+        }
+        query.prepare("UPDATE task SET sync_gen = ? WHERE id = ?");
+        query.addBindValue(completedGenerations);
+        query.addBindValue(completedIds);
+        success = query.execBatch();
+        if (!success) {
+            qWarning() << "Failed to mark completed tasks:" << query.lastError().text();
         }
+    }
 
-        // 17. Eksekusi query dan tangani kesalahan
-        if (!query.exec()) {
-            qWarning() << "Failed to save task ID" << taskId << ":" << query.lastError().text();
-            continue;
+    // 16. Tugas yang pernah datang dari server tapi tidak ada di respons ini sudah dihapus di server.
+    // Tugas aktif dibiarkan; tugas lama tanpa sync_gen baru ikut setelah sync pertama.
+    if (success) {
+        query.prepare("DELETE FROM task WHERE user_id = ? AND sync_gen IS NOT NULL AND sync_gen <> ? AND id <> ?");
+        query.addBindValue(m_currentUserId);
+        query.addBindValue(generation);
+        query.addBindValue(m_activeTaskId);
+        success = query.exec();
+        if (!success) {
+            qWarning() << "Failed to remove stale tasks:" << query.lastError().text();
+        } else if (query.numRowsAffected() > 0) {
+            qCDebug(lcTasks) << "Removed" << query.numRowsAffected() << "tasks no longer on server";
         }
+    }
 
-        qDebug() << "Task" << (taskExists ? "updated" : "inserted") << ": ID =" << taskId
-                 << ", Project =" << projectName << ", User ID =" << userId;
+    if (!success) {
+        m_productivityDb.rollback();
+        reply->deleteLater();
+        return;
     }
 
-    // 18. Commit transaksi atau rollback jika gagal
+    // 17. Commit transaksi atau rollback jika gagal
     if (!m_productivityDb.commit()) {
         qWarning() << "Failed to commit transaction:" << m_productivityDb.lastError().text();
         m_productivityDb.rollback();
     } else {
-        qDebug() << "Successfully processed" << tasksArray.size() << "tasks";
+        qCDebug(lcTasks) << "Successfully processed" << tasksArray.size() << "tasks";
+        m_httpCache.store(kTaskListCacheKey, m_currentUserId, reply);
         emit taskListChanged(); // Beri tahu UI bahwa daftar tugas telah diperbarui
     }
 
-    // 19. Hapus objek reply untuk mencegah kebocoran memori
+    // 18. Hapus objek reply untuk mencegah kebocoran memori
     reply->deleteLater();
 }
 
@@ -2191,89 +2115,37 @@ void Logger::handleTaskFetchReply(QNetworkReply *reply)
 
 QVariantList Logger::taskList() const
 {
-    if (!ensureProductivityDatabaseOpen()) {
-        qWarning() << "Cannot fetch task list: Database is not open";
-        return QVariantList();
-    }
-    if (m_currentUserId == -1) {
-        qWarning() << "Cannot fetch task list: No user logged in";
-        return QVariantList();
-    }
-    QVariantList tasks;
-    QSqlQuery query(m_productivityDb);
-    query.prepare("SELECT id, project_name, task, max_time, time_usage, active, status FROM task WHERE user_id = :user_id");
-    query.bindValue(":user_id", m_currentUserId);
-    if (!query.exec()) {
-        qWarning() << "Failed to fetch tasks:" << query.lastError().text();
-        return tasks;
-    }
-    while (query.next()) {
-        QVariantMap task;
-        task["id"] = query.value(0).toInt();
-        task["project_name"] = query.value(1).toString();
-        task["task"] = query.value(2).toString();
-        task["max_time"] = query.value(3).toInt();
-        task["time_usage"] = query.value(4).toInt();
-        task["active"] = query.value(5).toBool();
-        QString status = query.value(6).toString();
-
-        // Handle status logic
-        if (status.toLower() == "review") {
-            // Task is under review - keep original status
-            task["status"] = "Review";
-        } else if (task["active"].toBool()) {
-            // Active task - show current state
-            status = m_isTaskPaused ? "Paused" : "Is Running";
-            task["status"] = status;
-        } else {
-            // Inactive task
-            task["status"] = "Pending";
-        }
-
-        tasks.append(task);
-    }
-    return tasks;
+    ScopedPerfTimer perf("qml.taskList");
+    // Dari cache TaskListModel; QML sebaiknya memakai properti tasks/activeTask
+    return m_taskModel->toVariantList();
 }
 
-
-void Logger::migrateProductivityDatabase()
+void Logger::scheduleTaskListReload()
 {
-    if (!ensureProductivityDatabaseOpen()) {
-        qWarning() << "Cannot migrate productivity database: Not open";
+    if (m_taskReloadPending) {
         return;
     }
+    m_taskReloadPending = true;
+    QTimer::singleShot(0, this, &Logger::reloadTaskList);
+}
 
-    QSqlQuery query(m_productivityDb);
-
-    // Tambah kolom user_id ke tabel task jika belum ada
-    query.exec("PRAGMA table_info(task)");
-    bool hasUserId = false;
-    while (query.next()) {
-        if (query.value("name").toString() == "user_id") {
-            hasUserId = true;
-            break;
-        }
-    }
-    if (!hasUserId) {
-        if (!query.exec("ALTER TABLE task ADD COLUMN user_id INTEGER NOT NULL DEFAULT 0")) {
-            qWarning() << "Failed to add user_id to task table:" << query.lastError().text();
-        }
-    }
-
-    // Tambah kolom user_id ke tabel completed_tasks jika belum ada
-    query.exec("PRAGMA table_info(completed_tasks)");
-    hasUserId = false;
-    while (query.next()) {
-        if (query.value("name").toString() == "user_id") {
-            hasUserId = true;
-            break;
-        }
-    }
-    if (!hasUserId) {
-        if (!query.exec("ALTER TABLE completed_tasks ADD COLUMN user_id INTEGER NOT NULL DEFAULT 0")) {
-            qWarning() << "Failed to add user_id to completed_tasks table:" << query.lastError().text();
+void Logger::reloadTaskList()
+{
+    m_taskReloadPending = false;
+    m_taskModel->setActiveTask(m_activeTaskId, m_isTaskPaused);
+
+    // Hanya hasil reload terakhir yang dipakai
+    const int userId = m_currentUserId;
+    const quint64 generation = ++m_taskReloadGeneration;
+    m_storage->run(StorageWorker::Productivity, [userId](QSqlDatabase &db) {
+        QVector<TaskListModel::Task> tasks;
+        const bool ok = TaskListModel::fetch(db, userId, tasks);
+        return qMakePair(ok, tasks);
+    }).then(this, [this, generation](const QPair<bool, QVector<TaskListModel::Task>> &result) {
+        if (generation == m_taskReloadGeneration && result.first) {
+            m_taskModel->setTasks(result.second);
         }
-    }
+    });
 }
 
 
@@ -2284,6 +2156,10 @@ void Logger::setActiveTask(int taskId)
         return;
     }
 
+    // Status kedua task berubah di server karena aksi ini; status di cache sudah usang
+    m_taskStatusSync->invalidate(m_activeTaskId);
+    m_taskStatusSync->invalidate(taskId);
+
     QSqlQuery query(m_productivityDb);
 
     // Simpan time_usage untuk tugas aktif sebelumnya (jika ada) dan kirim status stop
@@ -2329,13 +2205,18 @@ void Logger::setActiveTask(int taskId)
     // Jika taskId valid, set tugas baru
     if (taskId != -1) {
         // Ambil time_usage dari tugas baru
-        query.prepare("SELECT time_usage FROM task WHERE id = :id");
-        query.bindValue(":id", taskId);
-        if (!query.exec() || !query.next()) {
-            qWarning() << "Failed to fetch time_usage for task:" << query.lastError().text();
-            return;
+        {
+            StatementCache::Query timeQuery = StatementCache::get(m_productivityDb, StatementCache::TaskTimeUsageSelect);
+            if (!timeQuery.isValid()) {
+                return;
+            }
+            timeQuery->bindValue(":id", taskId);
+            if (!timeQuery.exec() || !timeQuery->next()) {
+                qWarning() << "Failed to fetch time_usage for task:" << timeQuery->lastError().text();
+                return;
+            }
+            m_taskTimeOffset = timeQuery->value(0).toInt();
         }
-        m_taskTimeOffset = query.value(0).toInt();
         m_taskStartTime = QDateTime::currentSecsSinceEpoch();
 
         // Aktifkan tugas baru dengan status paused
@@ -2396,7 +2277,7 @@ void Logger::setActiveTask(int taskId)
                 emit trackingActiveChanged();
                 emit taskListChanged();
 
-                qDebug() << "Task automatically resumed after delay";
+                qCDebug(lcTasks) << "Task automatically resumed after delay";
             }
         });
     }
@@ -2439,75 +2320,97 @@ void Logger::sendPing(int taskId)
     QJsonObject payload;
     payload["task_id"] = QString::number(taskId); // Task ID sebagai string
 
-    // Konfigurasi request
-    QNetworkRequest request;
-    request.setUrl(QUrl("https://deskmon.pranala-dt.co.id/api/ping"));
-    request.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
-    request.setRawHeader("Authorization", "Bearer " + m_authToken.toUtf8());
-
-    qDebug() << "Sending ping with payload:" << QJsonDocument(payload).toJson();
-
-    // Kirim request POST
-    QNetworkReply* reply = m_networkManager->post(request, QJsonDocument(payload).toJson());
+    // Ping yang belum terkirim digantikan ping terbaru untuk task yang sama
+    ApiOutbox::Message message;
+    message.kind = "ping";
+    message.url = endpoint("ping");
+    message.body = QJsonDocument(payload).toJson(QJsonDocument::Compact);
+    message.token = m_authToken;
+    message.userId = m_currentUserId;
+    message.coalesceKey = QString("ping:%1").arg(taskId);
+
+    qCDebug(lcApi) << "Sending ping with payload:" << message.body;
+    m_outbox->enqueue(message);
+}
 
-    // Handle timeout (30 detik)
-    QTimer::singleShot(30000, reply, &QNetworkReply::abort);
+void Logger::handlePingResponse(const QByteArray &responseData)
+{
+    QString responseText = QString::fromUtf8(responseData);
 
-    // Handle response
-    connect(reply, &QNetworkReply::finished, [this, reply]() {
-        QByteArray responseData = reply->readAll();
-        QString responseText = QString::fromUtf8(responseData);
+    QJsonParseError parseError;
+    QJsonDocument jsonDoc = QJsonDocument::fromJson(responseData, &parseError);
 
-        QJsonParseError parseError;
-        QJsonDocument jsonDoc = QJsonDocument::fromJson(responseData, &parseError);
+    bool showPopup = false;
+    QString popupMessage;
+    bool refreshRequired = false;
 
-        bool showPopup = false;
-        QString popupMessage;
-        bool refreshRequired = false;
+    if (parseError.error == QJsonParseError::NoError && jsonDoc.isObject()) {
+        QJsonObject jsonObj = jsonDoc.object();
 
-        if (parseError.error == QJsonParseError::NoError && jsonDoc.isObject()) {
-            QJsonObject jsonObj = jsonDoc.object();
+        // Server dapat mendorong versi pengaturan baru lewat respons ping
+        if (m_settings.applyServerSettings(m_productivityDb, jsonObj)) {
+            applySettings();
+        }
 
-            // Cek jika response meminta refresh
-            if (jsonObj.contains("refresh_required") && jsonObj["refresh_required"].toBool()) {
-                refreshRequired = true;
-                qDebug() << "Server requested application refresh";
-            }
+        // Cek jika response meminta refresh
+        if (jsonObj.contains("refresh_required") && jsonObj["refresh_required"].toBool()) {
+            refreshRequired = true;
+            qCDebug(lcApi) << "Server requested application refresh";
+        }
 
-            if (jsonObj.contains("success") && jsonObj["success"].isBool()) {
-                bool success = jsonObj["success"].toBool();
-                if (!success) {
-                    showPopup = true;
-                    popupMessage = "API returned error:\n\n" + responseText;
-                } else {
-                    qDebug() << "Success response from server:" << responseText;
-                }
-            } else {
+        if (jsonObj.contains("success") && jsonObj["success"].isBool()) {
+            bool success = jsonObj["success"].toBool();
+            if (!success) {
                 showPopup = true;
-                popupMessage = "Invalid response format (no 'success' field):\n\n" + responseText;
+                popupMessage = "API returned error:\n\n" + responseText;
+            } else {
+                qCDebug(lcApi) << "Success response from server:" << responseText;
             }
         } else {
             showPopup = true;
-            popupMessage = "Failed to parse JSON response:\n\n" + responseText;
+            popupMessage = "Invalid response format (no 'success' field):\n\n" + responseText;
         }
+    } else {
+        showPopup = true;
+        popupMessage = "Failed to parse JSON response:\n\n" + responseText;
+    }
 
-        if (reply->error() != QNetworkReply::NoError) {
-            showPopup = true;
-            popupMessage = "Network error:\n" + reply->errorString();
-        }
+    if (showPopup) {
+        QMessageBox::warning(nullptr, "API Response", popupMessage);
+    }
 
-        if (showPopup) {
-            QMessageBox::warning(nullptr, "API Response", popupMessage);
-        }
+    // Jika server meminta refresh, panggil refreshAll()
+    if (refreshRequired) {
+        qCDebug(lcApi) << "Performing application refresh as requested by server";
+        this->refreshAll();
+    }
+}
 
-        // Jika server meminta refresh, panggil refreshAll()
-        if (refreshRequired) {
-            qDebug() << "Performing application refresh as requested by server";
-            this->refreshAll();
+void Logger::handleOutboxDelivered(const QString &kind, const QString &tag, const QByteArray &responseBody)
+{
+    if (kind == "ping") {
+        handlePingResponse(responseBody);
+    } else if (kind == "end-implementation") {
+        QJsonObject jsonObj = QJsonDocument::fromJson(responseBody).object();
+        if (!jsonObj.value("success").toBool()) {
+            qWarning() << "end-implementation returned error:" << responseBody;
+        }
+    } else if (kind == "productivity-app") {
+        int userId = -1;
+        QDate date;
+        qint64 until = 0;
+        if (UsageReport::parseTag(tag, userId, date, until) && ensureProductivityDatabaseOpen()) {
+            m_usageReport.acknowledge(m_productivityDb, userId, date, until);
         }
+        qCDebug(lcApi) << "Usage report acknowledged up to" << until;
+    } else {
+        qCDebug(lcApi) << kind << "sent successfully. Response:" << responseBody;
+    }
+}
 
-        reply->deleteLater();
-    });
+void Logger::handleOutboxRejected(const QString &kind, int httpStatus, const QByteArray &responseBody)
+{
+    qWarning() << "Server rejected" << kind << "with HTTP" << httpStatus << ":" << responseBody;
 }
 
 
@@ -2521,13 +2424,13 @@ void Logger::startPingTimer(int taskId)
 
     // Mulai timer untuk ping berikutnya
     m_pingTimer.start();
-    qDebug() << "Started ping timer for client_id:" << m_currentUserId << "and task_id:" << taskId;
+    qCDebug(lcApi) << "Started ping timer for client_id:" << m_currentUserId << "and task_id:" << taskId;
 }
 
 void Logger::stopPingTimer()
 {
     m_pingTimer.stop();
-    qDebug() << "Stopped ping timer";
+    qCDebug(lcApi) << "Stopped ping timer";
 }
 
 
@@ -2545,147 +2448,140 @@ QString Logger::getUserPassword(const QString &username) {
 
 void Logger::updateTaskStatus(int taskId)
 {
-    if (!ensureProductivityDatabaseOpen()) {
-        qWarning() << "Cannot update task status: Database is not open";
-        return;
-    }
-
     if (m_currentUserId == -1) {
         qWarning() << "Cannot update task status: No user logged in";
         return;
     }
-
-    // Validasi taskId
     if (taskId <= 0) {
         qWarning() << "Invalid taskId:" << taskId;
         return;
     }
 
-    // Validasi task ID dan kepemilikan user
-    QSqlQuery query(m_productivityDb);
-    query.prepare("SELECT user_id FROM task WHERE id = :id");
-    query.bindValue(":id", taskId);
-    if (!query.exec() || !query.next()) {
-        qWarning() << "Task not found or invalid task ID:" << taskId;
-        return;
-    }
-    if (query.value(0).toInt() != m_currentUserId) {
-        qWarning() << "Task ID" << taskId << "does not belong to current user:" << m_currentUserId;
-        return;
-    }
-
-    // Buat URL dan request
-    QString url = QString("https://deskmon.pranala-dt.co.id/api/get-current-task-status/%1").arg(taskId);
-    if (url.isEmpty()) {
-        qWarning() << "URL is empty for taskId:" << taskId;
-        return;
-    }
-
-    QNetworkRequest request;
-    request.setUrl(QUrl(url));
-    request.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
-    if (!m_authToken.isEmpty()) {
-        request.setRawHeader("Authorization", "Bearer " + m_authToken.toUtf8());
-    } else {
-        qWarning() << "No authentication token available for taskId:" << taskId;
-        return;
-    }
-
-    // Kirim request
-    QNetworkReply *reply = m_networkManager->get(request);
-    connect(reply, &QNetworkReply::finished, this, [this, reply, taskId]() {
-        handleTaskStatusReply(reply, taskId);
-    });
+    // Permintaan eksplisit selalu ke server, tidak dilayani dari cache status
+    m_taskStatusSync->sync({taskId}, m_authToken, true);
 }
 
-void Logger::handleTaskStatusReply(QNetworkReply *reply, int taskId)
+// Dipanggil sekali per sync dengan status yang berubah; semua UPDATE dalam satu
+// transaksi, efek samping (task aktif, selesai, notifikasi) setelah commit
+void Logger::applyTaskStatuses(const QHash<int, QString> &statuses)
 {
-    if (reply->error() != QNetworkReply::NoError) {
-        qWarning() << "Failed to get task status for taskId" << taskId << ": Network error:" << reply->errorString();
-        reply->deleteLater();
-        return;
-    }
+    // Cache sync sudah mencatat status ini; jika tidak tersimpan, sync berikutnya
+    // harus menerapkannya lagi alih-alih menganggapnya tidak berubah
+    auto discard = [this, &statuses]() {
+        for (auto it = statuses.constBegin(); it != statuses.constEnd(); ++it) {
+            m_taskStatusSync->invalidate(it.key());
+        }
+    };
 
-    QByteArray responseData = reply->readAll();
-    QJsonDocument jsonDoc = QJsonDocument::fromJson(responseData);
-    if (jsonDoc.isNull() || !jsonDoc.isObject()) {
-        qWarning() << "Invalid JSON response for taskId" << taskId << ":" << responseData;
-        reply->deleteLater();
+    if (!ensureProductivityDatabaseOpen()) {
+        qWarning() << "Cannot apply task status: Database is not open";
+        discard();
         return;
     }
-
-    QJsonObject jsonObj = jsonDoc.object();
-    if (!jsonObj["success"].toBool()) {
-        qWarning() << "Task status API failed for taskId" << taskId << ":" << jsonObj["message"].toString();
-        reply->deleteLater();
+    if (m_currentUserId == -1) {
+        qWarning() << "Cannot apply task status: No user logged in";
+        discard();
         return;
     }
 
-    QString apiStatus = jsonObj["data"].toString();
-    if (apiStatus.isEmpty()) {
-        qWarning() << "No status data in response for taskId" << taskId;
-        reply->deleteLater();
-        return;
+    // Kepemilikan dicek sekali untuk semua task, bukan satu SELECT per task
+    QHash<int, QString> ownedTasks;
+    {
+        StatementCache::Query ownerQuery = StatementCache::get(m_productivityDb, StatementCache::TaskOwnedSelect);
+        if (!ownerQuery.isValid()) {
+            discard();
+            return;
+        }
+        ownerQuery->bindValue(":user_id", m_currentUserId);
+        if (!ownerQuery.exec()) {
+            qWarning() << "Failed to load tasks for status sync:" << ownerQuery->lastError().text();
+            discard();
+            return;
+        }
+        while (ownerQuery->next()) {
+            ownedTasks.insert(ownerQuery->value(0).toInt(), ownerQuery->value(1).toString());
+        }
     }
 
-    // Dapatkan nama task untuk notifikasi
-    QString taskName = getTaskName(taskId);
-
-
     // Petakan status API ke status database
-    QString dbStatus;
-    bool isReviewStatus = false;
-    bool isNeedReview = false;
-    bool isNeedRevise = false;
+    QVector<QPair<int, QString>> updates;
+    QList<int> completedTasks;
+    QList<int> reviewTasks;
+    int progressTaskId = -1;
+    for (auto it = statuses.constBegin(); it != statuses.constEnd(); ++it) {
+        const int taskId = it.key();
+        const QString &apiStatus = it.value();
+        if (!ownedTasks.contains(taskId)) {
+            qWarning() << "Task ID" << taskId << "does not belong to current user:" << m_currentUserId;
+            continue;
+        }
 
-    if (apiStatus == "created" || apiStatus == "pending") {
-        dbStatus = "Pending";
+        if (apiStatus == "created" || apiStatus == "pending") {
+            updates.append({taskId, QStringLiteral("Pending")});
+        } else if (apiStatus == "on-progress") {
+            updates.append({taskId, QStringLiteral("On Progress")});
+            progressTaskId = taskId;
+        } else if (apiStatus == "on-review") {
+            updates.append({taskId, QStringLiteral("Review")});
+            reviewTasks.append(taskId);
+        } else if (apiStatus == "need-review") {
+            updates.append({taskId, QStringLiteral("Need Review")});
+        } else if (apiStatus == "need-revise") {
+            updates.append({taskId, QStringLiteral("Need Revise")});
+        } else if (apiStatus == "completed") {
+            completedTasks.append(taskId);
+        } else {
+            qWarning() << "Unknown status for taskId" << taskId << ":" << apiStatus;
+        }
     }
-    else if (apiStatus == "on-progress") {
-        // aktifkan task ini langsung
-        setActiveTask(taskId);
-        m_isTaskPaused = false;
-        m_isTrackingActive = true;
-        m_taskStartTime = QDateTime::currentSecsSinceEpoch();
-        dbStatus = "On Progress";
 
-        QSqlQuery timeQuery(m_productivityDb);
-        timeQuery.prepare("SELECT time_usage FROM task WHERE id = :id");
-        timeQuery.bindValue(":id", taskId);
-        if (timeQuery.exec() && timeQuery.next()) {
-            m_taskTimeOffset = timeQuery.value(0).toInt();
+    if (!updates.isEmpty()) {
+        if (!m_productivityDb.transaction()) {
+            qWarning() << "Failed to begin task status transaction:" << m_productivityDb.lastError().text();
+            discard();
+            return;
         }
-
-        qDebug() << "Task with status 'on-progress' set as active from handleTaskStatusReply. Task ID:" << taskId;
-    }
-    else if (apiStatus == "on-review") {
-        dbStatus = "Review";
-        isReviewStatus = true;
-        QString message = QString("Task '%1' is under system review").arg(taskName);
-        emit taskReviewNotification(message);
-    }
-    else if (apiStatus == "need-review") {
-        dbStatus = "Need Review";
-        isNeedReview = true;
-    }
-    else if (apiStatus == "need-revise") {
-        dbStatus = "Need Revise";
-        isNeedRevise = true;
-    }
-    else if (apiStatus == "completed") {
-        dbStatus = "completed";
-        finishTask(taskId);
-        reply->deleteLater();
-        return;
+        StatementCache::Query query = StatementCache::get(m_productivityDb, StatementCache::TaskStatusUpdate);
+        if (!query.isValid()) {
+            m_productivityDb.rollback();
+            discard();
+            return;
+        }
+        for (const auto &update : std::as_const(updates)) {
+            query->bindValue(":status", update.second);
+            query->bindValue(":id", update.first);
+            query->bindValue(":user_id", m_currentUserId);
+            if (!query.exec()) {
+                qWarning() << "Failed to update task status for taskId" << update.first << ":" << query->lastError().text();
+                m_productivityDb.rollback();
+                discard();
+                return;
+            }
+        }
+        if (!m_productivityDb.commit()) {
+            qWarning() << "Failed to commit task status:" << m_productivityDb.lastError().text();
+            m_productivityDb.rollback();
+            discard();
+            return;
+        }
+        qCDebug(lcTasks) << "Applied" << updates.size() << "task status updates";
     }
-    else {
-        qWarning() << "Unknown status for taskId" << taskId << ":" << apiStatus;
-        reply->deleteLater();
-        return;
+
+    // Task yang sudah aktif di klien tidak di-set ulang (akan mengirim pause palsu)
+    if (progressTaskId != -1 && progressTaskId != m_activeTaskId) {
+        setActiveTask(progressTaskId);
+        m_isTaskPaused = false;
+        m_isTrackingActive = true;
+        m_taskStartTime = QDateTime::currentSecsSinceEpoch();
+        qCDebug(lcTasks) << "Task with status 'on-progress' set as active from status sync. Task ID:" << progressTaskId;
     }
 
-    // Hanya pause task jika status on-review (bukan Need Review)
-    if (isReviewStatus && m_activeTaskId == taskId) {
+    for (int taskId : std::as_const(reviewTasks)) {
+        emit taskReviewNotification(QString("Task '%1' is under system review").arg(ownedTasks.value(taskId)));
+        // Hanya pause task jika status on-review (bukan Need Review)
+        if (m_activeTaskId != taskId) {
+            continue;
+        }
         QSqlQuery pauseQuery(m_productivityDb);
         pauseQuery.prepare("UPDATE task SET active = 0, paused = 1 WHERE id = :id");
         pauseQuery.bindValue(":id", taskId);
@@ -2697,39 +2593,15 @@ void Logger::handleTaskStatusReply(QNetworkReply *reply, int taskId)
         }
     }
 
-    emit taskStatusChanged(taskId, dbStatus);
-
-    // Update database
-    QSqlQuery query(m_productivityDb);
-    query.prepare("UPDATE task SET status = :status WHERE id = :id AND user_id = :user_id");
-    query.bindValue(":status", dbStatus);
-    query.bindValue(":id", taskId);
-    query.bindValue(":user_id", m_currentUserId);
-    if (!query.exec()) {
-        qWarning() << "Failed to update task status for taskId" << taskId << ":" << query.lastError().text();
-    } else {
-        qDebug() << "Task status updated to" << dbStatus << "for taskId" << taskId;
-        // If task is active and status changed to Review, deselect it
-        if (dbStatus == "review" && m_activeTaskId == taskId) {
-            query.prepare("UPDATE task SET active = 0, paused = 0 WHERE id = :id");
-            query.bindValue(":id", taskId);
-            if (!query.exec()) {
-                qWarning() << "Failed to deselect task ID" << taskId << ":" << query.lastError().text();
-            } else {
-                m_activeTaskId = -1;
-                m_isTaskPaused = false;
-                qDebug() << "Deselected task ID" << taskId << "due to Review status";
-                emit activeTaskChanged();
-                emit taskPausedChanged();
-
-                QString pauseMessage = QString("Task '%1' has been paused automatically because it's under review.").arg(taskName);
-                emit taskReviewNotification(pauseMessage);
-            }
-        }
+    for (const auto &update : std::as_const(updates)) {
+        emit taskStatusChanged(update.first, update.second);
+    }
+    for (int taskId : std::as_const(completedTasks)) {
+        finishTask(taskId);
+    }
+    if (!updates.isEmpty()) {
         emit taskListChanged();
     }
-
-    reply->deleteLater();
 }
 
 QString Logger::getTaskName(int taskId)
@@ -2739,17 +2611,19 @@ QString Logger::getTaskName(int taskId)
         return "Unknown Task";
     }
 
-    QSqlQuery query(m_productivityDb);
-    query.prepare("SELECT task FROM task WHERE id = :id AND user_id = :user_id");
-    query.bindValue(":id", taskId);
-    query.bindValue(":user_id", m_currentUserId);
+    StatementCache::Query query = StatementCache::get(m_productivityDb, StatementCache::TaskNameSelect);
+    if (!query.isValid()) {
+        return "Unknown Task";
+    }
+    query->bindValue(":id", taskId);
+    query->bindValue(":user_id", m_currentUserId);
 
-    if (!query.exec() || !query.next()) {
-        qWarning() << "Failed to get task name for ID" << taskId << ":" << query.lastError().text();
+    if (!query.exec() || !query->next()) {
+        qWarning() << "Failed to get task name for ID" << taskId << ":" << query->lastError().text();
         return "Unknown Task";
     }
 
-    return query.value(0).toString();
+    return query->value(0).toString();
 }
 
 
@@ -2778,6 +2652,7 @@ void Logger::finishTask(int taskId)
         qWarning() << "Task ID" << taskId << "does not belong to current user:" << m_currentUserId;
         return;
     }
+    m_taskStatusSync->invalidate(taskId);
 
     QString projectName = query.value(1).toString();
     QString taskDesc = query.value(2).toString();
@@ -2806,6 +2681,8 @@ void Logger::finishTask(int taskId)
         qWarning() << "Failed to delete task:" << query.lastError().text();
         return;
     }
+    // Tabel task tidak lagi sama dengan respons terakhir; download berikutnya harus penuh
+    m_httpCache.invalidate(kTaskListCacheKey, m_currentUserId);
 
     if (m_activeTaskId == taskId) {
         m_activeTaskId = -1;
@@ -2859,7 +2736,7 @@ void Logger::toggleTaskPause()
         qWarning() << "No active task to pause/resume";
         return;
     }
-
+    m_taskStatusSync->invalidate(m_activeTaskId);
 
     // Get current timestamp in ISO format
     QString currentTime = QDateTime::currentDateTime().toString(Qt::ISODateWithMs);
@@ -2870,6 +2747,7 @@ void Logger::toggleTaskPause()
     try {
         if (!m_isTaskPaused) {
             // CASE 1: Pausing an active task (Play -> Pause)
+            flushPendingLogs();
 
             // 1. Update time_usage in task table
             qint64 currentEpoch = QDateTime::currentSecsSinceEpoch();
@@ -2918,7 +2796,7 @@ void Logger::toggleTaskPause()
             m_taskTimeOffset = timeUsed;
             m_pauseStartTime = currentEpoch;
 
-            qDebug() << "Task paused at" << currentTime;
+            qCDebug(lcTasks) << "Task paused at" << currentTime;
         } else {
             // CASE 2: Resuming a paused task (Pause -> Play)
 
@@ -2951,7 +2829,7 @@ void Logger::toggleTaskPause()
             m_taskStartTime = QDateTime::currentSecsSinceEpoch();
             m_pauseStartTime = 0;
 
-            qDebug() << "Task resumed at" << currentTime;
+            qCDebug(lcTasks) << "Task resumed at" << currentTime;
         }
 
 
@@ -2973,6 +2851,8 @@ void Logger::toggleTaskPause()
 void Logger::sendPausePlayDataToAPI(int taskId, const QString& startTime,
                                     const QString& endTime, const QString& status)
 {
+    Q_UNUSED(startTime);
+    Q_UNUSED(endTime);
 
     // 1. Validasi token
     if (m_authToken.isEmpty()) {
@@ -2982,7 +2862,7 @@ void Logger::sendPausePlayDataToAPI(int taskId, const QString& startTime,
 
     // 2. Hanya kirim payload jika status pause (stop)
     if (status != "pause") {
-        qDebug() << "Skip sending play status to API";
+        qCDebug(lcApi) << "Skip sending play status to API";
         return;
     }
 
@@ -2990,69 +2870,17 @@ void Logger::sendPausePlayDataToAPI(int taskId, const QString& startTime,
     QJsonObject payload;
     payload["status"] = "stop"; // Hanya kirim status stop
 
-    // 4. Konfigurasi request PUT
-    QNetworkRequest request;
-    QString url = QString("https://deskmon.pranala-dt.co.id/api/end-implementation/%1").arg(taskId);
-    request.setUrl(QUrl(url));
-    request.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
-    request.setRawHeader("Authorization", "Bearer " + m_authToken.toUtf8());
-
-    // 5. Debug output
-    qDebug() << "Sending PUT to:" << url;
-    qDebug() << "Payload:" << QJsonDocument(payload).toJson(QJsonDocument::Indented);
-
-    // 6. Kirim request PUT
-    QBuffer *buffer = new QBuffer();
-    buffer->setData(QJsonDocument(payload).toJson());
-    buffer->open(QIODevice::ReadOnly);
-
-    QNetworkReply* reply = m_networkManager->put(request, buffer);
-    buffer->setParent(reply);  // Auto-delete buffer ketika reply dihapus
-
-    // 7. Handle timeout (30 detik)
-    QTimer::singleShot(30000, reply, &QNetworkReply::abort);
-
-    // 8. Handle response
-    connect(reply, &QNetworkReply::finished, [this, reply]() {
-        QByteArray responseData = reply->readAll();
-        QString responseText = QString::fromUtf8(responseData);
-
-        QJsonParseError parseError;
-        QJsonDocument jsonDoc = QJsonDocument::fromJson(responseData, &parseError);
-
-        bool showPopup = false;
-        QString popupMessage;
-
-        if (parseError.error == QJsonParseError::NoError && jsonDoc.isObject()) {
-            QJsonObject jsonObj = jsonDoc.object();
-            if (jsonObj.contains("success") && jsonObj["success"].isBool()) {
-                bool success = jsonObj["success"].toBool();
-                if (!success) {
-                    showPopup = true;
-                    popupMessage = "API returned error:\n\n" + responseText;
-                } else {
-                    qDebug() << "Success response from server:" << responseText;
-                }
-            } else {
-                showPopup = true;
-                popupMessage = "Invalid response format (no 'success' field):\n\n" + responseText;
-            }
-        } else {
-            showPopup = true;
-            popupMessage = "Failed to parse JSON response:\n\n" + responseText;
-        }
-
-        if (reply->error() != QNetworkReply::NoError) {
-            showPopup = true;
-            popupMessage = "Network error:\n" + reply->errorString();
-        }
-
-        if (showPopup) {
-            QMessageBox::warning(nullptr, "API Response", popupMessage);
-        }
-
-        reply->deleteLater();
-    });
+    // 4. PUT lewat outbox; tidak digabung karena setiap stop adalah kejadian tersendiri
+    ApiOutbox::Message message;
+    message.kind = "end-implementation";
+    message.method = "PUT";
+    message.url = endpoint(QString("end-implementation/%1").arg(taskId));
+    message.body = QJsonDocument(payload).toJson(QJsonDocument::Compact);
+    message.token = m_authToken;
+    message.userId = m_currentUserId;
+
+    qCDebug(lcApi) << "Queueing PUT to:" << message.url.toString();
+    m_outbox->enqueue(message);
 }
 
 void Logger::revertTaskChange()
@@ -3108,7 +2936,7 @@ void Logger::revertTaskChange()
 //
 //    QString status = query.value(1).toString().toLower();
 //    if (status == "review") {
-//        qDebug() << "Skipping time update for task ID" << m_activeTaskId << "in Review status";
+//        qCDebug(lcTasks) << "Skipping time update for task ID" << m_activeTaskId << "in Review status";
 //        return;
 //    }
 //
@@ -3151,6 +2979,8 @@ QString Logger::debugShowRawData() const
         return "";
     }
 
+    m_logQueue.flush();
+
     QString result;
     QSqlQuery query(m_db);
     query.prepare("SELECT start_time, datetime(start_time, 'unixepoch', 'localtime') as start_date, app_name, title FROM log ORDER BY start_time DESC LIMIT 10");
@@ -3170,24 +3000,31 @@ QString Logger::debugShowRawData() const
 
 void Logger::showLogs()
 {
-    emit logContentChanged();
+    scheduleLogContentRefresh();
 }
 
-bool Logger::authenticate(const QString &loginInput, const QString &password)
+void Logger::authenticate(const QString &loginInput, const QString &password)
 {
+    if (m_loginInProgress) {
+        qWarning() << "Login already in progress, ignoring new request";
+        return;
+    }
+
     if (!ensureDatabaseOpen()) {
         qWarning() << "Cannot authenticate: Database is not open";
-        return false;
+        emit loginCompleted(false, "Database is not open");
+        return;
     }
 
     // Deteksi apakah input adalah email atau username
     bool isEmail = loginInput.contains("@");
     QString loginType = isEmail ? "email" : "username";
-    qDebug() << "Attempting login with" << loginType << ":" << loginInput;
+    qCDebug(lcAuth) << "Attempting login with" << loginType << ":" << loginInput;
 
-    // 1. Buat HTTP request ke API
-    QNetworkRequest request(QUrl("https://deskmon.pranala-dt.co.id/api/login"));
+    // 1. Buat HTTP request ke API, dengan batas waktu agar UI tidak menunggu tanpa akhir
+    QNetworkRequest request(endpoint("login"));
     request.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
+    request.setTransferTimeout(kLoginTimeoutMs);
 
     QJsonObject jsonPayload;
     if (isEmail) {
@@ -3204,119 +3041,168 @@ bool Logger::authenticate(const QString &loginInput, const QString &password)
         }
     }
     jsonPayload["password"] = password;
-    QJsonDocument doc(jsonPayload);
-    QByteArray data = doc.toJson();
+    QByteArray data = QJsonDocument(jsonPayload).toJson(QJsonDocument::Compact);
+
+    qCDebug(lcAuth) << "Sending login request for" << jsonPayload["email"].toString();
 
-    qDebug() << "Sending login request with payload:" << doc.toJson(QJsonDocument::Compact);
+    // Password mentah tidak disimpan; cukup hash untuk fallback lokal dan upsert
+    m_loginInput = loginInput;
+    m_loginPasswordHash = hashPassword(password);
+    const quint64 attempt = ++m_loginAttempt;
+    setLoginInProgress(true);
 
-    // 2. Kirim request dan tunggu response
+    // 2. Kirim request; hasil diproses di handleLoginResponse tanpa event loop bersarang
     QNetworkReply *reply = m_networkManager->post(request, data);
-    QEventLoop loop;
-    connect(reply, &QNetworkReply::finished, &loop, &QEventLoop::quit);
-    loop.exec();
+    PerfStats::trackReply(reply, "api.login");
+    m_loginReply = reply;
+    connect(reply, &QNetworkReply::finished, this, [this, reply, attempt]() {
+        handleLoginResponse(reply, attempt);
+    });
+}
+
+void Logger::cancelLogin()
+{
+    if (!m_loginInProgress) {
+        return;
+    }
+
+    qCDebug(lcAuth) << "Login cancelled by user";
+    ++m_loginAttempt; // Hasil reply/upsert yang masih berjalan akan diabaikan
+    if (m_loginReply) {
+        m_loginReply->abort();
+    }
+    m_loginReply = nullptr;
+    m_loginPasswordHash.clear();
+    setLoginInProgress(false);
+    emit loginCompleted(false, "Login cancelled");
+}
+
+void Logger::setLoginInProgress(bool inProgress)
+{
+    if (m_loginInProgress != inProgress) {
+        m_loginInProgress = inProgress;
+        emit loginInProgressChanged();
+    }
+}
+
+void Logger::handleLoginResponse(QNetworkReply *reply, quint64 attempt)
+{
+    reply->deleteLater();
+    if (attempt != m_loginAttempt) {
+        return; // Sudah dibatalkan atau digantikan percobaan lain
+    }
+    m_loginReply = nullptr;
 
     // 3. Handle response dari API
     if (reply->error() == QNetworkReply::NoError) {
         QByteArray response = reply->readAll();
-        QJsonDocument jsonResponse = QJsonDocument::fromJson(response);
-        QJsonObject jsonObj = jsonResponse.object();
-
-        qDebug() << "API Response:" << jsonResponse.toJson(QJsonDocument::Compact);
+        QJsonObject jsonObj = QJsonDocument::fromJson(response).object();
 
         if (jsonObj["success"].toBool()) {
             // Jika API login berhasil
-            qDebug() << "API login successful. Storing user data...";
+            qCDebug(lcAuth) << "API login successful. Storing user data...";
 
             // 5. Parse data user dari response
+            LoginUser user;
             QJsonObject userData = jsonObj["user"].toObject();
-            int userId = userData["id"].toInt();
-            QString username = userData["name"].toString();
-            QString userEmail = userData["email"].toString();
-            QString role = userData["role"].toObject()["rolename"].toString();
-            QString token = jsonObj["token"].toString();
-            // 6. Siapkan dan eksekusi query untuk menyimpan data ke database
-            QSqlQuery query(m_db);
-            query.prepare(
-                "INSERT OR REPLACE INTO users "
-                "(id, username, password, email, role, token) "
-                "VALUES (:id, :username, :password, :email, :role, :token)"
-                );
-            query.bindValue(":id", userId);
-            query.bindValue(":username", username);
-            query.bindValue(":password", hashPassword(password)); // Hash password
-            query.bindValue(":email", userEmail);
-            query.bindValue(":role", role);
-            query.bindValue(":token", token);
-
-            if (!query.exec()) {
-                qWarning() << "Gagal menyimpan user ke database lokal:" << query.lastError();
-            } else {
-                qDebug() << "Data user tersimpan di database lokal. ID:" << userId;
-            }
-
-
-
-            m_isTokenErrorVisible = false;
-
-            m_workTimer.start(1000);
-            m_workTimer.start();
-            // Lanjutkan sisa proses
-            setCurrentUserInfo(userId, username, userEmail);
-            checkAndCreateNewDayRecord();
-            loadWorkTimeData();
-            startGlobalTimer();
-            syncActiveTask();
-            fetchAndStoreTasks();
-            m_usageReportTimer.start();
-            m_isTrackingActive = true;
-            m_isTaskPaused = false;
-            m_pauseStartTime = 0;
-
-
-            reply->deleteLater();
-            return true;
-        } else {
-            qWarning() << "API Login failed:" << jsonObj["message"].toString();
+            user.id = userData["id"].toInt();
+            user.username = userData["name"].toString();
+            user.email = userData["email"].toString();
+            user.role = userData["role"].toObject()["rolename"].toString();
+            user.token = jsonObj["token"].toString();
+            user.passwordHash = m_loginPasswordHash;
+
+            // 6. Simpan user ke database lokal di thread lain lewat koneksi tersendiri
+            auto *watcher = new QFutureWatcher<bool>(this);
+            connect(watcher, &QFutureWatcher<bool>::finished, this, [this, watcher, user, attempt]() {
+                watcher->deleteLater();
+                if (attempt != m_loginAttempt) {
+                    return;
+                }
+                if (!watcher->result()) {
+                    qWarning() << "Gagal menyimpan user ke database lokal. ID:" << user.id;
+                } else {
+                    qCDebug(lcAuth) << "Data user tersimpan di database lokal. ID:" << user.id;
+                }
+                finishApiLogin(user.id, user.username, user.email, user.token);
+            });
+            watcher->setFuture(QtConcurrent::run(upsertLoginUser, m_db.databaseName(), user));
+            return;
         }
+        qWarning() << "API Login failed:" << jsonObj["message"].toString();
+    } else if (reply->error() == QNetworkReply::OperationCanceledError) {
+        qWarning() << "API login timed out after" << kLoginTimeoutMs << "ms";
     } else {
         qWarning() << "Network error during API login:" << reply->errorString();
     }
 
     // Jika kode sampai di sini, artinya API login gagal. Lakukan fallback ke login lokal.
-    qDebug() << "Attempting local login fallback...";
+    bool success = tryLocalLogin();
+    m_loginPasswordHash.clear();
+    setLoginInProgress(false);
+    if (!success) {
+        qCDebug(lcAuth) << "Login failed completely (API and Local).";
+    }
+    emit loginCompleted(success, success ? QString() : QStringLiteral("Invalid username or password"));
+}
+
+void Logger::finishApiLogin(int userId, const QString &username, const QString &email, const QString &token)
+{
+    m_authToken = token;
+    m_isTokenErrorVisible = false;
+    // Pesan yang tertahan karena token lama ditolak dikirim ulang dengan token ini
+    m_outbox->reauthenticate(userId, token);
+
+    m_workTimer.start(1000);
+    // Lanjutkan sisa proses
+    setCurrentUserInfo(userId, username, email);
+    checkAndCreateNewDayRecord();
+    loadWorkTimeData();
+    startGlobalTimer();
+    syncActiveTask();
+    fetchAndStoreTasks();
+    m_usageReportTimer.start();
+    m_isTrackingActive = true;
+    m_isTaskPaused = false;
+    m_pauseStartTime = 0;
+
+    m_loginPasswordHash.clear();
+    setLoginInProgress(false);
+    emit loginCompleted(true, QString());
+}
+
+bool Logger::tryLocalLogin()
+{
+    qCDebug(lcAuth) << "Attempting local login fallback...";
     QSqlQuery localQuery(m_db);
     localQuery.prepare("SELECT id, username, email, password, token FROM users WHERE email = :loginInput OR username = :loginInput");
-    localQuery.bindValue(":loginInput", loginInput);
-
-    if (localQuery.exec() && localQuery.next()) {
-        if (localQuery.value(3).toString() == hashPassword(password)) {
-            // Login lokal berhasil
-            int userId = localQuery.value(0).toInt();
-            QString username = localQuery.value(1).toString();
-            QString userEmail = localQuery.value(2).toString();
-            m_authToken = localQuery.value(4).toString();
-
-            qDebug() << "Local login successful for user:" << username;
-            qDebug() << "Using stored token:" << (m_authToken.isEmpty() ? "No token" : "Token available");
-
-            setCurrentUserInfo(userId, username, userEmail);
-            checkAndCreateNewDayRecord();
-
-            m_workTimer.start(1000);
-            m_workTimer.start();
-            loadWorkTimeData();
-            startGlobalTimer();
-            syncActiveTask();
-            if (!m_authToken.isEmpty()) { fetchAndStoreTasks(); }
-
-            reply->deleteLater();
-            return true;
-        }
+    localQuery.bindValue(":loginInput", m_loginInput);
+
+    if (!localQuery.exec() || !localQuery.next()) {
+        return false;
+    }
+    if (localQuery.value(3).toString() != m_loginPasswordHash) {
+        return false;
     }
 
-    qDebug() << "Login failed completely (API and Local).";
-    reply->deleteLater();
-    return false;
+    // Login lokal berhasil
+    int userId = localQuery.value(0).toInt();
+    QString username = localQuery.value(1).toString();
+    QString userEmail = localQuery.value(2).toString();
+    m_authToken = localQuery.value(4).toString();
+
+    qCDebug(lcAuth) << "Local login successful for user:" << username;
+    qCDebug(lcAuth) << "Using stored token:" << (m_authToken.isEmpty() ? "No token" : "Token available");
+
+    setCurrentUserInfo(userId, username, userEmail);
+    checkAndCreateNewDayRecord();
+
+    m_workTimer.start(1000);
+    loadWorkTimeData();
+    startGlobalTimer();
+    syncActiveTask();
+    if (!m_authToken.isEmpty()) { fetchAndStoreTasks(); }
+    return true;
 }
 
 // Helper function untuk set current user info dan emit signals
@@ -3332,7 +3218,12 @@ void Logger::setCurrentUserInfo(int userId, const QString &username, const QStri
     emit currentUserEmailChanged();
     emit userEmailChanged();
 
-    qDebug() << "Current user set - ID:" << userId << ", Username:" << username << ", Email:" << email;
+    qCDebug(lcAuth) << "Current user set - ID:" << userId << ", Username:" << username << ", Email:" << email;
+}
+
+QVariantMap Logger::perfSnapshot() const
+{
+    return PerfStats::snapshot();
 }
 
 QString Logger::getCurrentToken() const {
@@ -3352,7 +3243,7 @@ void Logger::clearToken() {
         }
     }
 
-    qDebug() << "Token cleared from memory and database";
+    qCDebug(lcAuth) << "Token cleared from memory and database";
 }
 
 QString Logger::getUserEmail(const QString &username)
@@ -3368,7 +3259,7 @@ QString Logger::getUserEmail(const QString &username)
 
     if (query.exec() && query.next()) {
         QString email = query.value(0).toString();
-        qDebug() << "Found email for user" << username << ":" << email;
+        qCDebug(lcAuth) << "Found email for user" << username << ":" << email;
         return email;
     }
 
@@ -3389,7 +3280,7 @@ QString Logger::getUserDepartment(const QString &username)
 
     if (query.exec() && query.next()) {
         QString dept = query.value(0).toString();
-        qDebug() << "Found department/role for user" << username << ":" << dept;
+        qCDebug(lcAuth) << "Found department/role for user" << username << ":" << dept;
         return dept;
     }
 
@@ -3463,7 +3354,7 @@ QString Logger::updateUserProfile(const QString &currentUsername, const QString
         return "User not found";
     }
 
-    qDebug() << "User profile updated successfully for:" << newUsername;
+    qCDebug(lcUi) << "User profile updated successfully for:" << newUsername;
     return "";
 }
 
@@ -3478,7 +3369,7 @@ QString Logger::cropProfileImage(const QString &imagePath, qreal x, qreal y, qre
         localPath = localPath.mid(7);
     }
 
-    qDebug() << "Cropping image from path:" << localPath;
+    qCDebug(lcUi) << "Cropping image from path:" << localPath;
 
     QFileInfo fileInfo(localPath);
     if (!fileInfo.exists()) {
@@ -3507,7 +3398,7 @@ QString Logger::cropProfileImage(const QString &imagePath, qreal x, qreal y, qre
     cropX = qMax(0, qMin(cropX, image.width() - cropSize));
     cropY = qMax(0, qMin(cropY, image.height() - cropSize));
 
-    qDebug() << "Crop parameters: x=" << cropX << ", y=" << cropY << ", size=" << cropSize;
+    qCDebug(lcUi) << "Crop parameters: x=" << cropX << ", y=" << cropY << ", size=" << cropSize;
 
     QImage cropped = image.copy(cropX, cropY, cropSize, cropSize);
     if (cropped.isNull()) {
@@ -3548,7 +3439,7 @@ QString Logger::cropProfileImage(const QString &imagePath, qreal x, qreal y, qre
         return "";
     }
 
-    qDebug() << "Cropped image saved for user" << username << "to:" << outputPath;
+    qCDebug(lcUi) << "Cropped image saved for user" << username << "to:" << outputPath;
 
     return QUrl::fromLocalFile(outputPath).toString() + "?t=" + QString::number(QDateTime::currentMSecsSinceEpoch());
 }
@@ -3562,25 +3453,27 @@ QString Logger::getUsernameById(int userId) const
         return "";
     }
 
-    QSqlQuery query(m_db);
-    query.prepare("SELECT username FROM users WHERE id = :id");
-    query.bindValue(":id", userId);
+    StatementCache::Query query = StatementCache::get(m_db, StatementCache::UsernameSelect);
+    if (!query.isValid()) {
+        return "";
+    }
+    query->bindValue(":id", userId);
 
-    if (!query.exec() || !query.next()) {
-        qWarning() << "Failed to retrieve username:" << query.lastError().text();
+    if (!query.exec() || !query->next()) {
+        qWarning() << "Failed to retrieve username:" << query->lastError().text();
         return "";
     }
 
-    return query.value(0).toString();
+    return query->value(0).toString();
 }
 
 void Logger::clearLogFilter()
 {
     m_startDateFilter = "";
     m_endDateFilter = "";
-    emit logContentChanged();
-    emit logCountChanged();
-    emit productivityStatsChanged();
+    refreshLogEntries();
+    scheduleLogContentRefresh();
+    invalidateUsageModels();
 }
 
 void Logger::logActiveWindow()
@@ -3606,7 +3499,11 @@ void Logger::logActiveWindow()
 
     if (currentInfo.appName != m_lastWindowInfo.appName ||
         currentInfo.title != m_lastWindowInfo.title) {
-        logWindowChange(m_lastWindowInfo, m_lastActivityTime, currentTime - 1);
+        // Segmen berikutnya dimulai tepat saat segmen ini berakhir; perpindahan
+        // di bawah satu detik tidak punya durasi yang bisa disimpan
+        if (currentTime > m_lastActivityTime) {
+            logWindowChange(m_lastWindowInfo, m_lastActivityTime, currentTime);
+        }
         m_lastActivityTime = currentTime;
         m_lastWindowInfo = currentInfo;
     }
@@ -3631,20 +3528,22 @@ void Logger::syncActiveTask()
         return;
     }
 
-    // 3. Debug: Tampilkan semua tugas untuk pengguna saat ini
-    QSqlQuery debugQuery(m_productivityDb);
-    debugQuery.prepare("SELECT id, active, user_id, status FROM task WHERE user_id = :user_id");
-    debugQuery.bindValue(":user_id", m_currentUserId);
-    if (debugQuery.exec()) {
-        qDebug() << "Daftar tugas untuk user_id" << m_currentUserId << ":";
-        while (debugQuery.next()) {
-            qDebug() << "ID:" << debugQuery.value(0).toInt()
-            << "Active:" << debugQuery.value(1).toBool()
-            << "User ID:" << debugQuery.value(2).toInt()
-            << "Status:" << debugQuery.value(3).toString();
+    // 3. Debug: Tampilkan semua tugas untuk pengguna saat ini (query hanya jalan jika kategori aktif)
+    if (lcTasks().isDebugEnabled()) {
+        QSqlQuery debugQuery(m_productivityDb);
+        debugQuery.prepare("SELECT id, active, user_id, status FROM task WHERE user_id = :user_id");
+        debugQuery.bindValue(":user_id", m_currentUserId);
+        if (debugQuery.exec()) {
+            qCDebug(lcTasks) << "Daftar tugas untuk user_id" << m_currentUserId << ":";
+            while (debugQuery.next()) {
+                qCDebug(lcTasks) << "ID:" << debugQuery.value(0).toInt()
+                << "Active:" << debugQuery.value(1).toBool()
+                << "User ID:" << debugQuery.value(2).toInt()
+                << "Status:" << debugQuery.value(3).toString();
+            }
+        } else {
+            qWarning() << "Gagal menampilkan daftar tugas:" << debugQuery.lastError().text();
         }
-    } else {
-        qWarning() << "Gagal menampilkan daftar tugas:" << debugQuery.lastError().text();
     }
 
     // 4. Ambil semua tugas dari database lokal untuk pengguna saat ini
@@ -3684,7 +3583,7 @@ void Logger::syncActiveTask()
             m_taskTimeOffset = query.value(2).toInt();
             m_taskStartTime = QDateTime::currentSecsSinceEpoch();
             hasActiveTask = true;
-            qDebug() << "Active task synchronized: ID =" << m_activeTaskId << ", Paused =" << m_isTaskPaused;
+            qCDebug(lcTasks) << "Active task synchronized: ID =" << m_activeTaskId << ", Paused =" << m_isTaskPaused;
         }
     }
 
@@ -3694,16 +3593,14 @@ void Logger::syncActiveTask()
         m_isTaskPaused = false;
         m_taskTimeOffset = 0;
         m_taskStartTime = 0;
-        qDebug() << "No active task found for user_id:" << m_currentUserId;
+        qCDebug(lcTasks) << "No active task found for user_id:" << m_currentUserId;
     }
 
     // 8. Sinkronkan semua tugas dengan server
     fetchAndStoreTasks();
 
-    // 9. Perbarui status setiap tugas dari server
-    for (int taskId : taskIds) {
-        updateTaskStatus(taskId);
-    }
+    // 9. Status semua tugas dalam satu request bulk (atau per task jika server lama)
+    m_taskStatusSync->sync(taskIds, m_authToken);
 
     // 10. Emit sinyal untuk memberitahu perubahan ke UI
     emit activeTaskChanged();
@@ -3730,22 +3627,22 @@ void Logger::logIdle(qint64 startTime, qint64 endTime)
         return;
     }
 
-    QSqlQuery query(m_db);
-    query.prepare("INSERT INTO log (id_user, start_time, end_time, app_name, title) "
-                  "VALUES (:id_user, :start, :end, :app, :title)");
-    query.bindValue(":id_user", m_currentUserId);
-    query.bindValue(":start", startTime);
-    query.bindValue(":end", endTime);
-    query.bindValue(":app", QString("Idle"));
-    query.bindValue(":title", QString("No active window"));
+    LogWriteQueue::Segment segment;
+    segment.userId = m_currentUserId;
+    segment.startTime = startTime;
+    segment.endTime = endTime;
+    segment.appName = QStringLiteral("Idle");
+    segment.title = QStringLiteral("No active window");
+    m_logQueue.enqueue(segment);
 
-    if (!query.exec()) {
-        qWarning() << "Failed to log idle time:" << query.lastError().text();
+    if (m_rollupLoading) {
+        m_rollupBacklog.append(segment);
     } else {
-        emit logCountChanged();
-        emit logContentChanged();
-        emit productivityStatsChanged();
+        m_rollup.addSegment(m_currentUserId, startTime, endTime, segment.appName, QString(), m_ruleIndex);
+        addSegmentToUsageModels(startTime, endTime, segment.appName, QString());
     }
+    m_logEntryModel->insertSegment(m_currentUserId, startTime, endTime, segment.appName, segment.title, QString());
+    scheduleStatsRefresh();
 }
 
 void Logger::logWindowChange(const Logger::WindowInfo &info, qint64 startTime, qint64 endTime)
@@ -3764,33 +3661,55 @@ void Logger::logWindowChange(const Logger::WindowInfo &info, qint64 startTime, q
         return;
     }
 
-    QSqlQuery query(m_db);
-    query.prepare("INSERT INTO log (id_user, start_time, end_time, app_name, title, url) "
-                  "VALUES (:id_user, :start, :end, :app, :title, :url)");
-    query.bindValue(":id_user", m_currentUserId);
-    query.bindValue(":start", startTime);
-    query.bindValue(":end", endTime);
-    query.bindValue(":app", info.appName);
-    query.bindValue(":title", info.title);
-    query.bindValue(":url", info.url.isEmpty() ? QVariant() : info.url);
+    // Ditulis batch oleh m_logQueue; rollup langsung diperbarui agar statistik tetap real-time
+    LogWriteQueue::Segment segment;
+    segment.userId = m_currentUserId;
+    segment.startTime = startTime;
+    segment.endTime = endTime;
+    segment.appName = info.appName;
+    segment.title = info.title;
+    segment.url = info.url;
+    m_logQueue.enqueue(segment);
 
-    if (!query.exec()) {
-        qWarning() << "Failed to log window change:" << query.lastError().text();
+    if (m_rollupLoading) {
+        m_rollupBacklog.append(segment);
     } else {
-        emit logCountChanged();
-        emit logContentChanged();
-        emit productivityStatsChanged();
+        m_rollup.addSegment(m_currentUserId, startTime, endTime, info.appName, info.url, m_ruleIndex);
+        addSegmentToUsageModels(startTime, endTime, info.appName, info.url);
+    }
+    m_logEntryModel->insertSegment(m_currentUserId, startTime, endTime, info.appName, info.title, info.url);
+    scheduleStatsRefresh();
+}
+
+void Logger::flushPendingLogs()
+{
+    if (m_storage->isStopped()) {
+        // Shutdown: sisa buffer ditulis langsung di koneksi GUI
+        if (ensureDatabaseOpen()) {
+            m_logQueue.writePending(m_db);
+        }
+        return;
     }
+    m_logQueue.flush();
+}
+
+void Logger::refreshLogEntries()
+{
+    // Segmen di buffer harus sudah ada di tabel sebelum halaman pertama dibaca
+    m_logQueue.flush();
+    m_logEntryModel->reset(m_currentUserId,
+                           QDate::fromString(m_startDateFilter, Qt::ISODate),
+                           QDate::fromString(m_endDateFilter, Qt::ISODate));
 }
 
 void Logger::setLogFilter(const QString &startDate, const QString &endDate)
 {
-    qDebug() << "Setting log filter - Start Date:" << startDate << "End Date:" << endDate;
+    qCDebug(lcTracking) << "Setting log filter - Start Date:" << startDate << "End Date:" << endDate;
     m_startDateFilter = startDate;
     m_endDateFilter = endDate;
-    emit logContentChanged();
-    emit logCountChanged();
-    emit productivityStatsChanged();
+    refreshLogEntries();
+    scheduleLogContentRefresh();
+    invalidateUsageModels();
 }
 
 bool Logger::updateProfileImage(const QString &username, const QString &imagePath)
@@ -3829,7 +3748,7 @@ bool Logger::updateProfileImage(const QString &username, const QString &imagePat
             if (!oldFile.remove()) {
                 qWarning() << "Failed to delete old profile image:" << localOldPath;
             } else {
-                qDebug() << "Deleted old profile image for" << username << ":" << localOldPath;
+                qCDebug(lcUi) << "Deleted old profile image for" << username << ":" << localOldPath;
             }
         }
     }
@@ -3850,7 +3769,7 @@ bool Logger::updateProfileImage(const QString &username, const QString &imagePat
         return false;
     }
 
-    qDebug() << "Profile image updated successfully for" << username << "to" << imagePath;
+    qCDebug(lcUi) << "Profile image updated successfully for" << username << "to" << imagePath;
 
     // Emit signal with a unique path (already includes timestamp from cropProfileImage)
     emit profileImageChanged(username, imagePath);
@@ -3869,17 +3788,19 @@ QString Logger::getProfileImagePath(const QString &username)
         return "";
     }
 
-    QSqlQuery query(m_db);
-    query.prepare("SELECT profile_image FROM users WHERE username = :username");
-    query.bindValue(":username", username);
+    StatementCache::Query query = StatementCache::get(m_db, StatementCache::ProfileImageSelect);
+    if (!query.isValid()) {
+        return "";
+    }
+    query->bindValue(":username", username);
 
     if (!query.exec()) {
-        qWarning() << "Failed to retrieve profile image path:" << query.lastError().text();
+        qWarning() << "Failed to retrieve profile image path:" << query->lastError().text();
         return "";
     }
 
-    if (query.next()) {
-        QString imagePath = query.value(0).toString();
+    if (query->next()) {
+        QString imagePath = query->value(0).toString();
         if (imagePath.isEmpty()) {
             return "";
         }
@@ -3892,6 +3813,7 @@ QString Logger::getProfileImagePath(const QString &username)
 
 Logger::WindowInfo Logger::getActiveWindowInfo()
 {
+    ScopedPerfTimer perf("probe.window");
 #ifdef Q_OS_WIN
     return getActiveWindowInfoWindows();
 #elif defined(Q_OS_MACOS)
@@ -3947,11 +3869,11 @@ Logger::WindowInfo Logger::getActiveWindowInfoMacOS() {
 
         if (appProcess.waitForFinished(5000)) {
             info.appName = QString(appProcess.readAllStandardOutput()).trimmed();
-            qDebug() << "App name:" << info.appName;
+            qCDebug(lcTracking) << "App name:" << info.appName;
         } else {
             appProcess.kill();
-            qDebug() << "App name script timed out";
-            qDebug() << "Error:" << appProcess.readAllStandardError();
+            qCDebug(lcTracking) << "App name script timed out";
+            qCDebug(lcTracking) << "Error:" << appProcess.readAllStandardError();
         }
     }
 
@@ -3965,11 +3887,11 @@ Logger::WindowInfo Logger::getActiveWindowInfoMacOS() {
 
         if (titleProcess.waitForFinished(5000)) {
             info.title = QString(titleProcess.readAllStandardOutput()).trimmed();
-            qDebug() << "Window title:" << info.title;
+            qCDebug(lcTracking) << "Window title:" << info.title;
         } else {
             titleProcess.kill();
-            qDebug() << "Window title script timed out";
-            qDebug() << "Error:" << titleProcess.readAllStandardError();
+            qCDebug(lcTracking) << "Window title script timed out";
+            qCDebug(lcTracking) << "Error:" << titleProcess.readAllStandardError();
         }
     }
 
@@ -3982,40 +3904,15 @@ Logger::WindowInfo Logger::getActiveWindowInfoMacOS() {
 Logger::WindowInfo Logger::getActiveWindowInfoLinux() {
     WindowInfo info;
 
-    // Coba dengan xdotool (lebih umum di Linux)
-    QProcess process;
-    process.start("xdotool", {"getwindowfocus", "getwindowname"});
-    if (process.waitForFinished(100)) {
-        info.title = QString(process.readAllStandardOutput()).trimmed();
-    }
-
-    process.start("xdotool", {"getwindowfocus", "getwindowpid"});
-    if (process.waitForFinished(100)) {
-        QString pid = QString(process.readAllStandardOutput()).trimmed();
-        if (!pid.isEmpty()) {
-            process.start("ps", {"-p", pid, "-o", "comm="});
-            if (process.waitForFinished(100)) {
-                info.appName = QString(process.readAllStandardOutput()).trimmed();
-            }
-        }
-    }
-
-    if (info.title.isEmpty()) {
-        process.start("wmctrl", {"-l"});
-        if (process.waitForFinished(100)) {
-            QStringList windows = QString(process.readAllStandardOutput()).split('\n', Qt::SkipEmptyParts);
-            for (const QString &window : windows) {
-                QStringList parts = window.split(' ', Qt::SkipEmptyParts);
-                if (parts.size() >= 4 && parts[0].contains("0x")) {
-                    info.title = parts.mid(3).join(' ');
-                    break;
-                }
-            }
-        }
+    // Satu koneksi X11 yang persisten, tanpa spawn xdotool/ps/wmctrl setiap detik
+    X11WindowProbe::Result window;
+    if (m_windowProbe.probe(window)) {
+        info.title = window.title;
+        info.appName = window.appName;
     }
 
     // Setelah mendapatkan info dasar, coba dapatkan URL
-    info.url = getBrowserUrlLinux();
+    info.url = getBrowserUrlLinux(info.title);
 
     if (info.appName.isEmpty()) info.appName = "Unknown";
     if (info.title.isEmpty()) info.title = "No active window";
@@ -4168,18 +4065,13 @@ QString Logger::getBrowserUrlWindows(HWND hwnd) {
 
     return url;
 }
-#elif
-QString Logger::getBrowserUrlLinux() {
+#elif defined(Q_OS_LINUX)
+QString Logger::getBrowserUrlLinux(const QString &title) {
     // Metode ini tidak andal, hanya sebagai fallback.
-    QProcess process;
-    process.start("xdotool", {"getactivewindow", "getwindowname"});
-    if (process.waitForFinished(100)) {
-        QString title = QString(process.readAllStandardOutput()).trimmed();
-        QRegularExpression urlRegex(R"(https?://[^\s/$.?#].[^\s]*)");
-        QRegularExpressionMatch match = urlRegex.match(title);
-        if (match.hasMatch()) {
-            return match.captured(0);
-        }
+    static const QRegularExpression urlRegex(R"(https?://[^\s/$.?#].[^\s]*)");
+    QRegularExpressionMatch match = urlRegex.match(title);
+    if (match.hasMatch()) {
+        return match.captured(0);
     }
     return "";
 }
@@ -13,10 +13,27 @@
 #include <QJsonObject>
 #include <QNetworkRequest>
 #include <QEventLoop>
+#include <QPointer>
 #include <QDate>
 
+#include "ruleindex.h"
+#include "activityrollup.h"
+#include "settingscache.h"
+#include "logwritequeue.h"
+#include "sqlitesetup.h"
+#include "logentrymodel.h"
+#include "usagemodel.h"
+#include "tasklistmodel.h"
+#include "apioutbox.h"
+#include "taskstatussync.h"
+#include "usagereport.h"
+#include "httpcache.h"
+#include "storageworker.h"
+
 #ifdef Q_OS_WIN
 #include <windows.h>
+#elif !defined(Q_OS_MACOS)
+#include "x11windowprobe.h"
 #endif
 
 #include <QObject>
@@ -29,8 +46,13 @@ class Logger : public QObject
     Q_PROPERTY(QString currentWindowTitle READ currentWindowTitle NOTIFY currentWindowTitleChanged)
     Q_PROPERTY(int logCount READ logCount NOTIFY logCountChanged)
     Q_PROPERTY(QString logContent READ logContent NOTIFY logContentChanged)
+    Q_PROPERTY(QAbstractItemModel* logEntries READ logEntries CONSTANT)
+    Q_PROPERTY(QAbstractItemModel* appUsage READ appUsage CONSTANT)
+    Q_PROPERTY(QAbstractItemModel* domainUsage READ domainUsage CONSTANT)
     Q_PROPERTY(QVariantMap productivityStats READ productivityStats NOTIFY productivityStatsChanged)
     Q_PROPERTY(QVariantList taskList READ taskList NOTIFY taskListChanged)
+    Q_PROPERTY(QAbstractItemModel* tasks READ tasks CONSTANT)
+    Q_PROPERTY(QObject* activeTask READ activeTask CONSTANT)
     Q_PROPERTY(int activeTaskId READ activeTaskId NOTIFY activeTaskChanged)
     Q_PROPERTY(bool isTaskPaused READ isTaskPaused NOTIFY taskPausedChanged)
     Q_PROPERTY(qint64 globalTimeUsage READ globalTimeUsage NOTIFY globalTimeUsageChanged)
@@ -43,6 +65,8 @@ class Logger : public QObject
     Q_PROPERTY(QString userEmail READ userEmail NOTIFY userEmailChanged)
     Q_PROPERTY(QString currentUsername READ currentUsername NOTIFY currentUsernameChanged)
     Q_PROPERTY(QString currentUserEmail READ currentUserEmail NOTIFY currentUserEmailChanged)
+    Q_PROPERTY(bool loginInProgress READ loginInProgress NOTIFY loginInProgressChanged)
+    Q_PROPERTY(QString apiBaseUrl READ apiBaseUrl CONSTANT)
 
     // Properti baru untuk "Time at Work"
     Q_PROPERTY(int workTimeElapsedSeconds READ workTimeElapsedSeconds NOTIFY workTimeElapsedSecondsChanged)
@@ -62,15 +86,24 @@ public:
     QString currentWindowTitle() const;
     int logCount() const;
     QString logContent() const;
+    QAbstractItemModel* logEntries() const { return m_logEntryModel; }
+    QAbstractItemModel* appUsage() const { return m_appUsageModel; }
+    QAbstractItemModel* domainUsage() const { return m_domainUsageModel; }
     QVariantMap productivityStats() const;
     QVariantList taskList() const;
+    QAbstractItemModel* tasks() const { return m_taskModel; }
+    QObject* activeTask() const { return m_taskModel->activeTask(); }
     int activeTaskId() const { return m_activeTaskId; }
     bool isTaskPaused() const { return m_isTaskPaused; }
     qint64 globalTimeUsage() const { return m_globalTimeUsage; }
     bool isTrackingActive() const { return m_isTrackingActive; }
     int getIdleThreshold() const;
+    const SettingsCache::Values &settings() const;
     int currentUserId() const { return m_currentUserId; }
     QString getUsernameById(int userId) const;
+
+    // Dipakai job storage untuk properti logContent; bisa juga dipanggil langsung (bench)
+    static QString queryLogContent(QSqlDatabase &db, int userId, qint64 fromEpoch, qint64 toEpoch);
     QString getTaskName(int taskId);
 
     // Getter untuk properti baru
@@ -106,7 +139,10 @@ public:
     QAbstractItemModel* productiveAppsModel() const { return m_productiveAppsModel; }
     QAbstractItemModel* nonProductiveAppsModel() const { return m_nonProductiveAppsModel; }
 
-    Q_INVOKABLE bool authenticate(const QString &email, const QString &password);
+    Q_INVOKABLE void authenticate(const QString &email, const QString &password);
+    Q_INVOKABLE void cancelLogin();
+    bool loginInProgress() const { return m_loginInProgress; }
+    QString apiBaseUrl() const { return m_apiBaseUrl; }
     QString authToken() const { return m_authToken; }
     QString userEmail() const { return m_userEmail; }
 
@@ -122,6 +158,7 @@ public:
     void clearToken();
     Q_INVOKABLE void updateTaskStatus(int taskId);
     Q_INVOKABLE void logout();
+    void shutdown();
     Q_INVOKABLE void sendProductivityAppToAPI(const QString &appName, const QString &windowTitle, const QString &url, int productivityType);
     void fetchAndStoreProductivityApps();
     void refreshProductivityModels();
@@ -131,6 +168,7 @@ public:
     Q_INVOKABLE void loadWorkTimeData();
     Q_INVOKABLE void checkAndCreateNewDayRecord();
     void saveWorkTimeData();
+    void flushPendingLogs();
     void sendWorkTimeToAPI();
 
     Q_INVOKABLE int calculateTodayProductiveSeconds() const;
@@ -138,6 +176,7 @@ public:
     Q_INVOKABLE void sendDailyUsageReport();
 
     void sendLogoutToAPI();
+    void closeSession();
 
     Q_INVOKABLE void sendPing(int taskId);
     Q_INVOKABLE void sendPausePlayDataToAPI(int taskId, const QString& startTime,
@@ -157,10 +196,11 @@ public slots:
     void logIdle(qint64 startTime, qint64 endTime);
     //void updateTaskTime();
     void refreshAll();
-    void handleTaskStatusReply(QNetworkReply *reply, int taskId);
+    void applyTaskStatuses(const QHash<int, QString> &statuses);
     Q_INVOKABLE QVariantList getPendingApplicationRequests();
+    // Histogram latensi jalur panas, untuk diagnosis di mesin user
+    Q_INVOKABLE QVariantMap perfSnapshot() const;
     void handleProductivityAppsResponse(QNetworkReply *reply);
-    void handleDailyUsageReportResponse(QNetworkReply *reply);
 
 
 private slots:
@@ -186,6 +226,7 @@ signals:
     void currentUserIdChanged();
     void productivityAppsChanged();
     void loginCompleted(bool success, const QString &message);
+    void loginInProgressChanged();
     void authTokenChanged();
     void userEmailChanged();
 
@@ -222,11 +263,29 @@ private:
 
     void setMaxTimeForTask(int taskId);
     void checkTaskStatusBeforeStart();
-    void migrateProductivityDatabase();
+    void rebuildRuleIndex();
+    void applySettings();
+    void refreshLogEntries();
+    void scheduleTaskListReload();
+    void handlePingResponse(const QByteArray &responseData);
+    void handleOutboxDelivered(const QString &kind, const QString &tag, const QByteArray &responseBody);
+    void handleOutboxRejected(const QString &kind, int httpStatus, const QByteArray &responseBody);
+    void reloadTaskList();
+    bool ensureRollupLoaded();
+    void loadRollupAsync();
+    QVariantMap computeProductivityStats() const;
+    void scheduleStatsRefresh();
+    void refreshStatsSnapshot();
+    void invalidateUsageModels();
+    void addSegmentToUsageModels(qint64 startTime, qint64 endTime, const QString &appName, const QString &url);
+    void scheduleLogContentRefresh();
+    void refreshLogContent();
     QSqlQueryModel* m_productiveAppsModel;
     QSqlQueryModel* m_nonProductiveAppsModel;
 
     QNetworkAccessManager *m_networkManager;
+    QString m_apiBaseUrl;
+    QUrl endpoint(const QString &path) const;
     QString m_authToken;
     QString m_userEmail;
 
@@ -242,7 +301,16 @@ private:
     void setCurrentUserInfo(int userId, const QString &username, const QString &email);
 
 
-    void handleLoginResponse(QNetworkReply* reply, const QString& username);
+    void handleLoginResponse(QNetworkReply *reply, quint64 attempt);
+    void finishApiLogin(int userId, const QString &username, const QString &email, const QString &token);
+    bool tryLocalLogin();
+    void setLoginInProgress(bool inProgress);
+    QPointer<QNetworkReply> m_loginReply;
+    QString m_loginInput;
+    QString m_loginPasswordHash;
+    quint64 m_loginAttempt = 0;
+    bool m_loginInProgress = false;
+    bool m_shutdownDone = false;
     QDateTime m_lastPlayStartTime;
     QDateTime m_lastPauseStartTime;
 
@@ -269,11 +337,43 @@ private:
     WindowInfo getActiveWindowInfoMacOS();
 #else
     WindowInfo getActiveWindowInfoLinux();
-    QString getBrowserUrlLinux();
+    QString getBrowserUrlLinux(const QString &title);
+    X11WindowProbe m_windowProbe;
 #endif
 
     mutable QSqlDatabase m_db;
     mutable QSqlDatabase m_productivityDb;
+    RuleIndex m_ruleIndex;
+    ActivityRollup m_rollup;
+    mutable SettingsCache m_settings;
+    StorageWorker *m_storage = nullptr;
+    mutable LogWriteQueue m_logQueue;
+    LogEntryModel *m_logEntryModel = nullptr;
+    UsageModel *m_appUsageModel = nullptr;
+    UsageModel *m_domainUsageModel = nullptr;
+    TaskListModel *m_taskModel = nullptr;
+    ApiOutbox *m_outbox = nullptr;
+    TaskStatusSync *m_taskStatusSync = nullptr;
+    UsageReport m_usageReport;
+    HttpCache m_httpCache;
+    bool m_taskReloadPending = false;
+    quint64 m_taskReloadGeneration = 0;
+
+    // Snapshot yang dibaca QML; dihitung ulang sekali per giliran event loop
+    QVariantMap m_statsSnapshot;
+    int m_logCountSnapshot = 0;
+    bool m_statsRefreshPending = false;
+    bool m_usageModelsDirty = true; // dibangun ulang dari rollup pada refresh berikutnya
+    bool m_rollupLoading = false;
+    QVector<LogWriteQueue::Segment> m_rollupBacklog; // segmen yang ditutup selama rollup dimuat
+    QString m_logContentSnapshot;
+    bool m_logContentRefreshPending = false;
+    bool m_logContentLoading = false;
+    bool m_logContentDirty = false;
+    SqliteSetup::Profile m_sqliteProfile;
+    QTimer m_checkpointTimer;
+    QTimer m_perfDumpTimer;
+    QString m_perfDumpPath;
     QString m_currentAppName;
     QString m_currentWindowTitle;
     WindowInfo m_lastWindowInfo;
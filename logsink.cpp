@@ -0,0 +1,237 @@
+#include "logsink.h"
+#include <QThread>
+#include <QFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QRegularExpression>
+#include <QStandardPaths>
+
+namespace {
+
+const int kRingCapacity = 4096;
+const double kRatePerSecond = 20.0;     // rata-rata baris per detik per kategori
+const double kBurst = 200.0;            // ledakan singkat yang masih diterima
+const qint64 kMaxFileSize = 5 * 1024 * 1024;
+
+LogSink *s_instance = nullptr;
+QtMessageHandler s_previousHandler = nullptr;
+QElapsedTimer s_clock;
+
+char levelChar(QtMsgType type)
+{
+    switch (type) {
+    case QtDebugMsg: return 'D';
+    case QtInfoMsg: return 'I';
+    case QtWarningMsg: return 'W';
+    case QtCriticalMsg: return 'C';
+    case QtFatalMsg: return 'F';
+    }
+    return '?';
+}
+
+} // namespace
+
+void LogSink::install(const QString &filePath)
+{
+    if (s_instance) {
+        return;
+    }
+    s_clock.start();
+    s_instance = new LogSink(filePath);
+    s_previousHandler = qInstallMessageHandler(&LogSink::handleMessage);
+}
+
+void LogSink::shutdown()
+{
+    if (!s_instance) {
+        return;
+    }
+    qInstallMessageHandler(s_previousHandler);
+    delete s_instance; // Menunggu thread penulis mengosongkan buffer
+    s_instance = nullptr;
+}
+
+QString LogSink::defaultPath()
+{
+    const QString fromEnv = qEnvironmentVariable("DESKMON_LOG_FILE");
+    if (!fromEnv.isEmpty()) {
+        return fromEnv;
+    }
+    return QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation) + "/deskmon.log";
+}
+
+QString LogSink::redact(const QString &message)
+{
+    // Cek murah dulu; regex hanya jalan untuk baris yang mungkin berisi token
+    if (!message.contains(QLatin1String("bearer"), Qt::CaseInsensitive) &&
+        !message.contains(QLatin1String("token"), Qt::CaseInsensitive)) {
+        return message;
+    }
+
+    static const QRegularExpression bearer(QStringLiteral("(Bearer\\s+)[A-Za-z0-9._~+/=|-]+"),
+                                           QRegularExpression::CaseInsensitiveOption);
+    static const QRegularExpression jsonToken(QStringLiteral("(\"[A-Za-z_]*token\"\\s*:\\s*\")[^\"]*"),
+                                              QRegularExpression::CaseInsensitiveOption);
+    static const QRegularExpression queryToken(QStringLiteral("([?&]?[A-Za-z_]*token=)[^&\\s]+"),
+                                               QRegularExpression::CaseInsensitiveOption);
+
+    QString result = message;
+    result.replace(bearer, QStringLiteral("\\1<redacted>"));
+    result.replace(jsonToken, QStringLiteral("\\1<redacted>"));
+    result.replace(queryToken, QStringLiteral("\\1<redacted>"));
+    return result;
+}
+
+LogSink::LogSink(const QString &filePath)
+    : m_filePath(filePath)
+{
+    m_ring.resize(kRingCapacity);
+    QDir().mkpath(QFileInfo(filePath).absolutePath());
+    m_thread = QThread::create([this]() { run(); });
+    m_thread->setObjectName(QStringLiteral("LogSink"));
+    m_thread->start(QThread::LowPriority);
+}
+
+LogSink::~LogSink()
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        m_stopping = true;
+        m_wake.wakeOne();
+    }
+    m_thread->wait();
+    delete m_thread;
+}
+
+void LogSink::handleMessage(QtMsgType type, const QMessageLogContext &context, const QString &message)
+{
+    LogSink *sink = s_instance;
+    const char *category = context.category ? context.category : "default";
+    const QString safe = redact(message);
+
+    if (sink && type != QtFatalMsg) {
+        int suppressed = 0;
+        if (!sink->admit(category, type, suppressed)) {
+            return;
+        }
+
+        QString line = QDateTime::currentDateTime().toString(Qt::ISODateWithMs);
+        line += QLatin1Char(' ');
+        line += QLatin1Char(levelChar(type));
+        line += QLatin1Char(' ');
+        line += QLatin1String(category);
+        line += QLatin1String(": ");
+        line += safe;
+        if (suppressed > 0) {
+            line += QStringLiteral(" [%1 similar messages suppressed]").arg(suppressed);
+        }
+        sink->push(line);
+    }
+
+    if (s_previousHandler) {
+        s_previousHandler(type, context, safe);
+    }
+}
+
+bool LogSink::admit(const char *category, QtMsgType type, int &suppressed)
+{
+    QMutexLocker locker(&m_mutex);
+    const qint64 now = s_clock.elapsed();
+    // Peringatan memakai bucket terpisah agar tidak tertutup debug yang ramai
+    QByteArray key(category);
+    if (type == QtWarningMsg || type == QtCriticalMsg) {
+        key += "#warn";
+    }
+
+    auto it = m_buckets.find(key);
+    if (it == m_buckets.end()) {
+        Bucket bucket;
+        bucket.tokens = kBurst;
+        bucket.lastRefillMs = now;
+        it = m_buckets.insert(key, bucket);
+    }
+
+    Bucket &bucket = it.value();
+    bucket.tokens = qMin(kBurst, bucket.tokens + (now - bucket.lastRefillMs) * kRatePerSecond / 1000.0);
+    bucket.lastRefillMs = now;
+    if (bucket.tokens < 1.0) {
+        ++bucket.suppressed;
+        return false;
+    }
+    bucket.tokens -= 1.0;
+    suppressed = bucket.suppressed;
+    bucket.suppressed = 0;
+    return true;
+}
+
+void LogSink::push(const QString &line)
+{
+    QMutexLocker locker(&m_mutex);
+    const int tail = (m_head + m_count) % kRingCapacity;
+    m_ring[tail] = line;
+    if (m_count == kRingCapacity) {
+        // Buffer penuh: baris tertua dibuang, penulis tidak pernah memblokir pemanggil
+        m_head = (m_head + 1) % kRingCapacity;
+        ++m_overwritten;
+    } else {
+        ++m_count;
+    }
+    m_wake.wakeOne();
+}
+
+void LogSink::run()
+{
+    QStringList batch;
+    forever {
+        int overwritten = 0;
+        bool stopping = false;
+        {
+            QMutexLocker locker(&m_mutex);
+            while (m_count == 0 && !m_stopping) {
+                m_wake.wait(&m_mutex);
+            }
+            batch.reserve(m_count);
+            for (; m_count > 0; --m_count) {
+                batch.append(std::move(m_ring[m_head]));
+                m_ring[m_head] = QString();
+                m_head = (m_head + 1) % kRingCapacity;
+            }
+            overwritten = m_overwritten;
+            m_overwritten = 0;
+            stopping = m_stopping;
+        }
+
+        if (overwritten > 0) {
+            batch.prepend(QStringLiteral("%1 log lines dropped (buffer full)").arg(overwritten));
+        }
+        if (!batch.isEmpty()) {
+            writeLines(batch);
+            batch.clear();
+        }
+        if (stopping) {
+            return;
+        }
+    }
+}
+
+void LogSink::writeLines(const QStringList &lines)
+{
+    // Rotasi sederhana: satu file cadangan .1
+    QFileInfo info(m_filePath);
+    if (info.exists() && info.size() > kMaxFileSize) {
+        const QString backup = m_filePath + ".1";
+        QFile::remove(backup);
+        QFile::rename(m_filePath, backup);
+    }
+
+    QFile file(m_filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text)) {
+        return; // Jangan log dari sini; akan kembali ke handler ini sendiri
+    }
+    for (const QString &line : lines) {
+        file.write(line.toUtf8());
+        file.write("\n");
+    }
+}
@@ -0,0 +1,55 @@
+#ifndef LOGSINK_H
+#define LOGSINK_H
+
+#include <QString>
+#include <QStringList>
+#include <QHash>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QVector>
+#include <QtGlobal>
+
+class QThread;
+
+// Message handler global yang menulis log ke file secara asinkron. Pemanggil
+// hanya memformat satu baris dan memasukkannya ke ring buffer; thread penulis
+// yang melakukan I/O. Setiap kategori dibatasi lajunya (token bucket) dan token
+// autentikasi disensor sebelum baris masuk buffer.
+class LogSink
+{
+public:
+    static void install(const QString &filePath);
+    static void shutdown();
+    static QString defaultPath();
+
+    static QString redact(const QString &message);
+
+private:
+    struct Bucket {
+        double tokens = 0;
+        qint64 lastRefillMs = 0;
+        int suppressed = 0;
+    };
+
+    explicit LogSink(const QString &filePath);
+    ~LogSink();
+
+    static void handleMessage(QtMsgType type, const QMessageLogContext &context, const QString &message);
+    bool admit(const char *category, QtMsgType type, int &suppressed);
+    void push(const QString &line);
+    void run();
+    void writeLines(const QStringList &lines);
+
+    QString m_filePath;
+    QThread *m_thread = nullptr;
+    QMutex m_mutex;
+    QWaitCondition m_wake;
+    QVector<QString> m_ring;
+    int m_head = 0;
+    int m_count = 0;
+    int m_overwritten = 0;
+    bool m_stopping = false;
+    QHash<QByteArray, Bucket> m_buckets;
+};
+
+#endif // LOGSINK_H
@@ -0,0 +1,164 @@
+#include "logwritequeue.h"
+#include "storageworker.h"
+#include "perfstats.h"
+#include "statementcache.h"
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QVariant>
+#include <QDebug>
+
+namespace {
+
+// Flush jika buffer mencapai ukuran ini atau segmen tertua sudah menunggu selama ini
+const int kMaxPendingSegments = 64;
+const int kMaxPendingMs = 15000;
+// Batas buffer saat disk terus gagal; segmen tertua dibuang lebih dulu
+const int kMaxQueuedSegments = 10000;
+
+// Kode primer SQLite yang bisa hilang sendiri: BUSY, LOCKED, NOMEM, IOERR, FULL, CANTOPEN.
+// Error lain (constraint, mismatch, ...) melekat pada barisnya dan tidak akan berhasil diulang.
+bool isTransientError(const QSqlError &error)
+{
+    const int code = error.nativeErrorCode().toInt() & 0xff;
+    return code == 5 || code == 6 || code == 7 || code == 10 || code == 13 || code == 14;
+}
+
+} // namespace
+
+LogWriteQueue::LogWriteQueue(QObject *parent) : QObject(parent)
+{
+    m_flushTimer.setSingleShot(true);
+    m_flushTimer.setInterval(kMaxPendingMs);
+    connect(&m_flushTimer, &QTimer::timeout, this, &LogWriteQueue::flush);
+}
+
+LogWriteQueue::~LogWriteQueue()
+{
+    if (!m_pending.isEmpty()) {
+        qWarning() << "Log write queue destroyed with" << m_pending.size() << "unflushed segments";
+    }
+}
+
+void LogWriteQueue::setStorage(StorageWorker *storage)
+{
+    m_storage = storage;
+}
+
+void LogWriteQueue::enqueue(const Segment &segment)
+{
+    m_pending.append(segment);
+    if (m_pending.size() >= kMaxPendingSegments) {
+        flush();
+    } else if (!m_flushTimer.isActive()) {
+        m_flushTimer.start();
+    }
+}
+
+void LogWriteQueue::flush()
+{
+    m_flushTimer.stop();
+    if (m_pending.isEmpty()) {
+        return;
+    }
+    if (!m_storage) {
+        qWarning() << "Cannot flush log segments: No storage worker";
+        m_flushTimer.start();
+        return;
+    }
+    if (m_storage->isStopped()) {
+        return; // Pemilik menulis sisa buffer lewat writePending()
+    }
+
+    QVector<Segment> batch;
+    batch.swap(m_pending);
+    m_inFlight += batch.size();
+    m_storage->run(StorageWorker::Activity, [batch](QSqlDatabase &db) {
+        return writeBatch(db, batch);
+    }).then(this, [this, batch](const WriteResult &result) {
+        m_inFlight -= batch.size();
+        if (result.retry) {
+            // Dicoba lagi nanti, urutan segmen tetap dijaga
+            m_pending = batch + m_pending;
+            if (m_pending.size() > kMaxQueuedSegments) {
+                const int excess = m_pending.size() - kMaxQueuedSegments;
+                qWarning() << "Log write queue full, dropping" << excess << "oldest segments";
+                m_pending.remove(0, excess);
+            }
+            m_flushTimer.start();
+            return;
+        }
+        if (result.written > 0) {
+            emit flushed(result.written);
+        }
+    });
+}
+
+bool LogWriteQueue::writePending(QSqlDatabase &db)
+{
+    m_flushTimer.stop();
+    if (m_pending.isEmpty()) {
+        return true;
+    }
+    const WriteResult result = writeBatch(db, m_pending);
+    if (result.retry) {
+        qWarning() << "Failed to write" << m_pending.size() << "log segments directly";
+        return false;
+    }
+    m_pending.clear();
+    return true;
+}
+
+LogWriteQueue::WriteResult LogWriteQueue::writeBatch(QSqlDatabase &db, const QVector<Segment> &batch)
+{
+    ScopedPerfTimer perf("sql.log_flush");
+    WriteResult result;
+    result.retry = true;
+    if (!db.isOpen()) {
+        qWarning() << "Cannot flush log segments: Database is not open:" << db.lastError().text();
+        return result;
+    }
+
+    if (!db.transaction()) {
+        qWarning() << "Failed to begin log transaction:" << db.lastError().text();
+        return result;
+    }
+
+    StatementCache::Query insert = StatementCache::get(db, StatementCache::LogInsert);
+    if (!insert.isValid()) {
+        db.rollback();
+        return result;
+    }
+
+    for (const Segment &segment : batch) {
+        insert->bindValue(":id_user", segment.userId);
+        insert->bindValue(":start_time", segment.startTime);
+        insert->bindValue(":end_time", segment.endTime);
+        insert->bindValue(":app_name", segment.appName);
+        insert->bindValue(":title", segment.title);
+        insert->bindValue(":url", segment.url.isEmpty() ? QVariant() : QVariant(segment.url));
+        if (insert.exec()) {
+            ++result.written;
+            continue;
+        }
+        const QSqlError error = insert->lastError();
+        if (isTransientError(error)) {
+            qWarning() << "Failed to write log segment, retrying batch later:" << error.text();
+            db.rollback();
+            return result;
+        }
+        // Statement yang gagal dibatalkan sendiri oleh SQLite; transaksi tetap jalan
+        qWarning() << "Dropping log segment that cannot be written:" << error.text()
+                   << segment.appName << segment.startTime << segment.endTime;
+        ++result.dropped;
+    }
+
+    if (!db.commit()) {
+        qWarning() << "Failed to commit log segments:" << db.lastError().text();
+        db.rollback();
+        result.written = 0;
+        result.dropped = 0;
+        return result;
+    }
+    result.retry = false;
+    return result;
+}
@@ -0,0 +1,58 @@
+#ifndef LOGWRITEQUEUE_H
+#define LOGWRITEQUEUE_H
+
+#include <QObject>
+#include <QSqlDatabase>
+#include <QTimer>
+#include <QVector>
+
+class StorageWorker;
+
+// Buffer write-behind untuk tabel log. Segmen dikumpulkan lalu ditulis oleh
+// StorageWorker dalam satu transaksi, sehingga satu fsync mencakup banyak
+// perpindahan jendela dan thread GUI tidak pernah menunggu disk.
+class LogWriteQueue : public QObject
+{
+    Q_OBJECT
+public:
+    struct Segment {
+        int userId = -1;
+        qint64 startTime = 0;
+        qint64 endTime = 0;
+        QString appName;
+        QString title;
+        QString url;
+    };
+
+    struct WriteResult {
+        bool retry = false; // error sementara (busy/IO); seluruh batch diulang
+        int written = 0;
+        int dropped = 0;    // baris yang ditolak SQLite dan tidak akan berhasil diulang
+    };
+
+    explicit LogWriteQueue(QObject *parent = nullptr);
+    ~LogWriteQueue();
+
+    void setStorage(StorageWorker *storage);
+    void enqueue(const Segment &segment);
+    int pendingCount() const { return m_pending.size() + m_inFlight; }
+
+    static WriteResult writeBatch(QSqlDatabase &db, const QVector<Segment> &batch);
+    // Menulis buffer secara sinkron di koneksi pemanggil; dipakai setelah storage berhenti
+    bool writePending(QSqlDatabase &db);
+
+public slots:
+    // Menyerahkan buffer ke thread storage; job yang diantrekan setelahnya melihat segmen ini
+    void flush();
+
+signals:
+    void flushed(int count);
+
+private:
+    StorageWorker *m_storage = nullptr;
+    QVector<Segment> m_pending;
+    int m_inFlight = 0;
+    QTimer m_flushTimer;
+};
+
+#endif // LOGWRITEQUEUE_H
@@ -10,12 +10,21 @@
 #include <QDebug>
 #include "logger.h"
 #include "idlechecker.h"
+#include "logsink.h"
+#if defined(Q_OS_LINUX)
+#include "focuswatcher.h"
+#include "x11errors.h"
+#endif
 
 int main(int argc, char *argv[])
 {
     QApplication app(argc, argv);
+    LogSink::install(LogSink::defaultPath());
     app.setWindowIcon(QIcon(":/icon.ico"));
     app.setQuitOnLastWindowClosed(true);
+#if defined(Q_OS_LINUX)
+    installX11ErrorHandler();
+#endif
 
     // Initialize components
     Logger logger;
@@ -25,9 +34,7 @@ int main(int argc, char *argv[])
     QObject::connect(&idleChecker, &IdleChecker::idleDetected, &logger, &Logger::logIdle);
     QObject::connect(&app, &QApplication::aboutToQuit, [&]() {
         qDebug() << "Application is about to quit, saving final data...";
-        logger.saveWorkTimeData();
-        logger.sendWorkTimeToAPI();
-        logger.logout();
+        logger.shutdown();
     });
 
 
@@ -154,13 +161,25 @@ int main(int argc, char *argv[])
     showQmlWindow();
 
     // Start monitoring
-    QTimer timer;
-    QObject::connect(&timer, &QTimer::timeout, &app, [&]() {
+    auto sampleActiveWindow = [&]() {
         if (!idleChecker.isIdle()) {
             logger.logActiveWindow();
         }
-    });
-    timer.start(1000);
+    };
+
+    // Polling hanya fallback; jika event fokus tersedia, cukup sebagai safety net
+    int pollInterval = 1000;
+#if defined(Q_OS_LINUX)
+    FocusWatcher focusWatcher;
+    if (focusWatcher.isAvailable()) {
+        QObject::connect(&focusWatcher, &FocusWatcher::activeWindowChanged, &app, sampleActiveWindow);
+        pollInterval = 30000;
+    }
+#endif
+    QTimer timer;
+    QObject::connect(&timer, &QTimer::timeout, &app, sampleActiveWindow);
+    timer.start(pollInterval);
+    sampleActiveWindow();
 
     // Di main()
     QTimer *dayChangeTimer = new QTimer(&app);
@@ -180,5 +199,7 @@ int main(int argc, char *argv[])
         showQmlWindow();
     }
 
-    return app.exec();
+    int result = app.exec();
+    LogSink::shutdown();
+    return result;
 }
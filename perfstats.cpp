@@ -0,0 +1,170 @@
+#include "perfstats.h"
+#include <QHash>
+#include <QtAlgorithms>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QNetworkReply>
+#include <QJsonDocument>
+#include <QSaveFile>
+#include <QDateTime>
+#include <QDebug>
+#include <algorithm>
+
+namespace {
+
+const int kSubBucketBits = 4;
+const int kSubBuckets = 1 << kSubBucketBits;
+const int kMaxExponent = 40; // ~18 menit dalam nanodetik; nilai lebih besar masuk bucket terakhir
+const int kBucketCount = kSubBuckets + (kMaxExponent - kSubBucketBits + 1) * kSubBuckets;
+
+struct Histogram {
+    quint64 counts[kBucketCount] = {};
+    quint64 count = 0;
+    qint64 sum = 0;
+    qint64 min = 0;
+    qint64 max = 0;
+};
+
+int bucketFor(qint64 nanos)
+{
+    if (nanos < kSubBuckets) {
+        return int(qMax<qint64>(nanos, 0));
+    }
+    const int exponent = 63 - qCountLeadingZeroBits(quint64(nanos));
+    if (exponent > kMaxExponent) {
+        return kBucketCount - 1;
+    }
+    const int shift = exponent - kSubBucketBits;
+    const int sub = int((nanos >> shift) & (kSubBuckets - 1));
+    return kSubBuckets + shift * kSubBuckets + sub;
+}
+
+// Titik tengah bucket, dipakai sebagai nilai persentil
+qint64 bucketValue(int bucket)
+{
+    if (bucket < kSubBuckets) {
+        return bucket;
+    }
+    const int shift = (bucket - kSubBuckets) / kSubBuckets;
+    const int sub = (bucket - kSubBuckets) % kSubBuckets;
+    const qint64 lower = qint64(kSubBuckets + sub) << shift;
+    return lower + ((qint64(1) << shift) >> 1);
+}
+
+qint64 percentile(const Histogram &histogram, double fraction)
+{
+    const quint64 target = qMax<quint64>(1, quint64(fraction * histogram.count + 0.5));
+    quint64 seen = 0;
+    for (int i = 0; i < kBucketCount; ++i) {
+        seen += histogram.counts[i];
+        if (seen >= target) {
+            return qBound(histogram.min, bucketValue(i), histogram.max);
+        }
+    }
+    return histogram.max;
+}
+
+QMutex s_mutex;
+QHash<QByteArray, Histogram> s_histograms;
+const qint64 s_startedAt = QDateTime::currentSecsSinceEpoch();
+
+double micros(qint64 nanos)
+{
+    return nanos / 1000.0;
+}
+
+} // namespace
+
+void PerfStats::record(const char *operation, qint64 nanos)
+{
+    // fromRawData: lookup tanpa alokasi; kunci baru disalin oleh insert di bawah
+    record(QByteArray::fromRawData(operation, qstrlen(operation)), nanos);
+}
+
+void PerfStats::record(const QByteArray &operation, qint64 nanos)
+{
+    QMutexLocker locker(&s_mutex);
+    auto it = s_histograms.find(operation);
+    if (it == s_histograms.end()) {
+        it = s_histograms.insert(QByteArray(operation.constData(), operation.size()), Histogram());
+    }
+
+    Histogram &histogram = it.value();
+    histogram.counts[bucketFor(nanos)] += 1;
+    histogram.min = histogram.count == 0 ? nanos : qMin(histogram.min, nanos);
+    histogram.max = qMax(histogram.max, nanos);
+    histogram.sum += nanos;
+    histogram.count += 1;
+}
+
+void PerfStats::trackReply(QNetworkReply *reply, const QByteArray &operation)
+{
+    if (!reply) {
+        return;
+    }
+    QElapsedTimer timer;
+    timer.start();
+    QObject::connect(reply, &QNetworkReply::finished, reply, [timer, operation]() {
+        PerfStats::record(operation, timer.nsecsElapsed());
+    });
+}
+
+QVariantMap PerfStats::snapshot()
+{
+    return snapshotJson().toVariantMap();
+}
+
+QJsonObject PerfStats::snapshotJson()
+{
+    QHash<QByteArray, Histogram> copy;
+    {
+        QMutexLocker locker(&s_mutex);
+        copy = s_histograms;
+    }
+
+    QJsonObject operations;
+    for (auto it = copy.constBegin(); it != copy.constEnd(); ++it) {
+        const Histogram &histogram = it.value();
+        if (histogram.count == 0) {
+            continue;
+        }
+        QJsonObject entry;
+        entry["count"] = qint64(histogram.count);
+        entry["total_ms"] = histogram.sum / 1e6;
+        entry["mean_us"] = micros(histogram.sum / qint64(histogram.count));
+        entry["min_us"] = micros(histogram.min);
+        entry["p50_us"] = micros(percentile(histogram, 0.50));
+        entry["p90_us"] = micros(percentile(histogram, 0.90));
+        entry["p99_us"] = micros(percentile(histogram, 0.99));
+        entry["p999_us"] = micros(percentile(histogram, 0.999));
+        entry["max_us"] = micros(histogram.max);
+        operations[QString::fromLatin1(it.key())] = entry;
+    }
+
+    QJsonObject result;
+    result["generated_at"] = QDateTime::currentDateTime().toString(Qt::ISODate);
+    result["uptime_s"] = QDateTime::currentSecsSinceEpoch() - s_startedAt;
+    result["operations"] = operations;
+    return result;
+}
+
+bool PerfStats::writeJson(const QString &filePath)
+{
+    QSaveFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "Cannot write perf snapshot to" << filePath << ":" << file.errorString();
+        return false;
+    }
+    file.write(QJsonDocument(snapshotJson()).toJson(QJsonDocument::Indented));
+    if (!file.commit()) {
+        qWarning() << "Cannot write perf snapshot to" << filePath << ":" << file.errorString();
+        return false;
+    }
+    return true;
+}
+
+void PerfStats::reset()
+{
+    QMutexLocker locker(&s_mutex);
+    s_histograms.clear();
+}
@@ -0,0 +1,44 @@
+#ifndef PERFSTATS_H
+#define PERFSTATS_H
+
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QJsonObject>
+#include <QVariantMap>
+
+class QNetworkReply;
+
+// Histogram latensi per operasi (probe, kelas statement SQL, panggilan API,
+// getter yang dibaca QML). Bucket log-linear gaya HDR: 16 sub-bucket per
+// kelipatan dua, jadi galat relatif persentil < 7% dan memori tetap per operasi.
+// Aman dipanggil dari thread mana pun.
+class PerfStats
+{
+public:
+    static void record(const char *operation, qint64 nanos);
+    static void record(const QByteArray &operation, qint64 nanos);
+
+    // Mengukur waktu dari sekarang hingga reply selesai (termasuk antrean QNAM)
+    static void trackReply(QNetworkReply *reply, const QByteArray &operation);
+
+    static QVariantMap snapshot();
+    static QJsonObject snapshotJson();
+    static bool writeJson(const QString &filePath);
+    static void reset();
+};
+
+class ScopedPerfTimer
+{
+public:
+    explicit ScopedPerfTimer(const char *operation) : m_operation(operation) { m_timer.start(); }
+    ~ScopedPerfTimer() { PerfStats::record(m_operation, m_timer.nsecsElapsed()); }
+
+    ScopedPerfTimer(const ScopedPerfTimer &) = delete;
+    ScopedPerfTimer &operator=(const ScopedPerfTimer &) = delete;
+
+private:
+    const char *m_operation;
+    QElapsedTimer m_timer;
+};
+
+#endif // PERFSTATS_H
@@ -0,0 +1,314 @@
+#include "ruleindex.h"
+#include "logcategories.h"
+#include "perfstats.h"
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QDebug>
+#include <climits>
+
+namespace {
+
+// Normalisasi sama seperti sebelumnya: huruf kecil, buang spasi, '-', '_' dan '.'
+template <typename Output>
+void normalizeAppName(QStringView str, Output &out)
+{
+    for (QChar ch : str) {
+        if (ch == u' ' || ch == u'-' || ch == u'_' || ch == u'.') {
+            continue;
+        }
+        out.append(ch.toLower());
+    }
+}
+
+} // namespace
+
+RuleIndex::RuleIndex()
+{
+    clear();
+}
+
+void RuleIndex::clear()
+{
+    m_rules.clear();
+    m_appRules.clear();
+    m_appExact.clear();
+    m_nodes.clear();
+    m_children.clear();
+    m_nodes.append(Node()); // root
+    m_appMemo.clear();
+    m_appMemoUser = -1;
+}
+
+void RuleIndex::rebuild(QSqlDatabase &db)
+{
+    clear();
+
+    if (!db.isOpen()) {
+        qWarning() << "Cannot build rule index: Productivity database is not open";
+        return;
+    }
+
+    ScopedPerfTimer perf("sql.rule_rebuild");
+    QSqlQuery query(db);
+    if (!query.exec("SELECT aplikasi, url, jenis, for_user FROM aplikasi ORDER BY id")) {
+        qWarning() << "Failed to load rules for index:" << query.lastError().text();
+        return;
+    }
+
+    while (query.next()) {
+        const QString appName = query.value(0).toString();
+        const QString url = query.value(1).toString();
+        const QString forUsers = query.value(3).toString();
+
+        Rule rule;
+        rule.jenis = query.value(2).toInt();
+        if (forUsers == "0") {
+            rule.global = true;
+        } else {
+            const QStringList userList = forUsers.split(',', Qt::SkipEmptyParts);
+            for (const QString &userId : userList) {
+                bool ok = false;
+                int id = userId.trimmed().toInt(&ok);
+                if (ok) {
+                    rule.users.append(id);
+                }
+            }
+        }
+
+        if (!url.isEmpty()) {
+            // Aturan browser: indeks berdasarkan domain
+            const QString domain = hostOf(url).toString().toLower();
+            if (domain.isEmpty()) {
+                continue;
+            }
+            int index = m_rules.size();
+            m_rules.append(rule);
+            addDomainRule(index, domain);
+        } else if (!appName.isEmpty()) {
+            // Aturan non-browser: indeks berdasarkan nama aplikasi ternormalisasi
+            normalizeAppName(appName, rule.normApp);
+            int index = m_rules.size();
+            m_rules.append(rule);
+            m_appRules.append(index);
+            m_appExact.insert(qHash(QStringView(m_rules[index].normApp)), index);
+        }
+    }
+
+    qCDebug(lcStats) << "Rule index rebuilt:" << m_rules.size() << "rules," << m_nodes.size() - 1 << "domain nodes";
+}
+
+int RuleIndex::classify(int userId, const QString &appName, const QString &url) const
+{
+    if (!url.isEmpty()) {
+        QStringView domain = hostOf(url);
+        if (domain.isEmpty()) {
+            return 0; // Tidak bisa ekstrak domain
+        }
+        return classifyDomain(userId, domain);
+    }
+    return classifyApp(userId, appName);
+}
+
+int RuleIndex::classifyApp(int userId, const QString &appName) const
+{
+    if (m_appMemoUser != userId) {
+        m_appMemo.clear();
+        m_appMemoUser = userId;
+    }
+    auto memo = m_appMemo.constFind(appName);
+    if (memo != m_appMemo.constEnd()) {
+        return memo.value();
+    }
+
+    QVarLengthArray<QChar, 128> buffer;
+    normalizeAppName(appName, buffer);
+    const QStringView normApp(buffer.constData(), buffer.size());
+
+    // Aturan pertama (urutan baris) yang cocok menang, sama seperti scan SQL lama.
+    int best = INT_MAX;
+    const size_t hash = qHash(normApp);
+    for (auto it = m_appExact.constFind(hash); it != m_appExact.constEnd() && it.key() == hash; ++it) {
+        const Rule &rule = m_rules[it.value()];
+        if (it.value() < best && rule.normApp == normApp && appliesTo(rule, userId)) {
+            best = it.value();
+        }
+    }
+
+    // Contains match (kedua arah) hanya perlu dicek untuk aturan sebelum kandidat exact
+    for (int index : m_appRules) {
+        if (index >= best) {
+            break;
+        }
+        const Rule &rule = m_rules[index];
+        if (!appliesTo(rule, userId)) {
+            continue;
+        }
+        const QStringView normRule(rule.normApp);
+        if (normApp.contains(normRule) || normRule.contains(normApp)) {
+            best = index;
+            break;
+        }
+    }
+
+    int result = best == INT_MAX ? 0 : m_rules[best].jenis;
+    m_appMemo.insert(appName, result);
+    return result;
+}
+
+int RuleIndex::classifyDomain(int userId, QStringView domain) const
+{
+    int best = INT_MAX;
+    int node = 0;
+    qsizetype end = domain.size();
+
+    // Telusuri label dari kanan (com -> example -> www)
+    while (end > 0) {
+        qsizetype dot = domain.lastIndexOf(u'.', end - 1);
+        QStringView label = domain.mid(dot + 1, end - dot - 1);
+        end = dot < 0 ? 0 : dot;
+        if (label.isEmpty()) {
+            continue;
+        }
+
+        int child = findChild(node, label);
+        if (child < 0) {
+            node = -1;
+            break;
+        }
+        node = child;
+
+        // Node ini adalah parent domain dari domain yang dicari (subdomain match)
+        if (end > 0) {
+            int rule = firstApplicable(m_nodes[node].ownRules, userId);
+            if (rule >= 0 && rule < best) {
+                best = rule;
+            }
+        }
+    }
+
+    // Domain persis sama, atau aturan yang merupakan subdomain dari domain ini
+    if (node > 0) {
+        int rule = firstApplicable(m_nodes[node].subtreeRules, userId);
+        if (rule >= 0 && rule < best) {
+            best = rule;
+        }
+    }
+
+    return best == INT_MAX ? 0 : m_rules[best].jenis;
+}
+
+QStringView RuleIndex::hostOf(QStringView url)
+{
+    QStringView host = url.trimmed();
+
+    qsizetype schemeEnd = host.indexOf(u"://");
+    if (schemeEnd >= 0) {
+        host = host.mid(schemeEnd + 3);
+    }
+
+    for (qsizetype i = 0; i < host.size(); ++i) {
+        QChar ch = host.at(i);
+        if (ch == u'/' || ch == u'?' || ch == u'#') {
+            host = host.left(i);
+            break;
+        }
+    }
+
+    qsizetype at = host.lastIndexOf(u'@');
+    if (at >= 0) {
+        host = host.mid(at + 1);
+    }
+
+    if (!host.startsWith(u'[')) {
+        qsizetype colon = host.indexOf(u':');
+        if (colon >= 0) {
+            host = host.left(colon);
+        }
+    }
+
+    while (host.endsWith(u'.')) {
+        host.chop(1);
+    }
+
+    // Hapus www. prefix
+    if (host.startsWith(u"www.", Qt::CaseInsensitive)) {
+        host = host.mid(4);
+    }
+
+    return host;
+}
+
+bool RuleIndex::appliesTo(const Rule &rule, int userId)
+{
+    return rule.global || rule.users.contains(userId);
+}
+
+size_t RuleIndex::foldedHash(QStringView label)
+{
+    // FNV-1a atas karakter huruf kecil, agar lookup tidak perlu menyalin string
+    size_t hash = 14695981039346656037ULL;
+    for (QChar ch : label) {
+        hash ^= ch.toLower().unicode();
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+quint64 RuleIndex::childKey(int parent, size_t labelHash)
+{
+    return (quint64(quint32(parent)) << 32) ^ quint64(labelHash);
+}
+
+int RuleIndex::findChild(int parent, QStringView label) const
+{
+    const quint64 key = childKey(parent, foldedHash(label));
+    for (auto it = m_children.constFind(key); it != m_children.constEnd() && it.key() == key; ++it) {
+        if (label.compare(m_nodes[it.value()].label, Qt::CaseInsensitive) == 0) {
+            return it.value();
+        }
+    }
+    return -1;
+}
+
+int RuleIndex::addChild(int parent, QStringView label)
+{
+    int existing = findChild(parent, label);
+    if (existing >= 0) {
+        return existing;
+    }
+    Node node;
+    node.label = label.toString();
+    m_nodes.append(node);
+    int index = m_nodes.size() - 1;
+    m_children.insert(childKey(parent, foldedHash(label)), index);
+    return index;
+}
+
+void RuleIndex::addDomainRule(int ruleIndex, QStringView domain)
+{
+    int node = 0;
+    qsizetype end = domain.size();
+    while (end > 0) {
+        qsizetype dot = domain.lastIndexOf(u'.', end - 1);
+        QStringView label = domain.mid(dot + 1, end - dot - 1);
+        end = dot < 0 ? 0 : dot;
+        if (label.isEmpty()) {
+            continue;
+        }
+        node = addChild(node, label);
+        m_nodes[node].subtreeRules.append(ruleIndex);
+    }
+    if (node > 0) {
+        m_nodes[node].ownRules.append(ruleIndex);
+    }
+}
+
+int RuleIndex::firstApplicable(const QVector<int> &rules, int userId) const
+{
+    for (int index : rules) {
+        if (appliesTo(m_rules[index], userId)) {
+            return index;
+        }
+    }
+    return -1;
+}
@@ -0,0 +1,64 @@
+#ifndef RULEINDEX_H
+#define RULEINDEX_H
+
+#include <QString>
+#include <QStringView>
+#include <QVector>
+#include <QHash>
+#include <QMultiHash>
+#include <QVarLengthArray>
+#include <QSqlDatabase>
+
+// Indeks aturan produktivitas (tabel aplikasi) yang dibangun sekali di memori.
+// Klasifikasi tidak lagi menjalankan SQL; cukup satu lookup hash/trie.
+class RuleIndex
+{
+public:
+    RuleIndex();
+
+    void rebuild(QSqlDatabase &db);
+    void clear();
+    int ruleCount() const { return m_rules.size(); }
+
+    // 0 = netral, 1 = produktif, 2 = non-produktif
+    int classify(int userId, const QString &appName, const QString &url) const;
+    int classifyApp(int userId, const QString &appName) const;
+    int classifyDomain(int userId, QStringView domain) const;
+
+    // Ambil host dari URL tanpa alokasi (tanpa "www." di depan)
+    static QStringView hostOf(QStringView url);
+
+private:
+    struct Rule {
+        int jenis = 0;
+        bool global = false;
+        QVarLengthArray<int, 4> users; // for_user yang sudah dipecah
+        QString normApp;               // hanya untuk aturan aplikasi non-browser
+    };
+
+    struct Node {
+        QString label;
+        QVector<int> ownRules;     // aturan dengan domain tepat di node ini
+        QVector<int> subtreeRules; // aturan di node ini dan semua subdomain-nya
+    };
+
+    static bool appliesTo(const Rule &rule, int userId);
+    static size_t foldedHash(QStringView label);
+    static quint64 childKey(int parent, size_t labelHash);
+
+    int findChild(int parent, QStringView label) const;
+    int addChild(int parent, QStringView label);
+    void addDomainRule(int ruleIndex, QStringView domain);
+    int firstApplicable(const QVector<int> &rules, int userId) const;
+
+    QVector<Rule> m_rules;       // urutan sama dengan urutan baris di tabel
+    QVector<int> m_appRules;     // indeks aturan aplikasi, terurut
+    QMultiHash<size_t, int> m_appExact; // hash nama ternormalisasi -> aturan
+    QVector<Node> m_nodes;       // node 0 = root trie label domain terbalik
+    QMultiHash<quint64, int> m_children;
+
+    mutable QHash<QString, int> m_appMemo;
+    mutable int m_appMemoUser = -1;
+};
+
+#endif // RULEINDEX_H
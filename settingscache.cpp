@@ -0,0 +1,132 @@
+#include "settingscache.h"
+#include "logcategories.h"
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QDebug>
+
+namespace {
+
+// Kunci di tabel app_settings; nilai interval disimpan dalam detik
+const char kPingInterval[] = "ping_interval";
+const char kProductivePingInterval[] = "productive_interval";
+const char kUsageReportInterval[] = "usage_report_interval";
+const char kSettingsVersion[] = "settings_version";
+
+} // namespace
+
+bool SettingsCache::createTable(QSqlDatabase &db)
+{
+    QSqlQuery query(db);
+    if (!query.exec("CREATE TABLE IF NOT EXISTS app_settings ("
+                    "key TEXT PRIMARY KEY, "
+                    "value INTEGER NOT NULL)")) {
+        qWarning() << "Failed to create app_settings table:" << query.lastError().text();
+        return false;
+    }
+    return true;
+}
+
+bool SettingsCache::load(QSqlDatabase &db)
+{
+    m_values = Values();
+    m_loaded = true; // Gagal baca tetap memakai default, tidak diulang setiap akses
+
+    if (!db.isOpen()) {
+        qWarning() << "Cannot load settings: Database is not open, using defaults";
+        return false;
+    }
+
+    QSqlQuery query(db);
+    if (query.exec("SELECT threshold_seconds FROM idle_settings LIMIT 1") && query.next()) {
+        int threshold = query.value(0).toInt();
+        if (threshold > 0) {
+            m_values.idleThresholdSeconds = threshold;
+        } else {
+            qWarning() << "Invalid threshold in database (null or <= 0), using default:" << m_values.idleThresholdSeconds << "seconds";
+        }
+    }
+
+    if (!query.exec("SELECT key, value FROM app_settings")) {
+        qWarning() << "Failed to load app settings:" << query.lastError().text();
+        return false;
+    }
+    while (query.next()) {
+        const QString key = query.value(0).toString();
+        const qint64 value = query.value(1).toLongLong();
+        if (value <= 0) {
+            continue;
+        }
+        if (key == QLatin1String(kPingInterval)) {
+            m_values.pingIntervalMs = int(value * 1000);
+        } else if (key == QLatin1String(kProductivePingInterval)) {
+            m_values.productivePingIntervalMs = int(value * 1000);
+        } else if (key == QLatin1String(kUsageReportInterval)) {
+            m_values.usageReportIntervalMs = int(value * 1000);
+        } else if (key == QLatin1String(kSettingsVersion)) {
+            m_values.version = value;
+        }
+    }
+
+    qCDebug(lcDb) << "Settings loaded: idle threshold" << m_values.idleThresholdSeconds
+             << "s, version" << m_values.version;
+    return true;
+}
+
+bool SettingsCache::setIdleThreshold(QSqlDatabase &db, int seconds)
+{
+    QSqlQuery query(db);
+    query.prepare("INSERT OR REPLACE INTO idle_settings (id, threshold_seconds) VALUES (1, :threshold)");
+    query.bindValue(":threshold", seconds);
+    if (!query.exec()) {
+        qWarning() << "Failed to set idle threshold:" << query.lastError().text();
+        return false;
+    }
+    m_values.idleThresholdSeconds = seconds;
+    return true;
+}
+
+bool SettingsCache::applyServerSettings(QSqlDatabase &db, const QJsonObject &response)
+{
+    if (!response.contains(kSettingsVersion)) {
+        return false;
+    }
+    if (!m_loaded) {
+        load(db);
+    }
+    const qint64 version = response.value(kSettingsVersion).toVariant().toLongLong();
+    if (version == m_values.version) {
+        return false;
+    }
+
+    qCDebug(lcDb) << "Server settings version changed:" << m_values.version << "->" << version;
+
+    const QJsonObject settings = response.value("settings").toObject();
+    const int threshold = settings.value("idle_threshold").toInt();
+    if (threshold > 0) {
+        setIdleThreshold(db, threshold);
+    }
+    for (const char *key : {kPingInterval, kProductivePingInterval, kUsageReportInterval}) {
+        const int seconds = settings.value(key).toInt();
+        if (seconds > 0) {
+            storeValue(db, key, seconds);
+        }
+    }
+    storeValue(db, kSettingsVersion, version);
+
+    invalidate();
+    load(db);
+    return true;
+}
+
+bool SettingsCache::storeValue(QSqlDatabase &db, const QString &key, qint64 value)
+{
+    QSqlQuery query(db);
+    query.prepare("INSERT OR REPLACE INTO app_settings (key, value) VALUES (:key, :value)");
+    query.bindValue(":key", key);
+    query.bindValue(":value", value);
+    if (!query.exec()) {
+        qWarning() << "Failed to store setting" << key << ":" << query.lastError().text();
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,40 @@
+#ifndef SETTINGSCACHE_H
+#define SETTINGSCACHE_H
+
+#include <QSqlDatabase>
+#include <QJsonObject>
+
+// Cache bertipe untuk pengaturan yang sering dibaca (idle threshold, interval
+// timer). Dibaca sekali dari database, lalu hanya dimuat ulang jika di-invalidate
+// atau server mengirim versi pengaturan yang berbeda.
+class SettingsCache
+{
+public:
+    struct Values {
+        int idleThresholdSeconds = 180;
+        int pingIntervalMs = 30000;
+        int productivePingIntervalMs = 180000;
+        int usageReportIntervalMs = 300000;
+        qint64 version = 0;
+    };
+
+    bool isLoaded() const { return m_loaded; }
+    const Values &values() const { return m_values; }
+    void invalidate() { m_loaded = false; }
+
+    static bool createTable(QSqlDatabase &db);
+    bool load(QSqlDatabase &db);
+    bool setIdleThreshold(QSqlDatabase &db, int seconds);
+
+    // Menerapkan "settings_version" (dan objek "settings" opsional) dari respons
+    // server. Mengembalikan true jika versi berbeda dan cache diperbarui.
+    bool applyServerSettings(QSqlDatabase &db, const QJsonObject &response);
+
+private:
+    bool storeValue(QSqlDatabase &db, const QString &key, qint64 value);
+
+    Values m_values;
+    bool m_loaded = false;
+};
+
+#endif // SETTINGSCACHE_H
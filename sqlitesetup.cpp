@@ -0,0 +1,125 @@
+#include "sqlitesetup.h"
+#include "logcategories.h"
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QVariant>
+#include <QDebug>
+
+namespace {
+
+int envInt(const char *name, int fallback)
+{
+    bool ok = false;
+    int value = qEnvironmentVariableIntValue(name, &ok);
+    return ok ? value : fallback;
+}
+
+} // namespace
+
+SqliteSetup::Profile SqliteSetup::Profile::fromEnvironment()
+{
+    Profile profile;
+    if (qEnvironmentVariableIsSet("DESKMON_SQLITE_JOURNAL_MODE")) {
+        profile.journalMode = qEnvironmentVariable("DESKMON_SQLITE_JOURNAL_MODE").toUpper();
+    }
+    if (qEnvironmentVariableIsSet("DESKMON_SQLITE_SYNCHRONOUS")) {
+        profile.synchronous = qEnvironmentVariable("DESKMON_SQLITE_SYNCHRONOUS").toUpper();
+    }
+    profile.mmapSizeBytes = qint64(envInt("DESKMON_SQLITE_MMAP_MB", int(profile.mmapSizeBytes / (1024 * 1024)))) * 1024 * 1024;
+    profile.cacheSizeKiB = envInt("DESKMON_SQLITE_CACHE_KB", profile.cacheSizeKiB);
+    profile.tempStoreMemory = envInt("DESKMON_SQLITE_TEMP_STORE_MEMORY", profile.tempStoreMemory ? 1 : 0) != 0;
+    profile.checkpointIntervalMs = envInt("DESKMON_SQLITE_CHECKPOINT_SEC", profile.checkpointIntervalMs / 1000) * 1000;
+    return profile;
+}
+
+void SqliteSetup::applyProfile(QSqlDatabase &db, const Profile &profile)
+{
+    if (!db.isOpen()) {
+        qWarning() << "Cannot apply SQLite profile: Database is not open";
+        return;
+    }
+
+    // Nilai pragma tidak bisa di-bind, jadi hanya terima nilai yang dikenal
+    static const QStringList journalModes = {"DELETE", "TRUNCATE", "PERSIST", "MEMORY", "WAL", "OFF"};
+    static const QStringList syncModes = {"OFF", "NORMAL", "FULL", "EXTRA"};
+
+    QSqlQuery query(db);
+    QStringList pragmas;
+    if (journalModes.contains(profile.journalMode)) {
+        pragmas << QString("PRAGMA journal_mode = %1").arg(profile.journalMode);
+    }
+    if (syncModes.contains(profile.synchronous)) {
+        pragmas << QString("PRAGMA synchronous = %1").arg(profile.synchronous);
+    }
+    pragmas << QString("PRAGMA mmap_size = %1").arg(qMax<qint64>(0, profile.mmapSizeBytes));
+    // Nilai negatif berarti KiB, bukan jumlah halaman
+    pragmas << QString("PRAGMA cache_size = -%1").arg(qMax(0, profile.cacheSizeKiB));
+    pragmas << QString("PRAGMA temp_store = %1").arg(profile.tempStoreMemory ? "MEMORY" : "DEFAULT");
+
+    for (const QString &pragma : std::as_const(pragmas)) {
+        if (!query.exec(pragma)) {
+            qWarning() << "Failed to apply" << pragma << ":" << query.lastError().text();
+        }
+    }
+
+    if (query.exec("PRAGMA journal_mode") && query.next()) {
+        qCDebug(lcDb) << "SQLite profile applied to" << db.connectionName()
+                 << "- journal_mode:" << query.value(0).toString()
+                 << "synchronous:" << profile.synchronous;
+    }
+}
+
+int SqliteSetup::schemaVersion(QSqlDatabase &db)
+{
+    QSqlQuery query(db);
+    if (query.exec("PRAGMA user_version") && query.next()) {
+        return query.value(0).toInt();
+    }
+    return 0;
+}
+
+bool SqliteSetup::migrate(QSqlDatabase &db, const QVector<Migration> &migrations)
+{
+    const int current = schemaVersion(db);
+    if (current >= migrations.size()) {
+        return true; // Skema sudah terbaru; tidak ada DDL saat startup
+    }
+
+    for (int version = current + 1; version <= migrations.size(); ++version) {
+        if (!db.transaction()) {
+            qWarning() << "Failed to begin migration" << version << "on" << db.connectionName()
+                       << ":" << db.lastError().text();
+            return false;
+        }
+
+        QSqlQuery query(db);
+        if (!migrations[version - 1](db) ||
+            !query.exec(QString("PRAGMA user_version = %1").arg(version))) {
+            qWarning() << "Migration" << version << "failed on" << db.connectionName()
+                       << ":" << query.lastError().text();
+            db.rollback();
+            return false;
+        }
+
+        if (!db.commit()) {
+            qWarning() << "Failed to commit migration" << version << "on" << db.connectionName()
+                       << ":" << db.lastError().text();
+            db.rollback();
+            return false;
+        }
+        qCDebug(lcDb) << "Database" << db.connectionName() << "migrated to schema version" << version;
+    }
+    return true;
+}
+
+void SqliteSetup::checkpoint(QSqlDatabase &db)
+{
+    if (!db.isOpen()) {
+        return;
+    }
+    // PASSIVE tidak menunggu reader/writer lain, jadi aman dipanggil dari timer
+    QSqlQuery query(db);
+    if (!query.exec("PRAGMA wal_checkpoint(PASSIVE)")) {
+        qWarning() << "WAL checkpoint failed on" << db.connectionName() << ":" << query.lastError().text();
+    }
+}
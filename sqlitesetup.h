@@ -0,0 +1,35 @@
+#ifndef SQLITESETUP_H
+#define SQLITESETUP_H
+
+#include <QSqlDatabase>
+#include <QVector>
+#include <functional>
+
+// Lapisan setup koneksi SQLite: profil pragma performa yang bisa diatur lewat
+// environment, dan migrasi skema berversi memakai PRAGMA user_version.
+class SqliteSetup
+{
+public:
+    struct Profile {
+        QString journalMode = QStringLiteral("WAL");
+        QString synchronous = QStringLiteral("NORMAL");
+        qint64 mmapSizeBytes = 64LL * 1024 * 1024;
+        int cacheSizeKiB = 16 * 1024;
+        bool tempStoreMemory = true;
+        int checkpointIntervalMs = 5 * 60 * 1000;
+
+        // DESKMON_SQLITE_JOURNAL_MODE, DESKMON_SQLITE_SYNCHRONOUS, DESKMON_SQLITE_MMAP_MB,
+        // DESKMON_SQLITE_CACHE_KB, DESKMON_SQLITE_TEMP_STORE_MEMORY, DESKMON_SQLITE_CHECKPOINT_SEC
+        static Profile fromEnvironment();
+    };
+
+    // Satu langkah migrasi; dijalankan di dalam transaksi bersama update user_version
+    using Migration = std::function<bool(QSqlDatabase &db)>;
+
+    static void applyProfile(QSqlDatabase &db, const Profile &profile);
+    static bool migrate(QSqlDatabase &db, const QVector<Migration> &migrations);
+    static int schemaVersion(QSqlDatabase &db);
+    static void checkpoint(QSqlDatabase &db);
+};
+
+#endif // SQLITESETUP_H
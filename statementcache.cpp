@@ -0,0 +1,132 @@
+#include "statementcache.h"
+#include "perfstats.h"
+#include <QSqlError>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QDebug>
+#include <array>
+#include <utility>
+
+namespace {
+
+struct Definition {
+    const char *name;
+    const char *perfName;
+    const char *sql;
+};
+
+const Definition kDefinitions[StatementCache::StatementCount] = {
+    {"log_insert", "stmt.log_insert",
+     "INSERT INTO log (id_user, start_time, end_time, app_name, title, url) "
+     "VALUES (:id_user, :start_time, :end_time, :app_name, :title, :url)"},
+    {"work_time_select", "stmt.work_time_select",
+     "SELECT elapsed_seconds FROM work_time WHERE user_id = :user_id AND date = :date"},
+    {"work_time_upsert", "stmt.work_time_upsert",
+     "INSERT OR REPLACE INTO work_time (user_id, date, elapsed_seconds) VALUES (:user_id, :date, :seconds)"},
+    {"task_time_usage_select", "stmt.task_time_usage_select",
+     "SELECT time_usage FROM task WHERE id = :id"},
+    {"task_name_select", "stmt.task_name_select",
+     "SELECT task FROM task WHERE id = :id AND user_id = :user_id"},
+    {"task_owned_select", "stmt.task_owned_select",
+     "SELECT id, task FROM task WHERE user_id = :user_id"},
+    {"task_status_update", "stmt.task_status_update",
+     "UPDATE task SET status = :status WHERE id = :id AND user_id = :user_id"},
+    {"username_select", "stmt.username_select",
+     "SELECT username FROM users WHERE id = :id"},
+    {"profile_image_select", "stmt.profile_image_select",
+     "SELECT profile_image FROM users WHERE username = :username"},
+};
+
+struct Connection {
+    std::array<std::unique_ptr<QSqlQuery>, StatementCache::StatementCount> queries;
+    std::array<bool, StatementCache::StatementCount> inUse = {};
+};
+
+// Koneksi QSqlDatabase terikat ke satu thread, jadi cache juga per thread tanpa lock
+thread_local QHash<QString, std::shared_ptr<Connection>> t_connections;
+
+} // namespace
+
+StatementCache::Query::Query(Statement statement, QSqlQuery *query, bool *inUse, std::unique_ptr<QSqlQuery> local,
+                             std::shared_ptr<void> owner)
+    : m_statement(statement)
+    , m_query(query)
+    , m_inUse(inUse)
+    , m_local(std::move(local))
+    , m_owner(std::move(owner))
+{
+}
+
+StatementCache::Query::Query(Query &&other) noexcept
+    : m_statement(other.m_statement)
+    , m_query(std::exchange(other.m_query, nullptr))
+    , m_inUse(std::exchange(other.m_inUse, nullptr))
+    , m_local(std::move(other.m_local))
+    , m_owner(std::move(other.m_owner))
+{
+}
+
+StatementCache::Query::~Query()
+{
+    if (m_query) {
+        m_query->finish();
+    }
+    if (m_inUse) {
+        *m_inUse = false;
+    }
+}
+
+bool StatementCache::Query::exec()
+{
+    QElapsedTimer timer;
+    timer.start();
+    const bool ok = m_query->exec();
+    PerfStats::record(kDefinitions[m_statement].perfName, timer.nsecsElapsed());
+    return ok;
+}
+
+StatementCache::Query StatementCache::get(const QSqlDatabase &db, Statement statement)
+{
+    if (!db.isOpen()) {
+        qWarning() << "Cannot prepare" << name(statement) << ": Database is not open";
+        return Query(statement, nullptr, nullptr, nullptr);
+    }
+
+    std::shared_ptr<Connection> &connection = t_connections[db.connectionName()];
+    if (!connection) {
+        connection = std::make_shared<Connection>();
+    }
+
+    // Pemakaian bersarang statement yang sama memakai statement sementara
+    if (connection->inUse[statement]) {
+        auto local = std::make_unique<QSqlQuery>(db);
+        if (!local->prepare(kDefinitions[statement].sql)) {
+            qWarning() << "Failed to prepare" << name(statement) << ":" << local->lastError().text();
+            return Query(statement, nullptr, nullptr, nullptr);
+        }
+        QSqlQuery *query = local.get();
+        return Query(statement, query, nullptr, std::move(local));
+    }
+
+    std::unique_ptr<QSqlQuery> &slot = connection->queries[statement];
+    if (!slot) {
+        auto query = std::make_unique<QSqlQuery>(db);
+        if (!query->prepare(kDefinitions[statement].sql)) {
+            qWarning() << "Failed to prepare" << name(statement) << ":" << query->lastError().text();
+            return Query(statement, nullptr, nullptr, nullptr);
+        }
+        slot = std::move(query);
+    }
+    connection->inUse[statement] = true;
+    return Query(statement, slot.get(), &connection->inUse[statement], nullptr, connection);
+}
+
+void StatementCache::release(const QString &connectionName)
+{
+    t_connections.remove(connectionName);
+}
+
+const char *StatementCache::name(Statement statement)
+{
+    return kDefinitions[statement].name;
+}
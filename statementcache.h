@@ -0,0 +1,67 @@
+#ifndef STATEMENTCACHE_H
+#define STATEMENTCACHE_H
+
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QString>
+#include <memory>
+
+// Registry statement SQL yang sering dipakai. Setiap statement di-prepare
+// sekali per koneksi (per thread pemilik koneksi) lalu dipakai ulang dengan
+// binding baru, sehingga SQLite tidak mengompilasi ulang SQL yang sama.
+// Setiap exec() dicatat di PerfStats sebagai "stmt.<nama>" (jumlah, total, persentil).
+class StatementCache
+{
+public:
+    enum Statement {
+        LogInsert,
+        WorkTimeSelect,
+        WorkTimeUpsert,
+        TaskTimeUsageSelect,
+        TaskNameSelect,
+        TaskOwnedSelect,
+        TaskStatusUpdate,
+        UsernameSelect,
+        ProfileImageSelect,
+        StatementCount
+    };
+
+    // Pegangan ke statement yang sudah di-prepare. finish() dipanggil saat keluar
+    // scope agar kursor SELECT tidak menahan read lock.
+    class Query
+    {
+    public:
+        Query(Query &&other) noexcept;
+        ~Query();
+
+        Query(const Query &) = delete;
+        Query &operator=(const Query &) = delete;
+        Query &operator=(Query &&) = delete;
+
+        bool isValid() const { return m_query != nullptr; }
+        QSqlQuery *operator->() const { return m_query; }
+        QSqlQuery &operator*() const { return *m_query; }
+        bool exec();
+
+    private:
+        friend class StatementCache;
+        Query(Statement statement, QSqlQuery *query, bool *inUse, std::unique_ptr<QSqlQuery> local,
+              std::shared_ptr<void> owner = nullptr);
+
+        Statement m_statement;
+        QSqlQuery *m_query = nullptr;
+        bool *m_inUse = nullptr;              // slot cache yang sedang dipinjam
+        std::unique_ptr<QSqlQuery> m_local;   // statement sementara jika slot sedang dipakai
+        std::shared_ptr<void> m_owner;        // menjaga slot tetap hidup walau release() dipanggil
+    };
+
+    static Query get(const QSqlDatabase &db, Statement statement);
+
+    // Harus dipanggil di thread pemilik koneksi sebelum koneksi ditutup dan
+    // sebelum koneksi yang tertutup dibuka lagi; statement lama sudah di-finalize driver
+    static void release(const QString &connectionName);
+
+    static const char *name(Statement statement);
+};
+
+#endif // STATEMENTCACHE_H
@@ -0,0 +1,84 @@
+#include "storageworker.h"
+#include "logcategories.h"
+#include "statementcache.h"
+#include <QSqlError>
+#include <QDebug>
+
+namespace {
+
+const char *const kConnectionNames[] = {"storage_activity", "storage_productivity"};
+
+} // namespace
+
+StorageWorker::StorageWorker(const QString &activityPath, const QString &productivityPath,
+                             const SqliteSetup::Profile &profile, QObject *parent)
+    : QObject(parent)
+    , m_profile(profile)
+{
+    m_paths[Activity] = activityPath;
+    m_paths[Productivity] = productivityPath;
+
+    m_thread.setObjectName("DeskmonStorage");
+    m_context = new QObject;
+    m_context->moveToThread(&m_thread);
+    m_thread.start();
+}
+
+StorageWorker::~StorageWorker()
+{
+    stop();
+}
+
+void StorageWorker::post(std::function<void()> task)
+{
+    if (m_stopped) {
+        qWarning() << "Storage worker already stopped, job dropped";
+        return;
+    }
+    QMetaObject::invokeMethod(m_context, std::move(task), Qt::QueuedConnection);
+}
+
+QSqlDatabase &StorageWorker::connection(Database which)
+{
+    // Dibuka malas di thread storage; QSqlDatabase tidak boleh dipakai lintas thread
+    QSqlDatabase &db = m_connections[which];
+    if (!db.isValid()) {
+        db = QSqlDatabase::addDatabase("QSQLITE", kConnectionNames[which]);
+        db.setDatabaseName(m_paths[which]);
+    }
+    if (!db.isOpen()) {
+        StatementCache::release(kConnectionNames[which]);
+        if (db.open()) {
+            SqliteSetup::applyProfile(db, m_profile);
+            qCDebug(lcDb) << "Storage worker opened" << m_paths[which];
+        } else {
+            qWarning() << "Storage worker failed to open" << m_paths[which] << ":" << db.lastError().text();
+        }
+    }
+    return db;
+}
+
+void StorageWorker::stop()
+{
+    if (m_stopped) {
+        return;
+    }
+
+    // Blocking: semua job sebelumnya selesai dulu, lalu koneksi ditutup di thread pemiliknya
+    QMetaObject::invokeMethod(m_context, [this]() {
+        for (int i = 0; i < 2; ++i) {
+            if (m_connections[i].isValid()) {
+                StatementCache::release(kConnectionNames[i]);
+                m_connections[i].close();
+                m_connections[i] = QSqlDatabase();
+                QSqlDatabase::removeDatabase(kConnectionNames[i]);
+            }
+        }
+    }, Qt::BlockingQueuedConnection);
+    m_stopped = true;
+
+    m_thread.quit();
+    m_thread.wait();
+    delete m_context;
+    m_context = nullptr;
+}
@@ -0,0 +1,64 @@
+#ifndef STORAGEWORKER_H
+#define STORAGEWORKER_H
+
+#include <QObject>
+#include <QThread>
+#include <QFuture>
+#include <QPromise>
+#include <QSqlDatabase>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include "sqlitesetup.h"
+
+// Thread penyimpanan yang memiliki koneksi SQLite sendiri ke kedua database.
+// Job dijalankan berurutan (FIFO), jadi query yang diantrekan setelah sebuah
+// write selalu melihat hasil write tersebut. Hasil dikembalikan sebagai QFuture;
+// pakai future.then(context, ...) agar lanjutan berjalan di thread GUI.
+class StorageWorker : public QObject
+{
+    Q_OBJECT
+public:
+    enum Database { Activity, Productivity };
+
+    StorageWorker(const QString &activityPath, const QString &productivityPath,
+                  const SqliteSetup::Profile &profile, QObject *parent = nullptr);
+    ~StorageWorker();
+
+    template <typename Job>
+    auto run(Database which, Job job) -> QFuture<std::invoke_result_t<Job, QSqlDatabase &>>
+    {
+        using Result = std::invoke_result_t<Job, QSqlDatabase &>;
+        auto promise = std::make_shared<QPromise<Result>>();
+        QFuture<Result> future = promise->future();
+        post([this, which, promise, job = std::move(job)]() mutable {
+            promise->start();
+            QSqlDatabase &db = connection(which);
+            if constexpr (std::is_void_v<Result>) {
+                job(db);
+            } else {
+                promise->addResult(job(db));
+            }
+            promise->finish();
+        });
+        return future;
+    }
+
+    // Menutup koneksi dan menghentikan thread setelah job terakhir selesai.
+    // Job yang diantrekan sesudahnya dibuang; write terakhir harus lewat koneksi GUI.
+    void stop();
+    bool isStopped() const { return m_stopped; }
+
+private:
+    void post(std::function<void()> task);
+    QSqlDatabase &connection(Database which);
+
+    QThread m_thread;
+    QObject *m_context = nullptr; // hidup di m_thread, target invokeMethod
+    QString m_paths[2];
+    QSqlDatabase m_connections[2]; // hanya disentuh dari m_thread
+    SqliteSetup::Profile m_profile;
+    bool m_stopped = false;
+};
+
+#endif // STORAGEWORKER_H
@@ -0,0 +1,265 @@
+#include "tasklistmodel.h"
+#include "perfstats.h"
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QDebug>
+#include <algorithm>
+
+TaskListModel::TaskListModel(QObject *parent)
+    : QAbstractListModel(parent)
+    , m_activeTask(new ActiveTask(this))
+{
+}
+
+bool TaskListModel::fetch(QSqlDatabase &db, int userId, QVector<Task> &tasks)
+{
+    ScopedPerfTimer perf("sql.task_list");
+    tasks.clear();
+    if (userId != -1 && db.isOpen()) {
+        QSqlQuery query(db);
+        query.prepare("SELECT id, project_name, task, max_time, time_usage, status FROM task WHERE user_id = :user_id");
+        query.bindValue(":user_id", userId);
+        if (!query.exec()) {
+            qWarning() << "Failed to fetch tasks:" << query.lastError().text();
+            return false;
+        }
+        while (query.next()) {
+            Task task;
+            task.id = query.value(0).toInt();
+            task.projectName = query.value(1).toString();
+            task.task = query.value(2).toString();
+            task.maxTime = query.value(3).toInt();
+            task.timeUsage = query.value(4).toInt();
+            task.rawStatus = query.value(5).toString();
+            tasks.append(task);
+        }
+    }
+    return true;
+}
+
+void TaskListModel::setTasks(QVector<Task> tasks)
+{
+    std::sort(tasks.begin(), tasks.end(), [this](const Task &a, const Task &b) { return lessThan(a, b); });
+
+    bool sameRows = tasks.size() == m_tasks.size();
+    for (int i = 0; sameRows && i < tasks.size(); ++i) {
+        sameRows = tasks[i].id == m_tasks[i].id;
+    }
+
+    if (!sameRows) {
+        beginResetModel();
+        m_tasks = tasks;
+        rebuildIndex();
+        endResetModel();
+    } else {
+        // Urutan sama: cukup beri tahu baris yang isinya berubah
+        for (int i = 0; i < tasks.size(); ++i) {
+            if (!(tasks[i] == m_tasks[i])) {
+                m_tasks[i] = tasks[i];
+                emitRowChanged(i);
+            }
+        }
+    }
+    updateActiveTask();
+}
+
+void TaskListModel::setActiveTask(int taskId, bool paused)
+{
+    if (taskId == m_activeTaskId && paused == m_paused) {
+        return;
+    }
+
+    const int previousId = m_activeTaskId;
+    m_activeTaskId = taskId;
+    m_paused = paused;
+
+    // Task aktif selalu di atas; paling banyak dua baris yang berpindah. Baris aktif
+    // baru dipindah dulu agar posisi baris lama dihitung terhadap urutan yang sudah benar.
+    auto current = m_rowById.constFind(taskId);
+    if (taskId != previousId && current != m_rowById.constEnd()) {
+        emitRowChanged(current.value());
+        moveToSortedPosition(current.value());
+    }
+    auto previous = m_rowById.constFind(previousId);
+    if (previous != m_rowById.constEnd()) {
+        emitRowChanged(previous.value());
+        moveToSortedPosition(previous.value());
+    }
+    updateActiveTask();
+}
+
+void TaskListModel::updateStatus(int taskId, const QString &status)
+{
+    auto it = m_rowById.constFind(taskId);
+    if (it == m_rowById.constEnd() || m_tasks[it.value()].rawStatus == status) {
+        return;
+    }
+    m_tasks[it.value()].rawStatus = status;
+    emitRowChanged(it.value());
+    if (taskId == m_activeTaskId) {
+        updateActiveTask();
+    }
+}
+
+void TaskListModel::updateTimeUsage(int taskId, int timeUsage)
+{
+    auto it = m_rowById.constFind(taskId);
+    if (it == m_rowById.constEnd() || m_tasks[it.value()].timeUsage == timeUsage) {
+        return;
+    }
+    m_tasks[it.value()].timeUsage = timeUsage;
+    emitRowChanged(it.value());
+    if (taskId == m_activeTaskId) {
+        updateActiveTask();
+    }
+}
+
+QVariantList TaskListModel::toVariantList() const
+{
+    QVariantList tasks;
+    tasks.reserve(m_tasks.size());
+    for (const Task &task : m_tasks) {
+        QVariantMap map;
+        map["id"] = task.id;
+        map["project_name"] = task.projectName;
+        map["task"] = task.task;
+        map["max_time"] = task.maxTime;
+        map["time_usage"] = task.timeUsage;
+        map["active"] = task.id == m_activeTaskId;
+        map["status"] = statusFor(task);
+        tasks.append(map);
+    }
+    return tasks;
+}
+
+int TaskListModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : m_tasks.size();
+}
+
+QVariant TaskListModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() < 0 || index.row() >= m_tasks.size()) {
+        return QVariant();
+    }
+
+    const Task &task = m_tasks[index.row()];
+    const bool active = task.id == m_activeTaskId;
+    switch (role) {
+    case IdRole:
+        return task.id;
+    case Qt::DisplayRole:
+    case ProjectNameRole:
+        return task.projectName;
+    case TaskRole:
+        return task.task;
+    case MaxTimeRole:
+        return task.maxTime;
+    case TimeUsageRole:
+        return task.timeUsage;
+    case ActiveRole:
+        return active;
+    case StatusRole:
+        return statusFor(task);
+    case PausedRole:
+        return active && m_paused;
+    default:
+        return QVariant();
+    }
+}
+
+QHash<int, QByteArray> TaskListModel::roleNames() const
+{
+    // Nama role sama dengan key QVariantMap lama agar delegate QML tidak berubah
+    return {
+        {IdRole, "id"},
+        {ProjectNameRole, "project_name"},
+        {TaskRole, "task"},
+        {MaxTimeRole, "max_time"},
+        {TimeUsageRole, "time_usage"},
+        {ActiveRole, "active"},
+        {StatusRole, "status"},
+        {PausedRole, "isTaskPaused"}
+    };
+}
+
+QString TaskListModel::statusFor(const Task &task) const
+{
+    if (task.rawStatus.toLower() == "review") {
+        return "Review"; // Task is under review - keep original status
+    }
+    if (task.id == m_activeTaskId) {
+        return m_paused ? "Paused" : "Is Running";
+    }
+    return "Pending";
+}
+
+bool TaskListModel::lessThan(const Task &a, const Task &b) const
+{
+    const bool aActive = a.id == m_activeTaskId;
+    const bool bActive = b.id == m_activeTaskId;
+    if (aActive != bActive) {
+        return aActive;
+    }
+    return a.id < b.id;
+}
+
+void TaskListModel::moveToSortedPosition(int row)
+{
+    int target = 0;
+    for (int i = 0; i < m_tasks.size(); ++i) {
+        if (i != row && lessThan(m_tasks[i], m_tasks[row])) {
+            ++target;
+        }
+    }
+    if (target == row) {
+        return;
+    }
+
+    // Indeks tujuan beginMoveRows memakai koordinat sebelum baris dipindah
+    beginMoveRows(QModelIndex(), row, row, QModelIndex(), target > row ? target + 1 : target);
+    m_tasks.move(row, target);
+    endMoveRows();
+    rebuildIndex();
+}
+
+void TaskListModel::rebuildIndex()
+{
+    m_rowById.clear();
+    m_rowById.reserve(m_tasks.size());
+    for (int i = 0; i < m_tasks.size(); ++i) {
+        m_rowById.insert(m_tasks[i].id, i);
+    }
+}
+
+void TaskListModel::emitRowChanged(int row)
+{
+    const QModelIndex changed = index(row);
+    emit dataChanged(changed, changed);
+}
+
+void TaskListModel::updateActiveTask()
+{
+    ActiveTask *active = m_activeTask;
+    auto it = m_rowById.constFind(m_activeTaskId);
+    const Task *task = it == m_rowById.constEnd() ? nullptr : &m_tasks[it.value()];
+
+    const int taskId = task ? task->id : -1;
+    const QString status = task ? statusFor(*task) : QString();
+    if (task && active->m_taskId == taskId && active->m_projectName == task->projectName &&
+        active->m_task == task->task && active->m_maxTime == task->maxTime &&
+        active->m_timeUsage == task->timeUsage && active->m_status == status) {
+        return;
+    }
+    if (!task && active->m_taskId == -1) {
+        return;
+    }
+
+    active->m_taskId = taskId;
+    active->m_projectName = task ? task->projectName : QString();
+    active->m_task = task ? task->task : QString();
+    active->m_maxTime = task ? task->maxTime : 0;
+    active->m_timeUsage = task ? task->timeUsage : 0;
+    active->m_status = status;
+    emit active->changed();
+}
@@ -0,0 +1,108 @@
+#ifndef TASKLISTMODEL_H
+#define TASKLISTMODEL_H
+
+#include <QAbstractListModel>
+#include <QSqlDatabase>
+#include <QVector>
+#include <QHash>
+#include <QVariantList>
+
+// Ringkasan task aktif untuk binding QML, tanpa perlu mencari di daftar task
+class ActiveTask : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(bool valid READ valid NOTIFY changed)
+    Q_PROPERTY(int taskId READ taskId NOTIFY changed)
+    Q_PROPERTY(QString projectName READ projectName NOTIFY changed)
+    Q_PROPERTY(QString task READ task NOTIFY changed)
+    Q_PROPERTY(int maxTime READ maxTime NOTIFY changed)
+    Q_PROPERTY(int timeUsage READ timeUsage NOTIFY changed)
+    Q_PROPERTY(QString status READ status NOTIFY changed)
+public:
+    explicit ActiveTask(QObject *parent = nullptr) : QObject(parent) {}
+
+    bool valid() const { return m_taskId != -1; }
+    int taskId() const { return m_taskId; }
+    QString projectName() const { return m_projectName; }
+    QString task() const { return m_task; }
+    int maxTime() const { return m_maxTime; }
+    int timeUsage() const { return m_timeUsage; }
+    QString status() const { return m_status; }
+
+signals:
+    void changed();
+
+private:
+    friend class TaskListModel;
+
+    int m_taskId = -1;
+    QString m_projectName;
+    QString m_task;
+    int m_maxTime = 0;
+    int m_timeUsage = 0;
+    QString m_status;
+};
+
+// Cache task milik user yang sedang login. Reload dibandingkan dengan isi cache
+// sehingga perubahan satu task hanya menghasilkan dataChanged untuk barisnya.
+class TaskListModel : public QAbstractListModel
+{
+    Q_OBJECT
+public:
+    enum Roles {
+        IdRole = Qt::UserRole + 1,
+        ProjectNameRole,
+        TaskRole,
+        MaxTimeRole,
+        TimeUsageRole,
+        ActiveRole,
+        StatusRole,
+        PausedRole
+    };
+
+    struct Task {
+        int id = 0;
+        QString projectName;
+        QString task;
+        int maxTime = 0;
+        int timeUsage = 0;
+        QString rawStatus;
+
+        bool operator==(const Task &other) const {
+            return id == other.id && projectName == other.projectName && task == other.task &&
+                   maxTime == other.maxTime && timeUsage == other.timeUsage && rawStatus == other.rawStatus;
+        }
+    };
+
+    explicit TaskListModel(QObject *parent = nullptr);
+
+    ActiveTask *activeTask() const { return m_activeTask; }
+
+    // fetch() boleh dipanggil dari thread storage; setTasks() di thread GUI
+    static bool fetch(QSqlDatabase &db, int userId, QVector<Task> &tasks);
+    void setTasks(QVector<Task> tasks);
+    void setActiveTask(int taskId, bool paused);
+    void updateStatus(int taskId, const QString &status);
+    void updateTimeUsage(int taskId, int timeUsage);
+    QVariantList toVariantList() const;
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+private:
+    QString statusFor(const Task &task) const;
+    bool lessThan(const Task &a, const Task &b) const;
+    void moveToSortedPosition(int row);
+    void rebuildIndex();
+    void emitRowChanged(int row);
+    void updateActiveTask();
+
+    QVector<Task> m_tasks;
+    QHash<int, int> m_rowById;
+    int m_activeTaskId = -1;
+    bool m_paused = false;
+    ActiveTask *m_activeTask;
+};
+
+#endif // TASKLISTMODEL_H
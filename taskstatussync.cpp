@@ -0,0 +1,258 @@
+#include "taskstatussync.h"
+#include "logcategories.h"
+#include "perfstats.h"
+#include <QNetworkReply>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QDateTime>
+#include <QUrl>
+#include <QDebug>
+#include <utility>
+
+namespace {
+
+// Batas request per task yang berjalan bersamaan saat endpoint bulk tidak ada
+const int kMaxConcurrentRequests = 4;
+// Status yang diperiksa dalam rentang ini tidak ditanyakan lagi
+const qint64 kStatusTtlSeconds = 60;
+
+bool isMissingEndpoint(int httpStatus)
+{
+    return httpStatus == 404 || httpStatus == 405 || httpStatus == 501;
+}
+
+} // namespace
+
+TaskStatusSync::TaskStatusSync(QNetworkAccessManager *network, QObject *parent)
+    : QObject(parent)
+    , m_network(network)
+{
+}
+
+void TaskStatusSync::setApiBaseUrl(const QString &baseUrl)
+{
+    m_baseUrl = baseUrl;
+}
+
+void TaskStatusSync::sync(const QList<int> &taskIds, const QString &token, bool force)
+{
+    if (token.isEmpty()) {
+        qWarning() << "Cannot sync task status: No authentication token";
+        return;
+    }
+    m_token = token;
+
+    if (m_running) {
+        for (int taskId : taskIds) {
+            m_pendingIds.insert(taskId);
+        }
+        m_pendingForce = m_pendingForce || force;
+        return;
+    }
+
+    const qint64 now = QDateTime::currentSecsSinceEpoch();
+    QList<int> batch;
+    for (int taskId : taskIds) {
+        if (taskId <= 0 || batch.contains(taskId)) {
+            continue;
+        }
+        auto cached = m_cache.constFind(taskId);
+        if (!force && cached != m_cache.constEnd() && now - cached->checkedAt < kStatusTtlSeconds) {
+            continue;
+        }
+        batch.append(taskId);
+    }
+    if (batch.isEmpty()) {
+        qCDebug(lcTasks) << "Task status cache is fresh, nothing to sync";
+        return;
+    }
+
+    m_running = true;
+    m_batch = batch;
+    m_changed.clear();
+    if (m_bulkSupport == BulkSupport::Unsupported) {
+        m_queue = m_batch;
+        sendNextPerTask();
+    } else {
+        sendBulk();
+    }
+}
+
+void TaskStatusSync::invalidate(int taskId)
+{
+    // Entri dibuang seluruhnya: status lokal sudah diubah aksi user, jadi jawaban
+    // server berikutnya harus diterapkan walau sama dengan status lama di cache
+    m_cache.remove(taskId);
+}
+
+void TaskStatusSync::clear()
+{
+    ++m_generation;
+    m_cache.clear();
+    m_bulkSupport = BulkSupport::Unknown;
+    m_running = false;
+    m_batch.clear();
+    m_queue.clear();
+    m_inFlight = 0;
+    m_changed.clear();
+    m_pendingIds.clear();
+    m_pendingForce = false;
+    m_token.clear();
+}
+
+QNetworkRequest TaskStatusSync::makeRequest(const QString &path) const
+{
+    QNetworkRequest request(QUrl(m_baseUrl + '/' + path));
+    request.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
+    request.setRawHeader("Authorization", "Bearer " + m_token.toUtf8());
+    return request;
+}
+
+void TaskStatusSync::sendBulk()
+{
+    QJsonArray ids;
+    for (int taskId : std::as_const(m_batch)) {
+        ids.append(taskId);
+    }
+    QJsonObject body;
+    body["task_ids"] = ids;
+
+    QNetworkReply *reply = m_network->post(makeRequest(QStringLiteral("get-current-task-status/bulk")),
+                                           QJsonDocument(body).toJson(QJsonDocument::Compact));
+    PerfStats::trackReply(reply, "api.get-current-task-status.bulk");
+    const quint64 generation = m_generation;
+    connect(reply, &QNetworkReply::finished, this, [this, reply, generation]() {
+        reply->deleteLater();
+        if (generation == m_generation) {
+            handleBulkReply(reply);
+        }
+    });
+}
+
+void TaskStatusSync::handleBulkReply(QNetworkReply *reply)
+{
+    const int httpStatus = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    if (isMissingEndpoint(httpStatus)) {
+        // Server lama: ingat sampai clear() dan pakai endpoint per task
+        qCDebug(lcTasks) << "Bulk task status endpoint unavailable (HTTP" << httpStatus << "), using per-task requests";
+        m_bulkSupport = BulkSupport::Unsupported;
+        m_queue = m_batch;
+        sendNextPerTask();
+        return;
+    }
+    if (reply->error() != QNetworkReply::NoError) {
+        qWarning() << "Failed to sync task status: Network error:" << reply->errorString();
+        finish();
+        return;
+    }
+
+    const QByteArray responseData = reply->readAll();
+    const QJsonObject jsonObj = QJsonDocument::fromJson(responseData).object();
+    if (!jsonObj["success"].toBool()) {
+        qWarning() << "Bulk task status API failed:" << jsonObj["message"].toString();
+        finish();
+        return;
+    }
+    m_bulkSupport = BulkSupport::Supported;
+
+    // data: [{"id": 12, "status": "pending"}, ...] atau {"12": "pending", ...}
+    const QJsonValue data = jsonObj["data"];
+    if (data.isArray()) {
+        for (const QJsonValue &item : data.toArray()) {
+            const QJsonObject task = item.toObject();
+            store(task["id"].toInt(), task["status"].toString(), QByteArray());
+        }
+    } else {
+        const QJsonObject map = data.toObject();
+        for (auto it = map.constBegin(); it != map.constEnd(); ++it) {
+            store(it.key().toInt(), it.value().toString(), QByteArray());
+        }
+    }
+    finish();
+}
+
+void TaskStatusSync::sendNextPerTask()
+{
+    while (m_inFlight < kMaxConcurrentRequests && !m_queue.isEmpty()) {
+        const int taskId = m_queue.takeFirst();
+        QNetworkRequest request = makeRequest(QString("get-current-task-status/%1").arg(taskId));
+        auto cached = m_cache.constFind(taskId);
+        if (cached != m_cache.constEnd() && !cached->etag.isEmpty()) {
+            request.setRawHeader("If-None-Match", cached->etag);
+        }
+
+        QNetworkReply *reply = m_network->get(request);
+        PerfStats::trackReply(reply, "api.get-current-task-status");
+        ++m_inFlight;
+        const quint64 generation = m_generation;
+        connect(reply, &QNetworkReply::finished, this, [this, reply, taskId, generation]() {
+            reply->deleteLater();
+            if (generation == m_generation) {
+                handlePerTaskReply(reply, taskId);
+            }
+        });
+    }
+
+    if (m_inFlight == 0 && m_queue.isEmpty()) {
+        finish();
+    }
+}
+
+void TaskStatusSync::handlePerTaskReply(QNetworkReply *reply, int taskId)
+{
+    --m_inFlight;
+
+    const int httpStatus = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    if (httpStatus == 304) {
+        auto it = m_cache.find(taskId);
+        if (it != m_cache.end()) {
+            it->checkedAt = QDateTime::currentSecsSinceEpoch();
+        }
+    } else if (reply->error() != QNetworkReply::NoError) {
+        qWarning() << "Failed to get task status for taskId" << taskId << ": Network error:" << reply->errorString();
+    } else {
+        const QByteArray responseData = reply->readAll();
+        const QJsonObject jsonObj = QJsonDocument::fromJson(responseData).object();
+        const QString apiStatus = jsonObj["data"].toString();
+        if (!jsonObj["success"].toBool() || apiStatus.isEmpty()) {
+            qWarning() << "Task status API failed for taskId" << taskId << ":" << responseData;
+        } else {
+            store(taskId, apiStatus, reply->rawHeader("ETag"));
+        }
+    }
+
+    sendNextPerTask();
+}
+
+void TaskStatusSync::store(int taskId, const QString &status, const QByteArray &etag)
+{
+    if (taskId <= 0 || status.isEmpty()) {
+        return;
+    }
+
+    CacheEntry &entry = m_cache[taskId];
+    if (entry.status != status) {
+        m_changed.insert(taskId, status);
+    }
+    entry.status = status;
+    entry.etag = etag;
+    entry.checkedAt = QDateTime::currentSecsSinceEpoch();
+}
+
+void TaskStatusSync::finish()
+{
+    m_running = false;
+    m_batch.clear();
+    const QHash<int, QString> changed = std::exchange(m_changed, {});
+    if (!changed.isEmpty()) {
+        emit statusesChanged(changed);
+    }
+
+    if (!m_pendingIds.isEmpty()) {
+        const QList<int> pending = m_pendingIds.values();
+        const bool force = std::exchange(m_pendingForce, false);
+        m_pendingIds.clear();
+        sync(pending, m_token, force);
+    }
+}
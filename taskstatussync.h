@@ -0,0 +1,71 @@
+#ifndef TASKSTATUSSYNC_H
+#define TASKSTATUSSYNC_H
+
+#include <QObject>
+#include <QNetworkAccessManager>
+#include <QNetworkRequest>
+#include <QHash>
+#include <QSet>
+#include <QList>
+
+class QNetworkReply;
+
+// Sinkronisasi status task dari server. Jalur utama adalah satu request bulk
+// untuk semua id; jika server belum punya endpoint bulk (404/405/501), sync
+// jatuh ke endpoint per task dengan konkurensi terbatas dan If-None-Match.
+// Status disimpan dengan TTL sehingga sync berulang tidak menanyakan ulang
+// task yang baru saja diperiksa.
+class TaskStatusSync : public QObject
+{
+    Q_OBJECT
+public:
+    explicit TaskStatusSync(QNetworkAccessManager *network, QObject *parent = nullptr);
+
+    void setApiBaseUrl(const QString &baseUrl);
+
+    // Id yang statusnya masih segar di cache dilewati kecuali force. Sync yang
+    // diminta selama sync lain berjalan digabung dan dijalankan sesudahnya.
+    void sync(const QList<int> &taskIds, const QString &token, bool force = false);
+    // Dipanggil saat aksi lokal (play, pause, selesai) mengubah status task di server
+    void invalidate(int taskId);
+    void clear();
+    bool isRunning() const { return m_running; }
+
+signals:
+    // Hanya status yang berbeda dari nilai terakhir yang diketahui; satu emit per sync
+    void statusesChanged(const QHash<int, QString> &statuses);
+
+private:
+    enum class BulkSupport { Unknown, Supported, Unsupported };
+
+    struct CacheEntry {
+        QString status;
+        QByteArray etag;
+        qint64 checkedAt = 0; // epoch detik
+    };
+
+    void sendBulk();
+    void handleBulkReply(QNetworkReply *reply);
+    void sendNextPerTask();
+    void handlePerTaskReply(QNetworkReply *reply, int taskId);
+    void store(int taskId, const QString &status, const QByteArray &etag);
+    void finish();
+    QNetworkRequest makeRequest(const QString &path) const;
+
+    QNetworkAccessManager *m_network;
+    QString m_baseUrl;
+    QString m_token;
+    QHash<int, CacheEntry> m_cache;
+    BulkSupport m_bulkSupport = BulkSupport::Unknown;
+
+    bool m_running = false;
+    QList<int> m_batch;          // id dalam sync yang sedang berjalan
+    QList<int> m_queue;          // id yang belum dikirim lewat endpoint per task
+    int m_inFlight = 0;
+    QHash<int, QString> m_changed;
+    QSet<int> m_pendingIds;
+    bool m_pendingForce = false;
+    quint64 m_generation = 0;    // dinaikkan clear(); balasan dari sync lama diabaikan
+};
+
+#endif // TASKSTATUSSYNC_H
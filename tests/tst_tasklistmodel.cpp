@@ -0,0 +1,68 @@
+// Uji urutan baris TaskListModel saat task aktif berganti.
+//
+//   cmake -DDESKMON_BUILD_TESTS=ON ... && ctest
+
+#include <QtTest>
+#include <QAbstractItemModelTester>
+#include "tasklistmodel.h"
+
+class TaskListModelTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void activeTaskMovesToTop_data();
+    void activeTaskMovesToTop();
+
+private:
+    static QList<int> rowIds(const TaskListModel &model);
+};
+
+QList<int> TaskListModelTest::rowIds(const TaskListModel &model)
+{
+    QList<int> ids;
+    for (int row = 0; row < model.rowCount(); ++row) {
+        ids.append(model.data(model.index(row), TaskListModel::IdRole).toInt());
+    }
+    return ids;
+}
+
+void TaskListModelTest::activeTaskMovesToTop_data()
+{
+    QTest::addColumn<int>("from");
+    QTest::addColumn<int>("to");
+    QTest::addColumn<QList<int>>("expected");
+
+    QTest::newRow("none_to_middle") << -1 << 2 << QList<int>{2, 1, 3};
+    QTest::newRow("first_to_last") << 1 << 3 << QList<int>{3, 1, 2};
+    QTest::newRow("last_to_first") << 3 << 1 << QList<int>{1, 2, 3};
+    QTest::newRow("middle_to_last") << 2 << 3 << QList<int>{3, 1, 2};
+    QTest::newRow("last_to_none") << 3 << -1 << QList<int>{1, 2, 3};
+}
+
+void TaskListModelTest::activeTaskMovesToTop()
+{
+    QFETCH(int, from);
+    QFETCH(int, to);
+    QFETCH(QList<int>, expected);
+
+    TaskListModel model;
+    QAbstractItemModelTester tester(&model, QAbstractItemModelTester::FailureReportingMode::QtTest);
+
+    QVector<TaskListModel::Task> tasks;
+    for (int id : {1, 2, 3}) {
+        TaskListModel::Task task;
+        task.id = id;
+        task.task = QString("Task %1").arg(id);
+        tasks.append(task);
+    }
+    model.setActiveTask(from, false);
+    model.setTasks(tasks);
+
+    model.setActiveTask(to, false);
+    QCOMPARE(rowIds(model), expected);
+    QCOMPARE(model.activeTask()->taskId(), to);
+}
+
+QTEST_GUILESS_MAIN(TaskListModelTest)
+#include "tst_tasklistmodel.moc"
@@ -0,0 +1,64 @@
+// Mock Deskmon API untuk uji jaringan dan beban.
+//
+//   deskmon_mockserver --port 8088 --latency 500 --error-rate 0.2
+//   DESKMON_API_BASE_URL=http://127.0.0.1:8088/api ./Deskmon
+//
+// Fault dapat diubah saat berjalan lewat POST /mock/config dengan JSON yang
+// sama (latency_ms, jitter_ms, error_rate, unauthorized_rate, drop_rate,
+// refresh_every, settings_version, only, tasks, apps, bulk_task_status). GET /mock/stats
+// mengembalikan jumlah request per endpoint dan pengiriman ganda (Idempotency-Key).
+// POST /mock/task-status {"id": 1001, "status": "on-review"} mengubah status task
+// yang dilaporkan endpoint get-current-task-status (per task dan bulk).
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QJsonObject>
+#include <QDebug>
+#include "mockapiserver.h"
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    app.setApplicationName("deskmon_mockserver");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Local mock of the Deskmon API");
+    parser.addHelpOption();
+    parser.addOptions({
+        {"port", "Port to listen on (localhost only).", "port", "8088"},
+        {"latency", "Delay before every response, in ms.", "ms", "0"},
+        {"jitter", "Extra random delay [0, ms].", "ms", "0"},
+        {"error-rate", "Probability of HTTP 503.", "p", "0"},
+        {"unauthorized-rate", "Probability of HTTP 401 (except /login).", "p", "0"},
+        {"drop-rate", "Probability of closing the connection without a response.", "p", "0"},
+        {"refresh-every", "Set refresh_required on every Nth ping.", "n", "0"},
+        {"settings-version", "settings_version returned by /ping.", "version", "0"},
+        {"only", "Apply faults only to paths with this prefix.", "prefix"},
+        {"tasks", "Number of tasks returned by /task-by-user.", "n", "20"},
+        {"apps", "Number of rules returned by /app-request/all.", "n", "50"},
+        {"no-bulk-task-status", "Answer /get-current-task-status/bulk with 404 (per-task fallback)."},
+    });
+    parser.process(app);
+
+    QJsonObject config;
+    config["latency_ms"] = parser.value("latency").toInt();
+    config["jitter_ms"] = parser.value("jitter").toInt();
+    config["error_rate"] = parser.value("error-rate").toDouble();
+    config["unauthorized_rate"] = parser.value("unauthorized-rate").toDouble();
+    config["drop_rate"] = parser.value("drop-rate").toDouble();
+    config["refresh_every"] = parser.value("refresh-every").toInt();
+    config["settings_version"] = parser.value("settings-version").toLongLong();
+    config["only"] = parser.value("only");
+    config["tasks"] = parser.value("tasks").toInt();
+    config["apps"] = parser.value("apps").toInt();
+    config["bulk_task_status"] = !parser.isSet("no-bulk-task-status");
+
+    MockApiServer server;
+    MockApiServer::applyConfig(server.faults(), config);
+    if (!server.listen(quint16(parser.value("port").toUInt()))) {
+        return 1;
+    }
+
+    qInfo().noquote() << QString("Mock Deskmon API listening on http://127.0.0.1:%1/api").arg(server.port());
+    return app.exec();
+}
@@ -0,0 +1,429 @@
+#include "mockapiserver.h"
+#include <QTcpSocket>
+#include <QTimer>
+#include <QPointer>
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QRegularExpression>
+#include <QDateTime>
+#include <QCryptographicHash>
+#include <QDebug>
+
+namespace {
+
+const int kMaxRequestSize = 8 * 1024 * 1024;
+
+QByteArray reasonPhrase(int status)
+{
+    switch (status) {
+    case 200: return "OK";
+    case 304: return "Not Modified";
+    case 400: return "Bad Request";
+    case 401: return "Unauthorized";
+    case 404: return "Not Found";
+    case 413: return "Payload Too Large";
+    case 503: return "Service Unavailable";
+    }
+    return "Unknown";
+}
+
+QJsonObject success(const QJsonValue &data = QJsonValue())
+{
+    QJsonObject body;
+    body["success"] = true;
+    if (!data.isUndefined() && !data.isNull()) {
+        body["data"] = data;
+    }
+    return body;
+}
+
+// ETag dari isi body; If-None-Match yang cocok dijawab 304 tanpa body
+void applyEtag(const QHash<QByteArray, QByteArray> &headers, QJsonObject &body, int &status, QByteArray &etag)
+{
+    const QByteArray json = QJsonDocument(body).toJson(QJsonDocument::Compact);
+    etag = '"' + QCryptographicHash::hash(json, QCryptographicHash::Sha1).toHex().left(16) + '"';
+    if (headers.value("if-none-match") == etag) {
+        status = 304;
+    }
+}
+
+QJsonObject failure(const QString &message)
+{
+    QJsonObject body;
+    body["success"] = false;
+    body["message"] = message;
+    return body;
+}
+
+} // namespace
+
+MockApiServer::MockApiServer(QObject *parent)
+    : QObject(parent)
+    , m_random(QRandomGenerator::securelySeeded())
+{
+    connect(&m_server, &QTcpServer::newConnection, this, &MockApiServer::handleConnection);
+}
+
+bool MockApiServer::listen(quint16 port)
+{
+    if (!m_server.listen(QHostAddress::LocalHost, port)) {
+        qWarning() << "Mock server cannot listen on port" << port << ":" << m_server.errorString();
+        return false;
+    }
+    return true;
+}
+
+void MockApiServer::applyConfig(Faults &faults, const QJsonObject &config)
+{
+    if (config.contains("latency_ms")) faults.latencyMs = config["latency_ms"].toInt();
+    if (config.contains("jitter_ms")) faults.jitterMs = config["jitter_ms"].toInt();
+    if (config.contains("error_rate")) faults.errorRate = config["error_rate"].toDouble();
+    if (config.contains("unauthorized_rate")) faults.unauthorizedRate = config["unauthorized_rate"].toDouble();
+    if (config.contains("drop_rate")) faults.dropRate = config["drop_rate"].toDouble();
+    if (config.contains("refresh_every")) faults.refreshEvery = config["refresh_every"].toInt();
+    if (config.contains("settings_version")) faults.settingsVersion = config["settings_version"].toInteger();
+    if (config.contains("only")) faults.only = config["only"].toString();
+    if (config.contains("tasks")) faults.taskCount = config["tasks"].toInt();
+    if (config.contains("apps")) faults.appCount = config["apps"].toInt();
+    if (config.contains("bulk_task_status")) faults.bulkTaskStatus = config["bulk_task_status"].toBool();
+}
+
+void MockApiServer::handleConnection()
+{
+    while (QTcpSocket *socket = m_server.nextPendingConnection()) {
+        m_buffers.insert(socket, QByteArray());
+        connect(socket, &QTcpSocket::readyRead, this, [this, socket]() {
+            m_buffers[socket] += socket->readAll();
+            processBuffer(socket);
+        });
+        connect(socket, &QTcpSocket::disconnected, this, [this, socket]() {
+            m_buffers.remove(socket);
+            m_outgoing.remove(socket);
+            socket->deleteLater();
+        });
+    }
+}
+
+void MockApiServer::processBuffer(QTcpSocket *socket)
+{
+    QByteArray &buffer = m_buffers[socket];
+
+    // Koneksi keep-alive bisa membawa beberapa request berurutan
+    forever {
+        const int headerEnd = buffer.indexOf("\r\n\r\n");
+        if (headerEnd < 0) {
+            if (buffer.size() > kMaxRequestSize) {
+                socket->abort();
+            }
+            return;
+        }
+
+        const QList<QByteArray> lines = buffer.left(headerEnd).split('\n');
+        const QList<QByteArray> requestLine = lines.value(0).trimmed().split(' ');
+        if (requestLine.size() < 2) {
+            socket->abort();
+            return;
+        }
+
+        Request request;
+        request.method = requestLine[0];
+        request.path = QString::fromLatin1(requestLine[1]).section('?', 0, 0);
+        for (int i = 1; i < lines.size(); ++i) {
+            const int colon = lines[i].indexOf(':');
+            if (colon > 0) {
+                request.headers.insert(lines[i].left(colon).trimmed().toLower(), lines[i].mid(colon + 1).trimmed());
+            }
+        }
+
+        const int contentLength = request.headers.value("content-length").toInt();
+        if (contentLength > kMaxRequestSize) {
+            Response tooLarge;
+            tooLarge.status = 413;
+            tooLarge.body = failure("Payload too large");
+            send(socket, tooLarge, 0);
+            socket->disconnectFromHost();
+            return;
+        }
+        if (buffer.size() < headerEnd + 4 + contentLength) {
+            return; // Body belum lengkap
+        }
+        request.body = buffer.mid(headerEnd + 4, contentLength);
+        buffer.remove(0, headerEnd + 4 + contentLength);
+
+        Response response = route(request);
+        m_requestCounts[QString::fromLatin1(request.method) + ' ' + request.path] += 1;
+        if (response.drop) {
+            socket->abort();
+            return;
+        }
+        m_statusCounts[response.status] += 1;
+        send(socket, response, request.path.startsWith("/mock/") ? 0 : responseDelay());
+    }
+}
+
+MockApiServer::Response MockApiServer::route(const Request &request)
+{
+    if (request.path.startsWith("/mock/")) {
+        return handleControl(request);
+    }
+
+    // Fault injection sebelum logika endpoint
+    if (m_faults.only.isEmpty() || request.path.startsWith(m_faults.only)) {
+        Response fault;
+        const double roll = m_random.generateDouble();
+        if (roll < m_faults.dropRate) {
+            fault.drop = true;
+            return fault;
+        }
+        if (roll < m_faults.dropRate + m_faults.errorRate) {
+            fault.status = 503;
+            fault.body = failure("Injected server error");
+            return fault;
+        }
+        if (roll < m_faults.dropRate + m_faults.errorRate + m_faults.unauthorizedRate
+            && request.path != "/api/login") {
+            fault.status = 401;
+            fault.body = failure("Unauthenticated.");
+            return fault;
+        }
+    }
+
+    // Idempotency-Key yang sama dua kali berarti klien mengirim ulang pesan yang sudah diterima
+    const QByteArray key = request.headers.value("idempotency-key");
+    if (!key.isEmpty()) {
+        if (m_idempotencyKeys.contains(key)) {
+            ++m_duplicateDeliveries;
+        }
+        m_idempotencyKeys.insert(key);
+    }
+
+    return handleApi(request);
+}
+
+MockApiServer::Response MockApiServer::handleApi(const Request &request)
+{
+    static const QRegularExpression taskByUser("^/api/task-by-user/(\\d+)$");
+    static const QRegularExpression taskStatus("^/api/get-current-task-status/(\\d+)$");
+    static const QRegularExpression endImplementation("^/api/end-implementation/(\\d+)$");
+
+    Response response;
+    const QJsonObject body = QJsonDocument::fromJson(request.body).object();
+    const bool authorized = request.headers.value("authorization").startsWith("Bearer ");
+
+    if (request.path == "/api/login") {
+        if (body["password"].toString() == "wrong" || body["email"].toString().isEmpty()) {
+            response.body = failure("Invalid credentials");
+            return response;
+        }
+        QJsonObject role;
+        role["rolename"] = "staff";
+        QJsonObject user;
+        user["id"] = 1;
+        user["name"] = body["email"].toString().section('@', 0, 0);
+        user["email"] = body["email"].toString();
+        user["role"] = role;
+        response.body = success();
+        response.body["token"] = QString("mock-token-%1").arg(++m_tokenCounter);
+        response.body["user"] = user;
+        return response;
+    }
+
+    if (!authorized) {
+        response.status = 401;
+        response.body = failure("Unauthenticated.");
+        return response;
+    }
+
+    QRegularExpressionMatch match;
+    if (request.path == "/api/ping") {
+        ++m_pingCount;
+        response.body = success();
+        response.body["refresh_required"] = m_faults.refreshEvery > 0 && m_pingCount % m_faults.refreshEvery == 0;
+        if (m_faults.settingsVersion > 0) {
+            response.body["settings_version"] = m_faults.settingsVersion;
+        }
+    } else if ((match = taskByUser.match(request.path)).hasMatch()) {
+        response.body = tasksFor(match.captured(1).toInt());
+        applyEtag(request.headers, response.body, response.status, response.etag);
+    } else if (request.path == "/api/app-request/all") {
+        response.body = productivityApps();
+        applyEtag(request.headers, response.body, response.status, response.etag);
+    } else if (request.path == "/api/get-current-task-status/bulk" && m_faults.bulkTaskStatus) {
+        QJsonArray statuses;
+        for (const QJsonValue &id : body["task_ids"].toArray()) {
+            QJsonObject status;
+            status["id"] = id.toInt();
+            status["status"] = taskStatusFor(id.toInt());
+            statuses.append(status);
+        }
+        response.body = success(statuses);
+    } else if ((match = taskStatus.match(request.path)).hasMatch()) {
+        const QString status = taskStatusFor(match.captured(1).toInt());
+        response.etag = '"' + status.toUtf8() + '"';
+        if (request.headers.value("if-none-match") == response.etag) {
+            response.status = 304;
+        } else {
+            response.body = success(status);
+        }
+    } else if (request.path == "/api/productivity-app") {
+        if (!body["data"].isArray()) {
+            response.status = 400;
+            response.body = failure("Field 'data' must be an array");
+        } else {
+            response.body = success();
+            response.body["received"] = body["data"].toArray().size();
+        }
+    } else if (request.path == "/api/send-time-at-work" || request.path == "/api/send-productive-time"
+               || request.path == "/api/logout" || request.path == "/api/app-request/store"
+               || endImplementation.match(request.path).hasMatch()) {
+        response.body = success();
+    } else {
+        response.status = 404;
+        response.body = failure("Not found: " + request.path);
+    }
+    return response;
+}
+
+MockApiServer::Response MockApiServer::handleControl(const Request &request)
+{
+    Response response;
+    if (request.path == "/mock/config" && request.method == "POST") {
+        applyConfig(m_faults, QJsonDocument::fromJson(request.body).object());
+        response.body = success();
+    } else if (request.path == "/mock/stats") {
+        QJsonObject requests;
+        for (auto it = m_requestCounts.constBegin(); it != m_requestCounts.constEnd(); ++it) {
+            requests[it.key()] = it.value();
+        }
+        QJsonObject statuses;
+        for (auto it = m_statusCounts.constBegin(); it != m_statusCounts.constEnd(); ++it) {
+            statuses[QString::number(it.key())] = it.value();
+        }
+        response.body = success();
+        response.body["requests"] = requests;
+        response.body["statuses"] = statuses;
+        response.body["duplicate_deliveries"] = m_duplicateDeliveries;
+        response.body["pings"] = m_pingCount;
+    } else if (request.path == "/mock/task-status" && request.method == "POST") {
+        const QJsonObject body = QJsonDocument::fromJson(request.body).object();
+        m_taskStatuses.insert(body["id"].toInt(), body["status"].toString());
+        response.body = success();
+    } else if (request.path == "/mock/reset" && request.method == "POST") {
+        m_taskStatuses.clear();
+        m_requestCounts.clear();
+        m_statusCounts.clear();
+        m_idempotencyKeys.clear();
+        m_duplicateDeliveries = 0;
+        m_pingCount = 0;
+        response.body = success();
+    } else {
+        response.status = 404;
+        response.body = failure("Unknown control endpoint");
+    }
+    return response;
+}
+
+void MockApiServer::send(QTcpSocket *socket, const Response &response, int delayMs)
+{
+    // 304 tidak membawa body
+    const QByteArray body = response.status == 304 ? QByteArray()
+                                                   : QJsonDocument(response.body).toJson(QJsonDocument::Compact);
+    QByteArray data = "HTTP/1.1 " + QByteArray::number(response.status) + ' ' + reasonPhrase(response.status) + "\r\n";
+    if (!body.isEmpty()) {
+        data += "Content-Type: application/json\r\n";
+    }
+    if (!response.etag.isEmpty()) {
+        data += "ETag: " + response.etag + "\r\n";
+    }
+    data += "Content-Length: " + QByteArray::number(body.size()) + "\r\n";
+    data += "Connection: keep-alive\r\n\r\n";
+    data += body;
+
+    // Dengan jitter, request berikutnya bisa selesai lebih dulu; respons ditahan
+    // di antrean per koneksi dan ditulis sesuai urutan request (pipelining HTTP/1.1)
+    const quint64 seq = m_nextResponseSeq++;
+    Outgoing outgoing;
+    outgoing.data = data;
+    outgoing.ready = delayMs <= 0;
+    m_outgoing[socket].insert(seq, outgoing);
+    if (delayMs <= 0) {
+        writeReady(socket);
+        return;
+    }
+    QPointer<QTcpSocket> guard(socket);
+    QTimer::singleShot(delayMs, this, [this, guard, seq]() {
+        if (!guard) {
+            return;
+        }
+        auto queue = m_outgoing.find(guard.data());
+        if (queue == m_outgoing.end()) {
+            return;
+        }
+        auto it = queue->find(seq);
+        if (it != queue->end()) {
+            it->ready = true;
+            writeReady(guard.data());
+        }
+    });
+}
+
+void MockApiServer::writeReady(QTcpSocket *socket)
+{
+    auto queue = m_outgoing.find(socket);
+    if (queue == m_outgoing.end()) {
+        return;
+    }
+    while (!queue->isEmpty() && queue->first().ready) {
+        socket->write(queue->first().data);
+        queue->erase(queue->begin());
+    }
+    if (queue->isEmpty()) {
+        m_outgoing.erase(queue);
+    }
+}
+
+int MockApiServer::responseDelay()
+{
+    return m_faults.latencyMs + (m_faults.jitterMs > 0 ? int(m_random.bounded(m_faults.jitterMs + 1)) : 0);
+}
+
+QString MockApiServer::taskStatusFor(int taskId) const
+{
+    // Default: task pertama tiap user sedang dikerjakan, sisanya pending
+    return m_taskStatuses.value(taskId, taskId % 1000 == 1 ? QStringLiteral("on-progress")
+                                                           : QStringLiteral("pending"));
+}
+
+QJsonObject MockApiServer::tasksFor(int userId) const
+{
+    static const QStringList statuses = {"on-progress", "pending", "review", "need-review"};
+    QJsonArray tasks;
+    for (int i = 1; i <= m_faults.taskCount; ++i) {
+        QJsonObject task;
+        task["id"] = userId * 1000 + i;
+        task["title"] = QString("Mock project %1").arg((i - 1) / 5 + 1);
+        task["description"] = QString("Mock task %1").arg(i);
+        task["user_id"] = userId;
+        task["status"] = statuses[i % statuses.size()];
+        task["duration"] = QString::number(1 + i % 8);
+        task["total_duration"] = QString::number((i % 4) * 0.25, 'f', 2);
+        tasks.append(task);
+    }
+    return success(tasks);
+}
+
+QJsonObject MockApiServer::productivityApps() const
+{
+    QJsonArray apps;
+    for (int i = 0; i < m_faults.appCount; ++i) {
+        QJsonObject app;
+        const bool browser = i % 2 == 0;
+        app["application_name"] = browser ? QString("chrome") : QString("mockapp%1").arg(i);
+        app["process_name"] = browser ? QString("chrome") : QString("mockapp%1").arg(i);
+        app["url"] = browser ? QString("https://site%1.example.com").arg(i) : QString();
+        app["productivity_status"] = i % 3 == 0 ? "non-productive" : "productive";
+        app["user_id"] = 0;
+        apps.append(app);
+    }
+    return success(apps);
+}
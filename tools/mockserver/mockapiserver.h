@@ -0,0 +1,93 @@
+#ifndef MOCKAPISERVER_H
+#define MOCKAPISERVER_H
+
+#include <QObject>
+#include <QTcpServer>
+#include <QHash>
+#include <QMap>
+#include <QSet>
+#include <QJsonObject>
+#include <QRandomGenerator>
+
+class QTcpSocket;
+
+// Server HTTP/1.1 minimal yang meniru endpoint Deskmon API. Dipakai untuk
+// mengukur perilaku klien (outbox, login, sinkronisasi task) terhadap backend
+// yang lambat atau gagal, tanpa menyentuh server produksi.
+class MockApiServer : public QObject
+{
+    Q_OBJECT
+public:
+    struct Faults {
+        int latencyMs = 0;          // jeda sebelum setiap respons
+        int jitterMs = 0;           // tambahan acak [0, jitterMs]
+        double errorRate = 0;       // peluang HTTP 503
+        double unauthorizedRate = 0; // peluang HTTP 401
+        double dropRate = 0;        // peluang koneksi ditutup tanpa respons
+        int refreshEvery = 0;       // refresh_required pada setiap ping ke-N
+        qint64 settingsVersion = 0; // dikirim di respons ping jika > 0
+        QString only;               // jika diisi, fault hanya untuk path dengan prefix ini
+        int taskCount = 20;
+        bool bulkTaskStatus = true; // false = server lama tanpa endpoint bulk (404)
+        int appCount = 50;
+    };
+
+    explicit MockApiServer(QObject *parent = nullptr);
+
+    bool listen(quint16 port);
+    quint16 port() const { return m_server.serverPort(); }
+
+    Faults &faults() { return m_faults; }
+    static void applyConfig(Faults &faults, const QJsonObject &config);
+
+private:
+    struct Request {
+        QByteArray method;
+        QString path;
+        QHash<QByteArray, QByteArray> headers; // nama header huruf kecil
+        QByteArray body;
+    };
+
+    struct Response {
+        int status = 200;
+        QJsonObject body;
+        bool drop = false;
+        QByteArray etag;            // dikirim sebagai header ETag jika diisi
+    };
+
+    struct Outgoing {
+        QByteArray data;
+        bool ready = false;         // jeda sudah lewat, tinggal menunggu respons sebelumnya
+    };
+
+    void handleConnection();
+    void processBuffer(QTcpSocket *socket);
+    Response route(const Request &request);
+    Response handleApi(const Request &request);
+    Response handleControl(const Request &request);
+    void send(QTcpSocket *socket, const Response &response, int delayMs);
+    void writeReady(QTcpSocket *socket);
+    int responseDelay();
+
+    QJsonObject tasksFor(int userId) const;
+    QJsonObject productivityApps() const;
+    QString taskStatusFor(int taskId) const;
+
+    QTcpServer m_server;
+    QHash<QTcpSocket *, QByteArray> m_buffers;
+    QHash<QTcpSocket *, QMap<quint64, Outgoing>> m_outgoing; // urut nomor request per koneksi
+    quint64 m_nextResponseSeq = 0;
+    Faults m_faults;
+    QRandomGenerator m_random;
+
+    // Statistik untuk skrip uji beban
+    QHash<QString, int> m_requestCounts;
+    QHash<int, int> m_statusCounts;
+    QSet<QByteArray> m_idempotencyKeys;
+    int m_duplicateDeliveries = 0;
+    int m_pingCount = 0;
+    int m_tokenCounter = 0;
+    QHash<int, QString> m_taskStatuses; // override lewat POST /mock/task-status
+};
+
+#endif // MOCKAPISERVER_H
@@ -0,0 +1,215 @@
+#include "usagemodel.h"
+#include "activityrollup.h"
+#include "ruleindex.h"
+#include "perfstats.h"
+#include <algorithm>
+
+namespace {
+
+// Segmen idle tidak dihitung sebagai pemakaian aplikasi
+const QString kIdleApp = QStringLiteral("Idle");
+
+QString categoryName(int category)
+{
+    switch (category) {
+    case ActivityRollup::Productive: return QStringLiteral("productive");
+    case ActivityRollup::NonProductive: return QStringLiteral("non-productive");
+    default: return QStringLiteral("neutral");
+    }
+}
+
+} // namespace
+
+UsageModel::UsageModel(Kind kind, QObject *parent)
+    : QAbstractListModel(parent)
+    , m_kind(kind)
+{
+}
+
+void UsageModel::rebuild(const ActivityRollup &rollup, int userId, const QDate &from, const QDate &to,
+                         const RuleIndex &rules)
+{
+    ScopedPerfTimer perf(m_kind == Apps ? "stats.app_usage_rebuild" : "stats.domain_usage_rebuild");
+
+    QHash<QString, qint64> seconds;
+    qint64 total = 0;
+    rollup.forEachDay(userId, from, to, [&](const QDate &, const ActivityRollup::Day &day) {
+        for (const ActivityRollup::Entry &entry : day.entries) {
+            const QString key = keyFor(entry.appName, entry.browser ? entry.domain : QString());
+            if (!key.isEmpty() && entry.seconds > 0) {
+                seconds[key] += entry.seconds;
+                total += entry.seconds;
+            }
+        }
+    });
+
+    QVector<Item> items;
+    items.reserve(seconds.size());
+    for (auto it = seconds.constBegin(); it != seconds.constEnd(); ++it) {
+        Item item;
+        item.name = it.key();
+        item.seconds = it.value();
+        item.category = categoryFor(userId, it.key(), rules);
+        items.append(item);
+    }
+    std::sort(items.begin(), items.end(), lessThan);
+
+    const int oldCount = m_items.size();
+    const qint64 oldTotal = m_totalSeconds;
+    beginResetModel();
+    m_userId = userId;
+    m_from = from;
+    m_to = to;
+    m_items = items;
+    m_totalSeconds = total;
+    rebuildIndex();
+    endResetModel();
+    if (oldCount != m_items.size()) {
+        emit countChanged();
+    }
+    if (oldTotal != m_totalSeconds) {
+        emit totalSecondsChanged();
+    }
+}
+
+void UsageModel::addSegment(int userId, const QDate &date, const QString &appName, const QString &domain,
+                            qint64 seconds, const RuleIndex &rules)
+{
+    if (userId != m_userId || seconds <= 0 || !inRange(date)) {
+        return;
+    }
+    const QString key = keyFor(appName, domain);
+    if (key.isEmpty()) {
+        return;
+    }
+
+    m_totalSeconds += seconds;
+    auto found = m_rowByName.constFind(key);
+    if (found == m_rowByName.constEnd()) {
+        Item item;
+        item.name = key;
+        item.seconds = seconds;
+        item.category = categoryFor(userId, key, rules);
+        const int row = int(std::upper_bound(m_items.cbegin(), m_items.cend(), item, lessThan) - m_items.cbegin());
+        beginInsertRows(QModelIndex(), row, row);
+        m_items.insert(row, item);
+        endInsertRows();
+        rebuildIndex();
+        emit countChanged();
+    } else {
+        // Durasi hanya bertambah, jadi baris cukup digeser ke atas
+        int row = found.value();
+        m_items[row].seconds += seconds;
+        int target = row;
+        while (target > 0 && lessThan(m_items[row], m_items[target - 1])) {
+            --target;
+        }
+        if (target != row) {
+            beginMoveRows(QModelIndex(), row, row, QModelIndex(), target);
+            m_items.move(row, target);
+            endMoveRows();
+            rebuildIndex();
+        }
+        const QModelIndex changed = index(target);
+        emit dataChanged(changed, changed, {SecondsRole});
+    }
+
+    // Total berubah, jadi persentase semua baris ikut berubah
+    if (!m_items.isEmpty()) {
+        emit dataChanged(index(0), index(m_items.size() - 1), {PercentageRole});
+    }
+    emit totalSecondsChanged();
+}
+
+void UsageModel::clear()
+{
+    if (m_items.isEmpty() && m_userId == -1) {
+        return;
+    }
+    const bool hadTotal = m_totalSeconds != 0;
+    beginResetModel();
+    m_items.clear();
+    m_rowByName.clear();
+    m_totalSeconds = 0;
+    m_userId = -1;
+    endResetModel();
+    emit countChanged();
+    if (hadTotal) {
+        emit totalSecondsChanged();
+    }
+}
+
+int UsageModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : m_items.size();
+}
+
+QVariant UsageModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= m_items.size()) {
+        return QVariant();
+    }
+
+    const Item &item = m_items[index.row()];
+    switch (role) {
+    case Qt::DisplayRole:
+    case NameRole:
+        return item.name;
+    case SecondsRole:
+        return item.seconds;
+    case PercentageRole:
+        return m_totalSeconds > 0 ? double(item.seconds) * 100.0 / double(m_totalSeconds) : 0.0;
+    case CategoryRole:
+        return categoryName(item.category);
+    default:
+        return QVariant();
+    }
+}
+
+QHash<int, QByteArray> UsageModel::roleNames() const
+{
+    return {
+        {NameRole, "name"},
+        {SecondsRole, "seconds"},
+        {PercentageRole, "percentage"},
+        {CategoryRole, "category"}
+    };
+}
+
+QString UsageModel::keyFor(const QString &appName, const QString &domain) const
+{
+    if (m_kind == Domains) {
+        return domain;
+    }
+    return appName == kIdleApp ? QString() : appName;
+}
+
+int UsageModel::categoryFor(int userId, const QString &key, const RuleIndex &rules) const
+{
+    // Sama dengan klasifikasi lama: aplikasi dinilai dari namanya saja, domain dari aturan URL
+    const int type = m_kind == Domains ? rules.classifyDomain(userId, key) : rules.classifyApp(userId, key);
+    return (type == ActivityRollup::Productive || type == ActivityRollup::NonProductive) ? type
+                                                                                        : ActivityRollup::Neutral;
+}
+
+bool UsageModel::inRange(const QDate &date) const
+{
+    return (!m_from.isValid() || date >= m_from) && (!m_to.isValid() || date <= m_to);
+}
+
+bool UsageModel::lessThan(const Item &a, const Item &b)
+{
+    if (a.seconds != b.seconds) {
+        return a.seconds > b.seconds;
+    }
+    return a.name < b.name;
+}
+
+void UsageModel::rebuildIndex()
+{
+    m_rowByName.clear();
+    m_rowByName.reserve(m_items.size());
+    for (int i = 0; i < m_items.size(); ++i) {
+        m_rowByName.insert(m_items[i].name, i);
+    }
+}
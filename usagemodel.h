@@ -0,0 +1,71 @@
+#ifndef USAGEMODEL_H
+#define USAGEMODEL_H
+
+#include <QAbstractListModel>
+#include <QDate>
+#include <QHash>
+#include <QVector>
+
+class ActivityRollup;
+class RuleIndex;
+
+// Durasi pemakaian per aplikasi atau per domain untuk rentang tanggal filter,
+// terurut menurun. Dibangun dari ActivityRollup (epoch, bukan string jam) lalu
+// diperbarui per segmen yang ditutup tanpa menghitung ulang seluruh hari.
+class UsageModel : public QAbstractListModel
+{
+    Q_OBJECT
+    Q_PROPERTY(int count READ rowCount NOTIFY countChanged)
+    Q_PROPERTY(qint64 totalSeconds READ totalSeconds NOTIFY totalSecondsChanged)
+public:
+    enum Kind { Apps, Domains };
+
+    enum Roles {
+        NameRole = Qt::UserRole + 1,
+        SecondsRole,
+        PercentageRole,
+        CategoryRole
+    };
+
+    explicit UsageModel(Kind kind, QObject *parent = nullptr);
+
+    void rebuild(const ActivityRollup &rollup, int userId, const QDate &from, const QDate &to,
+                 const RuleIndex &rules);
+    void addSegment(int userId, const QDate &date, const QString &appName, const QString &domain,
+                    qint64 seconds, const RuleIndex &rules);
+    void clear();
+
+    qint64 totalSeconds() const { return m_totalSeconds; }
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+signals:
+    void countChanged();
+    void totalSecondsChanged();
+
+private:
+    struct Item {
+        QString name;
+        qint64 seconds = 0;
+        int category = 0;
+    };
+
+    // Kunci baris untuk segmen ini; kosong jika segmen tidak masuk model
+    QString keyFor(const QString &appName, const QString &domain) const;
+    int categoryFor(int userId, const QString &key, const RuleIndex &rules) const;
+    bool inRange(const QDate &date) const;
+    static bool lessThan(const Item &a, const Item &b);
+    void rebuildIndex();
+
+    Kind m_kind;
+    int m_userId = -1;
+    QDate m_from;
+    QDate m_to;
+    QVector<Item> m_items;
+    QHash<QString, int> m_rowByName;
+    qint64 m_totalSeconds = 0;
+};
+
+#endif // USAGEMODEL_H
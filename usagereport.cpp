@@ -0,0 +1,172 @@
+#include "usagereport.h"
+#include "activityrollup.h"
+#include "perfstats.h"
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QDateTime>
+#include <QJsonObject>
+#include <QDebug>
+
+namespace {
+
+QString statusString(int category)
+{
+    if (category == ActivityRollup::Productive) return QStringLiteral("productive");
+    if (category == ActivityRollup::NonProductive) return QStringLiteral("non-productive");
+    return QStringLiteral("neutral");
+}
+
+} // namespace
+
+bool UsageReport::createTable(QSqlDatabase &db)
+{
+    QSqlQuery query(db);
+    if (!query.exec("CREATE TABLE IF NOT EXISTS usage_report_ack ("
+                    "user_id INTEGER NOT NULL, "
+                    "date TEXT NOT NULL, "
+                    "acked_until INTEGER NOT NULL, "
+                    "reclassified_at INTEGER NOT NULL DEFAULT 0, "
+                    "PRIMARY KEY (user_id, date))")) {
+        qWarning() << "Failed to create usage_report_ack table:" << query.lastError().text();
+        return false;
+    }
+    return true;
+}
+
+UsageReport::Delta UsageReport::build(QSqlDatabase &db, int userId, const QDate &date,
+                                      const ActivityRollup &rollup)
+{
+    ScopedPerfTimer perf("sql.usage_report_build");
+    Delta delta;
+    const ActivityRollup::Day *day = rollup.day(userId, date);
+    if (!day) {
+        return delta;
+    }
+
+    // Entri yang berubah pada detik yang sama dengan pembuatan laporan bisa saja
+    // berubah lagi setelahnya, jadi watermark berhenti satu detik sebelumnya
+    const AckState state = ackState(db, userId, date);
+    const qint64 acked = state.until;
+    const qint64 cutoff = QDateTime::currentSecsSinceEpoch() - 1;
+    // Aturan berubah setelah ack terakhir: status entri mana pun bisa berbeda dari
+    // yang diketahui server
+    const bool resendAll = state.reclassifiedAt > acked;
+
+    for (auto it = day->entries.constBegin(); it != day->entries.constEnd(); ++it) {
+        const ActivityRollup::Entry &entry = it.value();
+        if ((!resendAll && entry.updatedAt <= acked) || entry.appName == QLatin1String("Idle") || entry.seconds <= 0) {
+            continue;
+        }
+
+        QJsonObject object;
+        object["user_id"] = userId;
+        object["app_name"] = entry.appName;
+        object["duration"] = entry.seconds;
+        object["url"] = entry.browser ? QJsonValue(entry.domain) : QJsonValue(); // Null untuk non-browser
+        object["status"] = statusString(entry.category);
+        delta.data.append(object);
+
+        delta.until = qMax(delta.until, qMin(entry.updatedAt, cutoff));
+    }
+    if (resendAll && !delta.data.isEmpty()) {
+        delta.until = qMax(delta.until, qMin(state.reclassifiedAt, cutoff));
+    }
+    delta.until = qMax(delta.until, acked);
+    return delta;
+}
+
+void UsageReport::acknowledge(QSqlDatabase &db, int userId, const QDate &date, qint64 until)
+{
+    // Ack bisa datang tidak berurutan (pesan lama masih in-flight); watermark hanya maju
+    AckState state = ackState(db, userId, date);
+    if (until <= state.until) {
+        return;
+    }
+
+    QSqlQuery query(db);
+    query.prepare("INSERT INTO usage_report_ack (user_id, date, acked_until) "
+                  "VALUES (:user_id, :date, :until) "
+                  "ON CONFLICT(user_id, date) DO UPDATE SET acked_until = excluded.acked_until");
+    query.bindValue(":user_id", userId);
+    query.bindValue(":date", date.toString(Qt::ISODate));
+    query.bindValue(":until", until);
+    if (!query.exec()) {
+        qWarning() << "Failed to store usage report watermark:" << query.lastError().text();
+        return;
+    }
+    state.until = until;
+    m_acks.insert(cacheKey(userId, date), state);
+
+    // Watermark hari-hari lama tidak dibutuhkan lagi
+    query.prepare("DELETE FROM usage_report_ack WHERE user_id = :user_id AND date < :date");
+    query.bindValue(":user_id", userId);
+    query.bindValue(":date", date.addDays(-7).toString(Qt::ISODate));
+    query.exec();
+}
+
+void UsageReport::markReclassified(QSqlDatabase &db, int userId, const QDate &date, qint64 at)
+{
+    AckState state = ackState(db, userId, date);
+    if (at <= state.reclassifiedAt) {
+        return;
+    }
+
+    QSqlQuery query(db);
+    query.prepare("INSERT INTO usage_report_ack (user_id, date, acked_until, reclassified_at) "
+                  "VALUES (:user_id, :date, 0, :at) "
+                  "ON CONFLICT(user_id, date) DO UPDATE SET reclassified_at = excluded.reclassified_at");
+    query.bindValue(":user_id", userId);
+    query.bindValue(":date", date.toString(Qt::ISODate));
+    query.bindValue(":at", at);
+    if (!query.exec()) {
+        qWarning() << "Failed to store usage report reclassification:" << query.lastError().text();
+        return;
+    }
+    state.reclassifiedAt = at;
+    m_acks.insert(cacheKey(userId, date), state);
+}
+
+QString UsageReport::tagFor(int userId, const QDate &date, qint64 until)
+{
+    return QString("%1|%2|%3").arg(userId).arg(date.toString(Qt::ISODate)).arg(until);
+}
+
+bool UsageReport::parseTag(const QString &tag, int &userId, QDate &date, qint64 &until)
+{
+    const QStringList parts = tag.split('|');
+    if (parts.size() != 3) {
+        return false;
+    }
+    bool userOk = false;
+    bool untilOk = false;
+    userId = parts[0].toInt(&userOk);
+    date = QDate::fromString(parts[1], Qt::ISODate);
+    until = parts[2].toLongLong(&untilOk);
+    return userOk && untilOk && date.isValid();
+}
+
+UsageReport::AckState UsageReport::ackState(QSqlDatabase &db, int userId, const QDate &date)
+{
+    const QString key = cacheKey(userId, date);
+    auto it = m_acks.constFind(key);
+    if (it != m_acks.constEnd()) {
+        return it.value();
+    }
+
+    AckState state;
+    QSqlQuery query(db);
+    query.prepare("SELECT acked_until, reclassified_at FROM usage_report_ack WHERE user_id = :user_id AND date = :date");
+    query.bindValue(":user_id", userId);
+    query.bindValue(":date", date.toString(Qt::ISODate));
+    if (query.exec() && query.next()) {
+        state.until = query.value(0).toLongLong();
+        state.reclassifiedAt = query.value(1).toLongLong();
+    }
+    m_acks.insert(key, state);
+    return state;
+}
+
+QString UsageReport::cacheKey(int userId, const QDate &date)
+{
+    return QString::number(userId) + QLatin1Char(':') + date.toString(Qt::ISODate);
+}
@@ -0,0 +1,48 @@
+#ifndef USAGEREPORT_H
+#define USAGEREPORT_H
+
+#include <QString>
+#include <QHash>
+#include <QDate>
+#include <QJsonArray>
+#include <QSqlDatabase>
+
+class ActivityRollup;
+
+// Laporan penggunaan harian (productivity-app) yang dibangun dari ActivityRollup.
+// Hanya entri yang berubah sejak laporan terakhir yang di-ack server yang dikirim;
+// nilai durasi tetap total harian sehingga pengiriman ulang aman. Perubahan status
+// karena aturan baru dicatat di tabel ack (reclassified_at), karena updatedAt
+// entri dibangun ulang dari end_time saat aplikasi dijalankan lagi.
+class UsageReport
+{
+public:
+    struct Delta {
+        QJsonArray data;
+        qint64 until = 0; // watermark yang disimpan setelah server mengonfirmasi
+    };
+
+    static bool createTable(QSqlDatabase &db);
+
+    Delta build(QSqlDatabase &db, int userId, const QDate &date, const ActivityRollup &rollup);
+    void acknowledge(QSqlDatabase &db, int userId, const QDate &date, qint64 until);
+    // Seluruh hari dilaporkan ulang sampai ada ack yang mencakup waktu ini
+    void markReclassified(QSqlDatabase &db, int userId, const QDate &date, qint64 at);
+
+    // Tag outbox untuk mencocokkan ack dengan laporan yang dikirim
+    static QString tagFor(int userId, const QDate &date, qint64 until);
+    static bool parseTag(const QString &tag, int &userId, QDate &date, qint64 &until);
+
+private:
+    struct AckState {
+        qint64 until = 0;
+        qint64 reclassifiedAt = 0;
+    };
+
+    AckState ackState(QSqlDatabase &db, int userId, const QDate &date);
+    static QString cacheKey(int userId, const QDate &date);
+
+    QHash<QString, AckState> m_acks;
+};
+
+#endif // USAGEREPORT_H
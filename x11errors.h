@@ -0,0 +1,9 @@
+#ifndef X11ERRORS_H
+#define X11ERRORS_H
+
+// Handler error Xlib berlaku untuk seluruh proses, jadi dipasang sekali dari
+// main() sebelum komponen apa pun membuka Display. Jendela bisa hilang di
+// antara dua request (BadWindow); handler bawaan Xlib akan exit().
+void installX11ErrorHandler();
+
+#endif // X11ERRORS_H
@@ -0,0 +1,178 @@
+#include "x11windowprobe.h"
+#include <QFile>
+#include <QDebug>
+
+#include <X11/Xlib.h>
+#include <X11/Xatom.h>
+#include <X11/Xutil.h>
+
+namespace {
+
+const int kMaxCachedWindows = 256;
+
+} // namespace
+
+X11WindowProbe::X11WindowProbe()
+{
+    m_display = XOpenDisplay(nullptr);
+    if (!m_display) {
+        qWarning() << "Failed to open X11 display, active window probe disabled";
+        return;
+    }
+
+    m_root = DefaultRootWindow(m_display);
+    m_atomActiveWindow = XInternAtom(m_display, "_NET_ACTIVE_WINDOW", False);
+    m_atomWmName = XInternAtom(m_display, "_NET_WM_NAME", False);
+    m_atomWmPid = XInternAtom(m_display, "_NET_WM_PID", False);
+    m_atomUtf8String = XInternAtom(m_display, "UTF8_STRING", False);
+}
+
+X11WindowProbe::~X11WindowProbe()
+{
+    if (m_display) {
+        XCloseDisplay(m_display);
+        m_display = nullptr;
+    }
+}
+
+bool X11WindowProbe::probe(Result &result)
+{
+    if (!m_display) {
+        return false;
+    }
+
+    quint64 window = activeWindow();
+    if (window == 0) {
+        return false;
+    }
+
+    result.windowId = window;
+    result.title = windowTitle(window);
+
+    // Window id bisa dipakai ulang oleh klien X lain, jadi pid dibaca ulang
+    // (satu round-trip) dan entri cache hanya dipakai jika pid-nya sama
+    const qint64 pid = windowPid(window);
+    auto cached = m_cache.constFind(window);
+    if (cached != m_cache.constEnd() && cached.value().pid != pid) {
+        m_cache.erase(cached);
+        cached = m_cache.constEnd();
+    }
+    if (cached == m_cache.constEnd()) {
+        if (m_cache.size() >= kMaxCachedWindows) {
+            m_cache.clear();
+        }
+        CachedWindow entry;
+        entry.pid = pid;
+        if (entry.pid > 0) {
+            entry.appName = processName(entry.pid);
+        }
+        if (entry.appName.isEmpty()) {
+            entry.appName = windowClass(window);
+        }
+        cached = m_cache.insert(window, entry);
+    }
+
+    result.pid = cached.value().pid;
+    result.appName = cached.value().appName;
+    return true;
+}
+
+quint64 X11WindowProbe::activeWindow() const
+{
+    Atom actualType = None;
+    int actualFormat = 0;
+    unsigned long itemCount = 0;
+    unsigned long bytesAfter = 0;
+    unsigned char *data = nullptr;
+
+    quint64 window = 0;
+    if (XGetWindowProperty(m_display, m_root, m_atomActiveWindow, 0, 1, False, XA_WINDOW,
+                           &actualType, &actualFormat, &itemCount, &bytesAfter, &data) == Success) {
+        if (data && actualType == XA_WINDOW && actualFormat == 32 && itemCount > 0) {
+            window = reinterpret_cast<unsigned long *>(data)[0];
+        }
+    }
+    if (data) {
+        XFree(data);
+    }
+    return window;
+}
+
+QString X11WindowProbe::windowTitle(quint64 window) const
+{
+    Atom actualType = None;
+    int actualFormat = 0;
+    unsigned long itemCount = 0;
+    unsigned long bytesAfter = 0;
+    unsigned char *data = nullptr;
+
+    QString title;
+    if (XGetWindowProperty(m_display, window, m_atomWmName, 0, 1024, False, m_atomUtf8String,
+                           &actualType, &actualFormat, &itemCount, &bytesAfter, &data) == Success) {
+        if (data && actualType == m_atomUtf8String && actualFormat == 8) {
+            title = QString::fromUtf8(reinterpret_cast<const char *>(data), int(itemCount));
+        }
+    }
+    if (data) {
+        XFree(data);
+        data = nullptr;
+    }
+
+    // Fallback ke WM_NAME untuk window manager tanpa dukungan EWMH
+    if (title.isEmpty()) {
+        char *name = nullptr;
+        if (XFetchName(m_display, window, &name) && name) {
+            title = QString::fromLocal8Bit(name);
+            XFree(name);
+        }
+    }
+    return title.trimmed();
+}
+
+qint64 X11WindowProbe::windowPid(quint64 window) const
+{
+    Atom actualType = None;
+    int actualFormat = 0;
+    unsigned long itemCount = 0;
+    unsigned long bytesAfter = 0;
+    unsigned char *data = nullptr;
+
+    qint64 pid = -1;
+    if (XGetWindowProperty(m_display, window, m_atomWmPid, 0, 1, False, XA_CARDINAL,
+                           &actualType, &actualFormat, &itemCount, &bytesAfter, &data) == Success) {
+        if (data && actualType == XA_CARDINAL && actualFormat == 32 && itemCount > 0) {
+            pid = qint64(reinterpret_cast<unsigned long *>(data)[0]);
+        }
+    }
+    if (data) {
+        XFree(data);
+    }
+    return pid;
+}
+
+QString X11WindowProbe::windowClass(quint64 window) const
+{
+    XClassHint hint;
+    hint.res_name = nullptr;
+    hint.res_class = nullptr;
+
+    QString appName;
+    if (XGetClassHint(m_display, window, &hint)) {
+        if (hint.res_name) {
+            appName = QString::fromLocal8Bit(hint.res_name);
+        }
+        if (hint.res_name) XFree(hint.res_name);
+        if (hint.res_class) XFree(hint.res_class);
+    }
+    return appName;
+}
+
+QString X11WindowProbe::processName(qint64 pid)
+{
+    // Sama dengan "ps -p <pid> -o comm=", tanpa fork/exec
+    QFile comm(QString("/proc/%1/comm").arg(pid));
+    if (!comm.open(QIODevice::ReadOnly)) {
+        return QString();
+    }
+    return QString::fromLocal8Bit(comm.readAll()).trimmed();
+}
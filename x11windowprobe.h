@@ -0,0 +1,51 @@
+#ifndef X11WINDOWPROBE_H
+#define X11WINDOWPROBE_H
+
+#include <QString>
+#include <QHash>
+
+struct _XDisplay;
+
+// Membaca jendela aktif langsung dari server X (EWMH) lewat satu koneksi
+// Display yang dipakai terus, tanpa menjalankan xdotool/ps/wmctrl.
+class X11WindowProbe
+{
+public:
+    struct Result {
+        quint64 windowId = 0;
+        qint64 pid = -1;
+        QString appName;
+        QString title;
+    };
+
+    X11WindowProbe();
+    ~X11WindowProbe();
+
+    X11WindowProbe(const X11WindowProbe &) = delete;
+    X11WindowProbe &operator=(const X11WindowProbe &) = delete;
+
+    bool isAvailable() const { return m_display != nullptr; }
+    bool probe(Result &result);
+
+private:
+    struct CachedWindow {
+        qint64 pid = -1;
+        QString appName;
+    };
+
+    quint64 activeWindow() const;
+    QString windowTitle(quint64 window) const;
+    qint64 windowPid(quint64 window) const;
+    QString windowClass(quint64 window) const;
+    static QString processName(qint64 pid);
+
+    _XDisplay *m_display = nullptr;
+    quint64 m_root = 0;
+    quint64 m_atomActiveWindow = 0;
+    quint64 m_atomWmName = 0;
+    quint64 m_atomWmPid = 0;
+    quint64 m_atomUtf8String = 0;
+    QHash<quint64, CachedWindow> m_cache;
+};
+
+#endif // X11WINDOWPROBE_H